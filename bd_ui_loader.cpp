@@ -10,11 +10,14 @@
 #include "bd_ui_loader/bd_ui_loader.h"
 
 #include "src/Components/ComboBox.cpp"
+#include "src/Components/ContainerComponent.cpp"
 #include "src/Components/HooverableSwitchComponent.cpp"
 #include "src/Components/ImageComponent.cpp"
 #include "src/Components/KnobComponent.cpp"
+#include "src/Components/PaintProfilerOverlay.cpp"
 #include "src/Components/PlaceholderComponent.cpp"
 #include "src/Components/RadioButtonGroup.cpp"
+#include "src/Components/StaticLayerComponent.cpp"
 #include "src/Components/SwitchComponent.cpp"
 #include "src/Components/TweenableComponent.cpp"
 
@@ -28,7 +31,20 @@
 #include "src/Factories/RadioButtonGroupFactory.cpp"
 #include "src/Factories/SwitchFactory.cpp"
 #include "src/Factories/TweenableComponentFactory.cpp"
+#include "src/Helpers/AssetFileWatcher.cpp"
+#include "src/Helpers/AsyncImageLoading.cpp"
 #include "src/Helpers/BinaryAssetImageLoader.cpp"
+#include "src/Helpers/CompressedFilmstrip.cpp"
+#include "src/Helpers/DecodedImageCache.cpp"
+#include "src/Helpers/FastPngDecoder.cpp"
 #include "src/Helpers/FileAssetImageLoader.cpp"
+#include "src/Helpers/LoadReport.cpp"
+#include "src/Helpers/MemoryReport.cpp"
 #include "src/Helpers/PackedAssetImageLoader.cpp"
+#include "src/Helpers/PrefetchManifest.cpp"
+#include "src/Helpers/QoiImageFormat.cpp"
+#include "src/Helpers/ScaledImageSet.cpp"
+#include "src/Helpers/SharedImagePool.cpp"
+#include "src/Helpers/TraceRecorder.cpp"
+#include "src/Helpers/WarmUICache.cpp"
 #include "src/UILoader.cpp"
@@ -18,21 +18,47 @@ END_JUCE_MODULE_DECLARATION
 #include <bd_image_resampler/bd_image_resampler.h>
 #include <playfultones_smoothresizing/playfultones_smoothresizing.h>
 
+//==============================================================================
+/** Config: BD_UI_LOADER_ENABLE_TRACING
+    Compiles the BD_UI_TRACE_SCOPE() scopes around loading, decoding, layout and painting
+    in. Recording is still off until TraceRecorder::setEnabled (true) is called.
+*/
+#ifndef BD_UI_LOADER_ENABLE_TRACING
+    #define BD_UI_LOADER_ENABLE_TRACING 1
+#endif
+
 #include "src/UILoader.h"
 
+#include "src/Helpers/TraceRecorder.h"
+#include "src/Helpers/AsyncImageLoading.h"
+#include "src/Helpers/PrefetchManifest.h"
+#include "src/Helpers/DecodedImageCache.h"
+#include "src/Helpers/SharedImagePool.h"
+#include "src/Helpers/FastPngDecoder.h"
+#include "src/Helpers/LoadReport.h"
+#include "src/Helpers/QoiImageFormat.h"
+#include "src/Helpers/MemoryReport.h"
+#include "src/Helpers/CompressedFilmstrip.h"
+#include "src/Helpers/ImageAlphaAnalysis.h"
+#include "src/Helpers/ImageTrimming.h"
 #include "src/Helpers/ImageLoader.h"
 #include "src/Helpers/BinaryAssetImageLoader.h"
 #include "src/Helpers/FileAssetImageLoader.h"
 #include "src/Helpers/PackedAssetImageLoader.h"
+#include "src/Helpers/WarmUICache.h"
+#include "src/Helpers/AssetFileWatcher.h"
 #include "src/Helpers/HitBoxMaskTester.h"
 #include "src/Helpers/ScaledImageSet.h"
 
 #include "src/Components/ComboBox.h"
+#include "src/Components/ContainerComponent.h"
 #include "src/Components/HooverableSwitchComponent.h"
 #include "src/Components/ImageComponent.h"
 #include "src/Components/KnobComponent.h"
+#include "src/Components/PaintProfilerOverlay.h"
 #include "src/Components/PlaceholderComponent.h"
 #include "src/Components/RadioButtonGroup.h"
+#include "src/Components/StaticLayerComponent.h"
 #include "src/Components/SwitchComponent.h"
 #include "src/Components/TweenableComponent.h"
 
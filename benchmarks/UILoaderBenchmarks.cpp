@@ -0,0 +1,658 @@
+/*
+    Benchmarks for the load, layout, hit-test and paint paths.
+
+    Builds like the tests: link against the bd_ui_loader module and its
+    dependencies (and playfultones_packedassets, with the module root on the
+    include path, to include the packed loader). Run it and compare the JSON it
+    writes between releases:
+
+        UILoaderBenchmarks [output.json] [--quick]
+
+    Without an output path the JSON is written to stdout. Every input is
+    generated: synthetic skins with N components and PNG filmstrips, served
+    through a BinaryData-style table, a directory and a pak.
+*/
+
+#include <bd_ui_loader/bd_ui_loader.h>
+
+#if BD_UI_LOADER_HAS_PACKED_ASSETS
+    // Packer-side helpers aren't part of the umbrella header; see tests/PackedAssetImageLoaderTests.cpp
+    #include "src/Packer.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace BogrenDigital::UILoading;
+
+namespace
+{
+    //==============================================================================
+    struct BenchmarkResult
+    {
+        juce::String name;
+        juce::String unit;
+        juce::NamedValueSet parameters;
+        std::vector<double> samples;
+    };
+
+    class BenchmarkRunner
+    {
+    public:
+        /** Calls measureOnce iterations times; it returns one sample in the given unit. */
+        void run (const juce::String& name,
+                  const juce::String& unit,
+                  const juce::NamedValueSet& parameters,
+                  int iterations,
+                  const std::function<double()>& measureOnce)
+        {
+            BenchmarkResult result { name, unit, parameters, {} };
+            result.samples.reserve (static_cast<size_t> (iterations));
+
+            for (int i = 0; i < iterations; ++i)
+                result.samples.push_back (measureOnce());
+
+            juce::Logger::writeToLog (name + ": " + juce::String (median (result.samples), 3) + " " + unit + " (median of " + juce::String (iterations) + ")");
+            results.push_back (std::move (result));
+        }
+
+        juce::String toJSON() const
+        {
+            juce::Array<juce::var> resultArray;
+
+            for (const auto& result : results)
+            {
+                auto sorted = result.samples;
+                std::sort (sorted.begin(), sorted.end());
+
+                const auto mean = std::accumulate (sorted.begin(), sorted.end(), 0.0) / static_cast<double> (sorted.size());
+                const auto variance = std::accumulate (sorted.begin(), sorted.end(), 0.0, [mean] (double sum, double sample) {
+                    return sum + (sample - mean) * (sample - mean);
+                }) / static_cast<double> (sorted.size());
+
+                auto parameters = std::make_unique<juce::DynamicObject>();
+
+                for (const auto& parameter : result.parameters)
+                    parameters->setProperty (parameter.name, parameter.value);
+
+                auto entry = std::make_unique<juce::DynamicObject>();
+                entry->setProperty ("name", result.name);
+                entry->setProperty ("unit", result.unit);
+                entry->setProperty ("iterations", static_cast<int> (sorted.size()));
+                entry->setProperty ("parameters", juce::var (parameters.release()));
+                entry->setProperty ("mean", mean);
+                entry->setProperty ("median", median (sorted));
+                entry->setProperty ("min", sorted.front());
+                entry->setProperty ("max", sorted.back());
+                entry->setProperty ("p90", sorted[static_cast<size_t> (0.9 * static_cast<double> (sorted.size() - 1))]);
+                entry->setProperty ("stddev", std::sqrt (variance));
+                resultArray.add (juce::var (entry.release()));
+            }
+
+            auto root = std::make_unique<juce::DynamicObject>();
+            root->setProperty ("suite", "bd_ui_loader");
+            root->setProperty ("timestamp", juce::Time::getCurrentTime().toISO8601 (true));
+            root->setProperty ("juceVersion", juce::SystemStats::getJUCEVersion());
+            root->setProperty ("cpu", juce::SystemStats::getCpuModel());
+            root->setProperty ("numCpus", juce::SystemStats::getNumCpus());
+            root->setProperty ("operatingSystem", juce::SystemStats::getOperatingSystemName());
+            root->setProperty ("results", resultArray);
+
+            return juce::JSON::toString (juce::var (root.release()));
+        }
+
+    private:
+        static double median (std::vector<double> samples)
+        {
+            std::sort (samples.begin(), samples.end());
+            const auto middle = samples.size() / 2;
+            return samples.size() % 2 == 1 ? samples[middle] : 0.5 * (samples[middle - 1] + samples[middle]);
+        }
+
+        std::vector<BenchmarkResult> results;
+    };
+
+    template <typename Function>
+    double measureMilliseconds (Function&& function)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+        function();
+        return juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start) * 1000.0;
+    }
+
+    //==============================================================================
+    /** A generated skin: metadata.xml plus every PNG it references, keyed by original filename. */
+    struct SyntheticSkin
+    {
+        std::map<juce::String, juce::MemoryBlock> files;
+        int numComponents = 0;
+        int framesPerFilmstrip = 0;
+    };
+
+    juce::MemoryBlock encodePng (const juce::Image& image)
+    {
+        juce::MemoryOutputStream stream;
+        juce::PNGImageFormat().writeImageToStream (image, stream);
+        return stream.getMemoryBlock();
+    }
+
+    juce::Image drawKnobFrame (int size, int frame, int numFrames, juce::Colour colour)
+    {
+        juce::Image image (juce::Image::ARGB, size, size, true);
+        juce::Graphics g (image);
+
+        const auto bounds = image.getBounds().toFloat().reduced (4.0f);
+        g.setGradientFill (juce::ColourGradient (colour.brighter(), bounds.getTopLeft(), colour.darker(), bounds.getBottomRight(), false));
+        g.fillEllipse (bounds);
+
+        const auto angle = juce::MathConstants<float>::twoPi * (0.1f + 0.8f * static_cast<float> (frame) / static_cast<float> (juce::jmax (1, numFrames - 1)));
+        const auto centre = bounds.getCentre();
+        g.setColour (juce::Colours::white);
+        g.drawLine ({ centre, centre.getPointOnCircumference (bounds.getWidth() * 0.4f, angle) }, 3.0f);
+
+        return image;
+    }
+
+    juce::Image drawPlate (int width, int height, juce::Colour colour, float alpha)
+    {
+        juce::Image image (juce::Image::ARGB, width, height, true);
+        juce::Graphics g (image);
+
+        g.setGradientFill (juce::ColourGradient (colour.withAlpha (alpha), 0.0f, 0.0f, colour.darker().withAlpha (alpha), 0.0f, static_cast<float> (height), false));
+        g.fillRoundedRectangle (image.getBounds().toFloat(), 4.0f);
+        g.setColour (juce::Colours::black.withAlpha (alpha * 0.5f));
+        g.drawRoundedRectangle (image.getBounds().toFloat().reduced (1.0f), 4.0f, 2.0f);
+
+        return image;
+    }
+
+    /**
+     * Lays numComponents controls out on a grid over an opaque background, cycling
+     * through every built-in type. Knobs use four distinct filmstrip styles, so
+     * larger skins also exercise the decoded-image caches.
+     */
+    SyntheticSkin makeSkin (int numComponents, int framesPerFilmstrip)
+    {
+        constexpr int cellSize = 100;
+        constexpr int columns = 12;
+        constexpr int knobSize = 96;
+        const int width = columns * cellSize;
+        const int height = juce::jmax (8, (numComponents + columns - 1) / columns) * cellSize;
+
+        SyntheticSkin skin;
+        skin.numComponents = numComponents;
+        skin.framesPerFilmstrip = framesPerFilmstrip;
+
+        auto& files = skin.files;
+        files["background.png"] = encodePng (drawPlate (width, height, juce::Colours::darkslategrey, 1.0f));
+        files["badge.png"] = encodePng (drawPlate (64, 64, juce::Colours::orange, 0.7f));
+        files["handle.png"] = encodePng (drawPlate (32, 16, juce::Colours::silver, 1.0f));
+
+        const juce::StringArray knobStyles { "knobA_", "knobB_", "knobC_", "knobD_" };
+        const juce::Array<juce::Colour> knobColours { juce::Colours::steelblue, juce::Colours::indianred, juce::Colours::seagreen, juce::Colours::goldenrod };
+
+        for (int style = 0; style < knobStyles.size(); ++style)
+            for (int frame = 0; frame < framesPerFilmstrip; ++frame)
+                files[knobStyles[style] + juce::String (frame) + ".png"] = encodePng (drawKnobFrame (knobSize, frame, framesPerFilmstrip, knobColours[style]));
+
+        juce::Image hitbox (juce::Image::ARGB, knobSize, knobSize, true);
+        {
+            juce::Graphics g (hitbox);
+            g.setColour (juce::Colours::white);
+            g.fillEllipse (hitbox.getBounds().toFloat().reduced (4.0f));
+        }
+        files["knob_hitbox.png"] = encodePng (hitbox);
+
+        for (int frame = 0; frame < 2; ++frame)
+            files["switch_" + juce::String (frame) + ".png"] = encodePng (drawPlate (48, 96, frame == 0 ? juce::Colours::grey : juce::Colours::limegreen, 1.0f));
+
+        for (int frame = 0; frame < 3; ++frame)
+        {
+            files["buttons_" + juce::String (frame) + ".png"] = encodePng (drawPlate (96, 32, juce::Colours::slateblue.withRotatedHue (0.1f * static_cast<float> (frame)), 1.0f));
+            files["led_" + juce::String (frame) + ".png"] = encodePng (drawPlate (24, 24, juce::Colours::red.withBrightness (0.3f + 0.3f * static_cast<float> (frame)), 1.0f));
+        }
+
+        juce::XmlElement ui ("UI");
+        ui.setAttribute ("width", width);
+        ui.setAttribute ("height", height);
+
+        auto* background = ui.createNewChildElement ("IMAGE");
+        background->setAttribute ("name", "background");
+        background->setAttribute ("imageType", "raster");
+        background->setAttribute ("file", "background.png");
+        background->setAttribute ("x", 0);
+        background->setAttribute ("y", 0);
+        background->setAttribute ("width", width);
+        background->setAttribute ("height", height);
+
+        for (int i = 0; i < numComponents; ++i)
+        {
+            const int x = (i % columns) * cellSize + 2;
+            const int y = (i / columns) * cellSize + 2;
+
+            auto addElement = [&ui, i, x, y] (const juce::String& type, int w, int h) {
+                auto* element = ui.createNewChildElement (type);
+                element->setAttribute ("name", type.toLowerCase() + juce::String (i));
+                element->setAttribute ("imageType", "raster");
+                element->setAttribute ("x", x);
+                element->setAttribute ("y", y);
+                element->setAttribute ("width", w);
+                element->setAttribute ("height", h);
+                return element;
+            };
+
+            switch (i % 6)
+            {
+                case 0:
+                {
+                    auto* knob = addElement ("KNOB", knobSize, knobSize);
+                    knob->setAttribute ("fileNamePrefix", knobStyles[(i / 6) % knobStyles.size()]);
+                    knob->setAttribute ("fileNameSuffix", ".png");
+                    knob->setAttribute ("numberOfFrames", framesPerFilmstrip);
+                    knob->setAttribute ("hitboxMask", "knob_hitbox.png");
+                    break;
+                }
+                case 1:
+                {
+                    auto* toggle = addElement ("SWITCH", 48, 96);
+                    toggle->setAttribute ("fileNamePrefix", "switch_");
+                    toggle->setAttribute ("fileNameSuffix", ".png");
+                    toggle->setAttribute ("numberOfFrames", 2);
+                    break;
+                }
+                case 2:
+                {
+                    auto* buttons = addElement ("BUTTONS", 96, 32);
+                    buttons->setAttribute ("fileNamePrefix", "buttons_");
+                    buttons->setAttribute ("fileNameSuffix", ".png");
+                    buttons->setAttribute ("numberOfFrames", 3);
+                    break;
+                }
+                case 3:
+                {
+                    addElement ("IMAGE", 64, 64)->setAttribute ("file", "badge.png");
+                    break;
+                }
+                case 4:
+                {
+                    auto* tweenable = addElement ("TWEENABLE", 32, 16);
+                    tweenable->setAttribute ("file", "handle.png");
+                    tweenable->setAttribute ("minX", x);
+                    tweenable->setAttribute ("minY", y);
+                    tweenable->setAttribute ("maxX", x);
+                    tweenable->setAttribute ("maxY", y + 80);
+                    break;
+                }
+                default:
+                {
+                    auto* led = addElement ("LED", 24, 24);
+                    led->setAttribute ("fileNamePrefix", "led_");
+                    led->setAttribute ("fileNameSuffix", ".png");
+                    led->setAttribute ("numberOfFrames", 3);
+                    break;
+                }
+            }
+        }
+
+        const auto xml = ui.toString();
+        files["metadata.xml"] = juce::MemoryBlock (xml.toRawUTF8(), xml.getNumBytesAsUTF8());
+
+        return skin;
+    }
+
+    //==============================================================================
+    /**
+     * Serves a skin through the same function-pointer interface as Projucer's
+     * BinaryData, including its name mangling ("knobA_0.png" -> "knobA_0_png").
+     */
+    struct BinaryDataTable
+    {
+        std::vector<std::string> resourceNames;
+        std::vector<const char*> namedResourceList;
+        std::unordered_map<std::string, const juce::MemoryBlock*> dataByResourceName;
+        std::unordered_map<std::string, std::string> originalFilenameByResourceName;
+
+        static BinaryDataTable& get()
+        {
+            static BinaryDataTable table;
+            return table;
+        }
+
+        void fill (const SyntheticSkin& skin)
+        {
+            resourceNames.clear();
+            namedResourceList.clear();
+            dataByResourceName.clear();
+            originalFilenameByResourceName.clear();
+
+            for (const auto& [filename, data] : skin.files)
+            {
+                const auto resourceName = filename.replaceCharacters (".-/ ", "____").toStdString();
+                resourceNames.push_back (resourceName);
+                dataByResourceName[resourceName] = &data;
+                originalFilenameByResourceName[resourceName] = filename.toStdString();
+            }
+
+            for (const auto& resourceName : resourceNames)
+                namedResourceList.push_back (resourceName.c_str());
+        }
+
+        static const char* getNamedResource (const char* resourceName, int& dataSize)
+        {
+            const auto& table = get();
+
+            if (const auto it = table.dataByResourceName.find (resourceName); it != table.dataByResourceName.end())
+            {
+                dataSize = static_cast<int> (it->second->getSize());
+                return static_cast<const char*> (it->second->getData());
+            }
+
+            dataSize = 0;
+            return nullptr;
+        }
+
+        static const char* getNamedResourceOriginalFilename (const char* resourceName)
+        {
+            const auto& table = get();
+            const auto it = table.originalFilenameByResourceName.find (resourceName);
+            return it != table.originalFilenameByResourceName.end() ? it->second.c_str() : nullptr;
+        }
+    };
+
+    /** One way of serving a skin to the UILoader, plus a factory for fresh loader instances. */
+    struct LoaderSetup
+    {
+        juce::String name;
+        std::function<std::unique_ptr<ImageLoader>()> createLoader;
+    };
+
+    std::vector<LoaderSetup> makeLoaderSetups (const SyntheticSkin& skin, const juce::File& skinDirectory)
+    {
+        std::vector<LoaderSetup> setups;
+
+        BinaryDataTable::get().fill (skin);
+        setups.push_back ({ "binary", [] {
+                               auto& table = BinaryDataTable::get();
+                               return std::make_unique<BinaryAssetImageLoader> (table.namedResourceList.data(),
+                                   static_cast<int> (table.namedResourceList.size()),
+                                   &BinaryDataTable::getNamedResource,
+                                   &BinaryDataTable::getNamedResourceOriginalFilename);
+                           } });
+
+        skinDirectory.deleteRecursively();
+        skinDirectory.createDirectory();
+
+        for (const auto& [filename, data] : skin.files)
+            skinDirectory.getChildFile (filename).replaceWithData (data.getData(), data.getSize());
+
+        setups.push_back ({ "file", [skinDirectory] {
+                               return std::make_unique<FileAssetImageLoader> (skinDirectory);
+                           } });
+
+#if BD_UI_LOADER_HAS_PACKED_ASSETS
+        std::vector<pt::packedassets::InputEntry> entries;
+
+        for (const auto& [filename, data] : skin.files)
+        {
+            const auto* bytes = static_cast<const uint8_t*> (data.getData());
+            entries.push_back ({ filename.toStdString(), { bytes, bytes + data.getSize() } });
+        }
+
+        pt::packedassets::Key key {};
+        key[0] = 42;
+
+        // The source holds a non-owning span, so the pak bytes live as long as the source does
+        auto pak = std::make_shared<std::vector<uint8_t>> (pt::packedassets::pack (entries, key));
+        auto source = std::shared_ptr<const pt::packedassets::PackedAssetSource> (
+            new pt::packedassets::PackedAssetSource (*pak, key),
+            [pak] (const pt::packedassets::PackedAssetSource* p) { delete p; });
+
+        setups.push_back ({ "packed", [source] {
+                               return std::make_unique<PackedAssetImageLoader> (source);
+                           } });
+#endif
+
+        return setups;
+    }
+
+    //==============================================================================
+    /** An editor stand-in: the parent component, its loader and the UILoader, torn down in the right order. */
+    struct LoadedUI
+    {
+        juce::Component parent;
+        std::unique_ptr<ImageLoader> imageLoader;
+        std::unique_ptr<UILoader> uiLoader;
+
+        explicit LoadedUI (std::unique_ptr<ImageLoader> loaderToUse)
+            : imageLoader (std::move (loaderToUse))
+        {
+        }
+
+        void load()
+        {
+            uiLoader = std::make_unique<UILoader> (parent, *imageLoader);
+            uiLoader->loadUI ("metadata.xml");
+        }
+
+        ~LoadedUI()
+        {
+            uiLoader = nullptr;
+        }
+    };
+
+    void releaseProcessWideCaches()
+    {
+        WarmUICache::getInstance()->clear();
+        juce::SharedResourcePointer<SharedImagePool>()->releaseUnusedImages();
+        juce::ImageCache::releaseUnusedImages();
+    }
+
+    juce::NamedValueSet skinParameters (const SyntheticSkin& skin, const juce::String& loaderName = {})
+    {
+        juce::NamedValueSet parameters;
+        parameters.set ("components", skin.numComponents);
+        parameters.set ("framesPerFilmstrip", skin.framesPerFilmstrip);
+
+        if (loaderName.isNotEmpty())
+            parameters.set ("loader", loaderName);
+
+        return parameters;
+    }
+
+    //==============================================================================
+    void benchmarkLoadUI (BenchmarkRunner& runner, const SyntheticSkin& skin, const std::vector<LoaderSetup>& setups, int iterations)
+    {
+        for (const auto& setup : setups)
+        {
+            const auto parameters = skinParameters (skin, setup.name);
+
+            // Cold: nothing decoded or parsed anywhere in the process, as for the first editor after launch
+            UILoader::setWarmCacheTimeToLive (juce::RelativeTime());
+
+            runner.run ("loadUI/cold/" + setup.name, "ms", parameters, iterations, [&setup] {
+                releaseProcessWideCaches();
+
+                LoadedUI ui (setup.createLoader());
+                return measureMilliseconds ([&ui] { ui.load(); });
+            });
+
+            // Warm: an editor of the same UI was closed moments ago
+            UILoader::setWarmCacheTimeToLive (juce::RelativeTime::seconds (30.0));
+            releaseProcessWideCaches();
+            LoadedUI (setup.createLoader()).load();
+
+            runner.run ("loadUI/warm/" + setup.name, "ms", parameters, iterations, [&setup] {
+                LoadedUI ui (setup.createLoader());
+                return measureMilliseconds ([&ui] { ui.load(); });
+            });
+
+            releaseProcessWideCaches();
+        }
+    }
+
+    void benchmarkApplyLayout (BenchmarkRunner& runner, const SyntheticSkin& skin, const LoaderSetup& setup, int sweeps)
+    {
+        LoadedUI ui (setup.createLoader());
+        ui.load();
+
+        const auto baseWidth = ui.uiLoader->getMetadataWidth();
+        const auto baseHeight = ui.uiLoader->getMetadataHeight();
+
+        std::vector<float> scales;
+
+        for (auto scale = 0.5f; scale <= 2.0f + 1.0e-3f; scale += 0.1f)
+            scales.push_back (scale);
+
+        auto parameters = skinParameters (skin);
+        parameters.set ("minScale", scales.front());
+        parameters.set ("maxScale", scales.back());
+        parameters.set ("steps", static_cast<int> (scales.size()));
+
+        size_t step = 0;
+
+        runner.run ("applyLayout/resizeSweep", "ms", parameters, sweeps * static_cast<int> (scales.size()), [&] {
+            const auto scale = scales[step++ % scales.size()];
+            ui.parent.setSize (juce::roundToInt (static_cast<float> (baseWidth) * scale), juce::roundToInt (static_cast<float> (baseHeight) * scale));
+
+            return measureMilliseconds ([&ui] { ui.uiLoader->applyLayout(); });
+        });
+    }
+
+    void benchmarkHitTest (BenchmarkRunner& runner, const SyntheticSkin& skin, const LoaderSetup& setup, int iterations)
+    {
+        LoadedUI ui (setup.createLoader());
+        ui.load();
+        ui.parent.setSize (ui.uiLoader->getMetadataWidth(), ui.uiLoader->getMetadataHeight());
+        ui.uiLoader->applyLayout();
+
+        auto* knob = ui.uiLoader->getComponentByName ("knob0");
+        const auto mask = ui.imageLoader->loadImageByFilename ("knob_hitbox.png");
+
+        if (knob == nullptr || ! mask.isValid())
+            return;
+
+        constexpr int pointsPerAxis = 64;
+        constexpr int callsPerSample = pointsPerAxis * pointsPerAxis;
+
+        auto parameters = skinParameters (skin);
+        parameters.set ("callsPerSample", callsPerSample);
+
+        for (const auto* variant : { "mask", "noMask" })
+        {
+            const auto maskToTest = juce::String (variant) == "mask" ? mask : juce::Image();
+            int hits = 0;
+
+            runner.run (juce::String ("hitTest/") + variant, "ns/call", parameters, iterations, [&] {
+                const auto milliseconds = measureMilliseconds ([&] {
+                    for (int py = 0; py < pointsPerAxis; ++py)
+                        for (int px = 0; px < pointsPerAxis; ++px)
+                            hits += HitBoxMaskTester::hitTest (*knob, px * knob->getWidth() / pointsPerAxis, py * knob->getHeight() / pointsPerAxis, maskToTest) ? 1 : 0;
+                });
+
+                return milliseconds * 1.0e6 / callsPerSample;
+            });
+
+            juce::ignoreUnused (hits);
+        }
+    }
+
+    void benchmarkPaint (BenchmarkRunner& runner, const SyntheticSkin& skin, const LoaderSetup& setup, int iterations)
+    {
+        LoadedUI ui (setup.createLoader());
+        ui.load();
+        ui.parent.setSize (ui.uiLoader->getMetadataWidth(), ui.uiLoader->getMetadataHeight());
+        ui.uiLoader->applyLayout();
+
+        // The first component of each type; "background" stands for large opaque images
+        const std::vector<std::pair<juce::String, juce::String>> targets {
+            { "IMAGE", "background" }, { "IMAGE", "image3" }, { "KNOB", "knob0" }, { "SWITCH", "switch1" },
+            { "BUTTONS", "buttons2" }, { "TWEENABLE", "tweenable4" }, { "LED", "led5" }
+        };
+
+        for (const auto& [type, name] : targets)
+        {
+            auto* component = ui.uiLoader->getComponentByName (name);
+
+            if (component == nullptr || component->getWidth() <= 0 || component->getHeight() <= 0)
+                continue;
+
+            juce::Image target (juce::Image::ARGB, component->getWidth(), component->getHeight(), true);
+            const auto paintOnce = [component, &target] {
+                juce::Graphics g (target);
+                component->paintEntireComponent (g, true);
+            };
+
+            // Let deferred resampling settle before measuring steady-state paints
+            for (int i = 0; i < 3; ++i)
+                paintOnce();
+
+            auto parameters = skinParameters (skin);
+            parameters.set ("component", name);
+            parameters.set ("width", component->getWidth());
+            parameters.set ("height", component->getHeight());
+
+            runner.run ("paint/" + type + "/" + name, "ms", parameters, iterations, [&paintOnce] {
+                return measureMilliseconds (paintOnce);
+            });
+        }
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    const juce::SharedResourcePointer<SharedImagePool> imagePool; // Keep the process-wide pool alive between loaders
+
+    juce::File outputFile;
+    bool quick = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String argument (argv[i]);
+
+        if (argument == "--quick")
+            quick = true;
+        else
+            outputFile = juce::File::getCurrentWorkingDirectory().getChildFile (argument);
+    }
+
+    const auto iterations = quick ? 3 : 20;
+    const auto componentCounts = quick ? std::vector<int> { 24 } : std::vector<int> { 24, 96, 384 };
+    const auto framesPerFilmstrip = quick ? 16 : 64;
+    const auto skinDirectory = juce::File::getSpecialLocation (juce::File::tempDirectory).getChildFile ("bd_ui_loader_benchmark_skin");
+
+    BenchmarkRunner runner;
+
+    for (const auto numComponents : componentCounts)
+    {
+        const auto skin = makeSkin (numComponents, framesPerFilmstrip);
+        const auto setups = makeLoaderSetups (skin, skinDirectory);
+
+        benchmarkLoadUI (runner, skin, setups, iterations);
+
+        // The remaining paths don't depend on where the assets came from
+        benchmarkApplyLayout (runner, skin, setups.front(), quick ? 1 : 5);
+        benchmarkHitTest (runner, skin, setups.front(), iterations);
+        benchmarkPaint (runner, skin, setups.front(), iterations * 5);
+    }
+
+    skinDirectory.deleteRecursively();
+
+    const auto json = runner.toJSON();
+
+    if (outputFile == juce::File())
+        std::cout << json << std::endl;
+    else if (! outputFile.replaceWithText (json))
+        return 1;
+
+    return 0;
+}
@@ -0,0 +1,11 @@
+namespace BogrenDigital::UILoading
+{
+
+    ContainerComponent::ContainerComponent()
+    {
+        // Paints nothing itself; clicks on its empty areas go to whatever is behind it
+        setOpaque (false);
+        setInterceptsMouseClicks (false, true);
+    }
+
+} // namespace BogrenDigital::UILoading
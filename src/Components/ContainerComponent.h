@@ -0,0 +1,23 @@
+#pragma once
+
+namespace BogrenDigital::UILoading
+{
+
+    /**
+     * @brief The component of a CONTAINER element, holding the components of its child elements.
+     *
+     * Children are positioned in the container's own coordinate space, with (0, 0) at its
+     * top left, so moving or resizing the container only lays out its subtree (see
+     * UILoader::applyLayoutToSubtree()). JUCE clips the children to the container and
+     * skips them together with it when it is hidden or outside the area being repainted.
+     */
+    class ContainerComponent : public juce::Component
+    {
+    public:
+        ContainerComponent();
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ContainerComponent)
+    };
+
+} // namespace BogrenDigital::UILoading
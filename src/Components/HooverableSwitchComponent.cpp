@@ -7,13 +7,16 @@ namespace BogrenDigital::UILoading
         if (!shouldDrawButtonAsHighlighted)
             return;
 
+        BD_UI_PROFILE_PAINT ("HooverableSwitchComponent::paint", button);
+
         // Check the toggle state and draw the appropriate image
         if (images != nullptr)
         {
             int imageIndex = 0;
             if (imageIndex < images->size() && (*images)[imageIndex] != nullptr && (*images)[imageIndex]->isValid())
             {
-                g.drawImage (*(*images)[imageIndex], button.getLocalBounds().toFloat());
+                const auto& image = *(*images)[imageIndex];
+                g.drawImage (image, ImageTrimming::getDrawArea (image, button.getLocalBounds().toFloat()));
                 return;
             }
         }
@@ -44,6 +47,14 @@ namespace BogrenDigital::UILoading
         setLookAndFeel (nullptr);
     }
 
+    void HooverableSwitchComponent::getImagesForMemoryReport (MemoryReport::ComponentImages& report) const
+    {
+        for (const auto* image : images)
+            report.images.add (*image);
+
+        report.hitboxMasks.add (hitboxMask);
+    }
+
     bool HooverableSwitchComponent::hitTest (int x, int y)
     {
         return HitBoxMaskTester::hitTest (*this, x, y, hitboxMask);
@@ -8,7 +8,8 @@ namespace BogrenDigital::UILoading {
  * Extends SwitchComponent with hover/highlighted state rendering.
  * Images are displayed based on toggle and hover states.
  */
-class HooverableSwitchComponent : public juce::ToggleButton
+class HooverableSwitchComponent : public juce::ToggleButton,
+                                  public ImageMemoryProvider
 {
 private:
     /** @brief Custom LookAndFeel that draws toggle buttons using the provided images. */
@@ -28,6 +29,7 @@ public:
     HooverableSwitchComponent(const juce::String& name, juce::OwnedArray<juce::Image>& imagesToUse, UILoader::ComponentMetadata metadata, juce::Image hitboxMaskImage = {});
     ~HooverableSwitchComponent() override;
     bool hitTest(int x, int y) override;
+    void getImagesForMemoryReport(MemoryReport::ComponentImages& report) const override;
 
 private:
     juce::OwnedArray<juce::Image> images;
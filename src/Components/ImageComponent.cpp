@@ -2,14 +2,27 @@ namespace BogrenDigital::UILoading
 {
 
     ImageComponent::ImageComponent (const juce::String& name, const juce::Image& imageToUse, UILoader::ComponentMetadata metadata, juce::Image maskImage, juce::Image hitboxMaskImage)
-        : juce::Component (name), DeferredImageResampler (*dynamic_cast<juce::Component*> (this), std::move (maskImage)), hitboxMask (std::move (hitboxMaskImage))
+        : juce::Component (name), DeferredImageResampler (*dynamic_cast<juce::Component*> (this), ImageLoader::getResamplerMask (maskImage)), mask (maskImage), hitboxMask (std::move (hitboxMaskImage)), hasMask (maskImage.isValid())
     {
         setOpaque (false);
         images.add (new juce::Image (imageToUse));
+
+        // Analysed once at load so UILoader can cull whatever this image completely covers
+        fullyOpaque = ! hasMask && ImageAlphaAnalysis::isFullyOpaque (imageToUse);
+    }
+
+    void ImageComponent::setScaledImageSet (std::unique_ptr<ScaledImageSet> set)
+    {
+        scaledImageSet = std::move (set);
+
+        if (scaledImageSet != nullptr)
+            fullyOpaque = ! hasMask && scaledImageSet->isFullyOpaque();
     }
 
     void ImageComponent::paint (juce::Graphics& g)
     {
+        BD_UI_PROFILE_PAINT ("ImageComponent::paint", *this);
+
         if (images.size() > 0)
         {
             if (scaledImageSet != nullptr)
@@ -25,6 +38,38 @@ namespace BogrenDigital::UILoading
         }
     }
 
+    void ImageComponent::paintImmediately (juce::Graphics& g)
+    {
+        if (scaledImageSet != nullptr)
+        {
+            scaledImageSet->drawImage (g, 0, *this, false);
+            return;
+        }
+
+        if (images.isEmpty() || images[0] == nullptr || ! images[0]->isValid())
+            return;
+
+        const auto area = ScaledImageSet::getFloatRect (*this);
+
+        if (hasMask)
+            g.reduceClipRegion (mask, juce::RectanglePlacement (juce::RectanglePlacement::stretchToFit).getTransformToFit (mask.getBounds().toFloat(), area));
+
+        g.setImageResamplingQuality (juce::Graphics::highResamplingQuality);
+        g.drawImage (*images[0], area, juce::RectanglePlacement::stretchToFit);
+    }
+
+    void ImageComponent::getImagesForMemoryReport (MemoryReport::ComponentImages& report) const
+    {
+        for (const auto* image : images)
+            report.images.add (*image);
+
+        if (scaledImageSet != nullptr)
+            scaledImageSet->getImagesForMemoryReport (report);
+
+        report.masks.add (mask);
+        report.hitboxMasks.add (hitboxMask);
+    }
+
     bool ImageComponent::hitTest (int x, int y)
     {
         return HitBoxMaskTester::hitTest (*this, x, y, hitboxMask);
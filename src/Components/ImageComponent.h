@@ -10,18 +10,36 @@ namespace BogrenDigital::UILoading
      * sub-pixel accuracy and smooth scaling.
      */
     class ImageComponent : public juce::Component,
-                           public BogrenDigital::ImageResampler::DeferredImageResampler
+                           public BogrenDigital::ImageResampler::DeferredImageResampler,
+                           public ImageMemoryProvider
     {
     public:
         ImageComponent (const juce::String& name, const juce::Image& imageToUse, UILoader::ComponentMetadata metadata, juce::Image maskImage = {}, juce::Image hitboxMaskImage = {});
         void paint (juce::Graphics& g) override;
         bool hitTest (int x, int y) override;
 
-        void setScaledImageSet (std::unique_ptr<ScaledImageSet> set) { scaledImageSet = std::move (set); }
+        void setScaledImageSet (std::unique_ptr<ScaledImageSet> set);
+
+        /**
+         * @brief Draws the image with high-quality resampling right away.
+         *
+         * Used by StaticLayerComponent, which caches the result: going through DeferredImageResampler
+         * would cache whatever it draws before its resample finishes, and a hidden component never
+         * gets the repaint that follows.
+         */
+        void paintImmediately (juce::Graphics& g);
+
+        /** @brief True if the drawn image covers every pixel of its float bounds (no mask, no translucent pixels). */
+        bool isFullyOpaque() const { return fullyOpaque; }
+
+        void getImagesForMemoryReport (MemoryReport::ComponentImages& report) const override;
 
     private:
         std::unique_ptr<ScaledImageSet> scaledImageSet;
+        juce::Image mask;
         juce::Image hitboxMask;
+        bool hasMask = false;
+        bool fullyOpaque = false;
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ImageComponent)
     };
 
@@ -2,7 +2,7 @@ namespace BogrenDigital::UILoading
 {
 
     KnobComponent::KnobComponent (const juce::String& name, juce::OwnedArray<juce::Image>& imagesToUse, UILoader::ComponentMetadata metadata, juce::Image maskImage, juce::Image hitboxMaskImage)
-        : juce::Slider (name), DeferredImageResampler (*dynamic_cast<juce::Component*> (this), std::move (maskImage)), hitboxMask (std::move (hitboxMaskImage))
+        : juce::Slider (name), DeferredImageResampler (*dynamic_cast<juce::Component*> (this), ImageLoader::getResamplerMask (maskImage)), mask (std::move (maskImage)), hitboxMask (std::move (hitboxMaskImage))
     {
         images.swapWith (imagesToUse); // Transfer ownership of images
         setSliderStyle (juce::Slider::RotaryVerticalDrag);
@@ -13,10 +13,14 @@ namespace BogrenDigital::UILoading
 
     void KnobComponent::paint (juce::Graphics& g)
     {
-        if (images.size() > 0)
+        BD_UI_PROFILE_PAINT ("KnobComponent::paint", *this);
+
+        const auto numFrames = scaledImageSet != nullptr ? scaledImageSet->size() : images.size();
+
+        if (numFrames > 0)
         {
             const auto normalizedValue = getNormalisableRange().convertTo0to1 (getValue());
-            const auto imageIndex = static_cast<int> (normalizedValue * (images.size() - 1));
+            const auto imageIndex = static_cast<int> (normalizedValue * (numFrames - 1));
 
             if (scaledImageSet != nullptr)
                 scaledImageSet->drawImage (g, imageIndex, *this);
@@ -31,6 +35,18 @@ namespace BogrenDigital::UILoading
         }
     }
 
+    void KnobComponent::getImagesForMemoryReport (MemoryReport::ComponentImages& report) const
+    {
+        for (const auto* image : images)
+            report.images.add (*image);
+
+        if (scaledImageSet != nullptr)
+            scaledImageSet->getImagesForMemoryReport (report);
+
+        report.masks.add (mask);
+        report.hitboxMasks.add (hitboxMask);
+    }
+
     bool KnobComponent::hitTest (int x, int y)
     {
         return HitBoxMaskTester::hitTest (*this, x, y, hitboxMask);
@@ -10,7 +10,8 @@ namespace BogrenDigital::UILoading
      * DeferredImageResampler for high-quality scaling.
      */
     class KnobComponent : public juce::Slider,
-                          public BogrenDigital::ImageResampler::DeferredImageResampler
+                          public BogrenDigital::ImageResampler::DeferredImageResampler,
+                          public ImageMemoryProvider
     {
     public:
         KnobComponent (const juce::String& name, juce::OwnedArray<juce::Image>& imagesToUse, UILoader::ComponentMetadata metadata, juce::Image maskImage, juce::Image hitboxMaskImage = {});
@@ -19,8 +20,11 @@ namespace BogrenDigital::UILoading
 
         void setScaledImageSet (std::unique_ptr<ScaledImageSet> set) { scaledImageSet = std::move (set); }
 
+        void getImagesForMemoryReport (MemoryReport::ComponentImages& report) const override;
+
     private:
         std::unique_ptr<ScaledImageSet> scaledImageSet;
+        juce::Image mask;
         juce::Image hitboxMask;
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KnobComponent)
     };
@@ -0,0 +1,234 @@
+namespace BogrenDigital::UILoading
+{
+    juce::Array<PaintProfilerOverlay*> PaintProfilerOverlay::overlays;
+
+    static double ticksToMilliseconds (juce::int64 ticks)
+    {
+        return juce::Time::highResolutionTicksToSeconds (ticks) * 1000.0;
+    }
+
+    PaintProfilerOverlay::ScopedPaint::ScopedPaint (juce::Component& componentBeingPainted) noexcept
+        : component (overlays.isEmpty() ? nullptr : &componentBeingPainted)
+    {
+        if (component != nullptr)
+            startTicks = juce::Time::getHighResolutionTicks();
+    }
+
+    PaintProfilerOverlay::ScopedPaint::~ScopedPaint()
+    {
+        if (component == nullptr)
+            return;
+
+        const auto endTicks = juce::Time::getHighResolutionTicks();
+        const auto milliseconds = ticksToMilliseconds (endTicks - startTicks);
+
+        // Nested profiled components each get the paint
+        for (auto* parent = component->getParentComponent(); parent != nullptr; parent = parent->getParentComponent())
+            for (auto* overlay : overlays)
+                if (&overlay->profiledComponent == parent)
+                    overlay->addPaint (*component, endTicks, milliseconds);
+    }
+
+    //==============================================================================
+    void PaintProfilerOverlay::addPaint (juce::Component& component, juce::int64 endTicks, double milliseconds)
+    {
+        auto& accumulator = accumulators[&component];
+
+        // A new component at the address of a deleted one starts afresh
+        if (accumulator.component == nullptr)
+            accumulator = { &component };
+
+        ++accumulator.numPaints;
+        accumulator.totalMilliseconds += milliseconds;
+        accumulator.maxMilliseconds = juce::jmax (accumulator.maxMilliseconds, milliseconds);
+        accumulator.lastPaintTicks = endTicks;
+        accumulator.lastPaintMilliseconds = milliseconds;
+    }
+
+    PaintProfilerOverlay::PaintProfilerOverlay (juce::Component& componentToProfile)
+        : profiledComponent (componentToProfile)
+    {
+        setInterceptsMouseClicks (false, false);
+        setAlwaysOnTop (true);
+        setOpaque (false);
+
+        overlays.add (this);
+        windowStartTicks = juce::Time::getHighResolutionTicks();
+
+        profiledComponent.addAndMakeVisible (this);
+        profiledComponent.addComponentListener (this);
+        setBounds (profiledComponent.getLocalBounds());
+
+        startTimer (500);
+    }
+
+    PaintProfilerOverlay::~PaintProfilerOverlay()
+    {
+        profiledComponent.removeComponentListener (this);
+        profiledComponent.removeChildComponent (this);
+        overlays.removeFirstMatchingValue (this);
+    }
+
+    void PaintProfilerOverlay::componentMovedOrResized (juce::Component& component, bool wasMoved, bool wasResized)
+    {
+        juce::ignoreUnused (component, wasMoved);
+
+        if (wasResized)
+            setBounds (profiledComponent.getLocalBounds());
+    }
+
+    void PaintProfilerOverlay::timerCallback()
+    {
+        const auto now = juce::Time::getHighResolutionTicks();
+        const auto windowSeconds = juce::jmax (1.0e-3, juce::Time::highResolutionTicksToSeconds (now - windowStartTicks));
+        windowStartTicks = now;
+
+        std::vector<ComponentStatistics> newStatistics;
+
+        for (auto it = accumulators.begin(); it != accumulators.end();)
+        {
+            auto& accumulator = it->second;
+            auto* component = accumulator.component.getComponent();
+
+            if (component == nullptr)
+            {
+                it = accumulators.erase (it);
+                continue;
+            }
+
+            if (profiledComponent.isParentOf (component) && accumulator.numPaints > 0)
+            {
+                newStatistics.push_back ({ accumulator.component,
+                                           accumulator.numPaints,
+                                           accumulator.numPaints / windowSeconds,
+                                           accumulator.totalMilliseconds / accumulator.numPaints,
+                                           accumulator.maxMilliseconds });
+
+                accumulator.numPaints = 0;
+                accumulator.totalMilliseconds = 0.0;
+                accumulator.maxMilliseconds = 0.0;
+            }
+
+            ++it;
+        }
+
+        std::sort (newStatistics.begin(), newStatistics.end(), [] (const auto& a, const auto& b) {
+            return a.getMillisecondsPerSecond() > b.getMillisecondsPerSecond();
+        });
+
+        // Nothing painted and nothing shown: repainting would only disturb the UI
+        if (newStatistics.empty() && statistics.empty())
+            return;
+
+        juce::RectangleList<int> areaToRepaint (getTableBounds());
+
+        for (const auto& componentStatistics : statistics)
+            areaToRepaint.add (getHeatBounds (componentStatistics));
+
+        statistics = std::move (newStatistics);
+
+        for (const auto& componentStatistics : statistics)
+            areaToRepaint.add (getHeatBounds (componentStatistics));
+
+        refreshRequestTicks = now;
+        refreshPending = true;
+
+        for (const auto& area : areaToRepaint)
+            repaint (area);
+    }
+
+    void PaintProfilerOverlay::excludeInducedPaints (juce::Rectangle<int> repaintedArea)
+    {
+        // Components underneath paint in the same pass as the overlay, just before it
+        for (auto& [component, accumulator] : accumulators)
+        {
+            if (accumulator.component == nullptr || accumulator.numPaints == 0 || accumulator.lastPaintTicks < refreshRequestTicks)
+                continue;
+
+            if (! profiledComponent.isParentOf (component) || ! getLocalArea (component, component->getLocalBounds()).intersects (repaintedArea))
+                continue;
+
+            --accumulator.numPaints;
+            accumulator.totalMilliseconds = juce::jmax (0.0, accumulator.totalMilliseconds - accumulator.lastPaintMilliseconds);
+        }
+    }
+
+    juce::Rectangle<int> PaintProfilerOverlay::getHeatBounds (const ComponentStatistics& componentStatistics) const
+    {
+        if (auto* component = componentStatistics.component.getComponent())
+            return getLocalArea (component, component->getLocalBounds());
+
+        return {};
+    }
+
+    juce::Rectangle<int> PaintProfilerOverlay::getTableBounds() const
+    {
+        constexpr int rowHeight = 16;
+        return { 4, 4, juce::jmin (320, getWidth() - 8), rowHeight * (numTopOffenders + 1) + 8 };
+    }
+
+    void PaintProfilerOverlay::paint (juce::Graphics& g)
+    {
+        if (refreshPending)
+        {
+            excludeInducedPaints (g.getClipBounds());
+            refreshPending = false;
+        }
+
+        if (statistics.empty())
+            return;
+
+        const auto maxCost = statistics.front().getMillisecondsPerSecond();
+
+        for (const auto& componentStatistics : statistics)
+        {
+            const auto bounds = getHeatBounds (componentStatistics);
+
+            if (bounds.isEmpty())
+                continue;
+
+            const auto heat = maxCost > 0.0 ? (float) (componentStatistics.getMillisecondsPerSecond() / maxCost) : 0.0f;
+
+            g.setColour (juce::Colours::green.interpolatedWith (juce::Colours::red, heat).withAlpha (0.15f + 0.35f * heat));
+            g.fillRect (bounds);
+
+            if (isOverBudget (componentStatistics))
+            {
+                g.setColour (juce::Colours::red);
+                g.drawRect (bounds, 2);
+            }
+        }
+
+        if (numTopOffenders == 0)
+            return;
+
+        auto table = getTableBounds();
+        g.setColour (juce::Colours::black.withAlpha (0.75f));
+        g.fillRoundedRectangle (table.toFloat(), 4.0f);
+
+        table.reduce (6, 4);
+        g.setFont (12.0f);
+
+        const auto drawRow = [&g, &table] (const juce::String& name, const juce::String& average, const juce::String& maximum, const juce::String& rate) {
+            auto row = table.removeFromTop (16);
+            g.drawText (name, row.removeFromLeft (row.getWidth() - 180), juce::Justification::centredLeft, true);
+            g.drawText (average, row.removeFromLeft (60), juce::Justification::centredRight, false);
+            g.drawText (maximum, row.removeFromLeft (60), juce::Justification::centredRight, false);
+            g.drawText (rate, row, juce::Justification::centredRight, false);
+        };
+
+        g.setColour (juce::Colours::white);
+        drawRow ("Component", "avg ms", "max ms", "paints/s");
+
+        for (size_t i = 0; i < statistics.size() && i < (size_t) numTopOffenders; ++i)
+        {
+            const auto& componentStatistics = statistics[i];
+
+            g.setColour (isOverBudget (componentStatistics) ? juce::Colours::red : juce::Colours::white);
+            drawRow (componentStatistics.component != nullptr ? componentStatistics.component->getName() : juce::String(),
+                     juce::String (componentStatistics.averageMilliseconds, 2),
+                     juce::String (componentStatistics.maxMilliseconds, 2),
+                     juce::String (componentStatistics.paintsPerSecond, 1));
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <unordered_map>
+
+namespace BogrenDigital::UILoading
+{
+    /**
+     * @brief Live heatmap of what painting each component costs, drawn over a running UI.
+     *
+     * Components report their paints with BD_UI_PROFILE_PAINT() (all built-in components
+     * do) while at least one overlay exists. Each overlay collects the paints of the
+     * descendants of its own profiled component, so overlays on several editors keep
+     * apart statistics. Every refresh interval the overlay shades each
+     * component that painted by its paint time per second, outlines those whose slowest
+     * paint exceeded the frame budget and lists the most expensive ones. It covers the
+     * profiled component, stays on top of its children and ignores the mouse.
+     *
+     * Repainting the overlay makes the components underneath paint too; one such paint per
+     * refresh is left out of the statistics. Message thread only.
+     */
+    class PaintProfilerOverlay : public juce::Component,
+                                 private juce::Timer,
+                                 private juce::ComponentListener
+    {
+    public:
+        /** @brief Paint statistics of one component over the last refresh interval. */
+        struct ComponentStatistics
+        {
+            juce::Component::SafePointer<juce::Component> component;
+            int numPaints = 0;
+            double paintsPerSecond = 0.0;
+            double averageMilliseconds = 0.0;
+            double maxMilliseconds = 0.0;
+
+            double getMillisecondsPerSecond() const { return averageMilliseconds * paintsPerSecond; }
+        };
+
+        /** @brief Creates an overlay for the children of componentToProfile and adds it to it. */
+        explicit PaintProfilerOverlay (juce::Component& componentToProfile);
+        ~PaintProfilerOverlay() override;
+
+        /** @brief Components with a paint slower than this are flagged. Defaults to one 60 Hz frame. */
+        void setFrameBudget (double milliseconds) { frameBudgetMilliseconds = milliseconds; }
+        double getFrameBudget() const { return frameBudgetMilliseconds; }
+
+        /** @brief How many components the table lists. Defaults to 5. */
+        void setNumTopOffenders (int numToList) { numTopOffenders = juce::jmax (0, numToList); }
+
+        /** @brief How often statistics are collected and the heatmap redrawn. Defaults to 500 ms. */
+        void setRefreshInterval (int milliseconds) { startTimer (juce::jmax (50, milliseconds)); }
+
+        /** @brief Statistics of the last refresh interval, most expensive first. */
+        const std::vector<ComponentStatistics>& getStatistics() const { return statistics; }
+
+        bool isOverBudget (const ComponentStatistics& componentStatistics) const { return componentStatistics.maxMilliseconds > frameBudgetMilliseconds; }
+
+        void paint (juce::Graphics& g) override;
+
+        /** @brief Measures one paint of a component; use via BD_UI_PROFILE_PAINT(). */
+        class ScopedPaint
+        {
+        public:
+            explicit ScopedPaint (juce::Component& componentBeingPainted) noexcept;
+            ~ScopedPaint();
+
+        private:
+            juce::Component* component;
+            juce::int64 startTicks = 0;
+
+            JUCE_DECLARE_NON_COPYABLE (ScopedPaint)
+        };
+
+    private:
+        struct Accumulator
+        {
+            juce::Component::SafePointer<juce::Component> component;
+            int numPaints = 0;
+            double totalMilliseconds = 0.0;
+            double maxMilliseconds = 0.0;
+            juce::int64 lastPaintTicks = 0;
+            double lastPaintMilliseconds = 0.0;
+        };
+
+        void addPaint (juce::Component& component, juce::int64 endTicks, double milliseconds);
+        void timerCallback() override;
+        void componentMovedOrResized (juce::Component& component, bool wasMoved, bool wasResized) override;
+
+        juce::Rectangle<int> getHeatBounds (const ComponentStatistics& componentStatistics) const;
+        juce::Rectangle<int> getTableBounds() const;
+        void excludeInducedPaints (juce::Rectangle<int> repaintedArea);
+
+        // Every overlay alive, so a paint can be reported to the ones profiling its component
+        static juce::Array<PaintProfilerOverlay*> overlays;
+
+        juce::Component& profiledComponent;
+        std::unordered_map<juce::Component*, Accumulator> accumulators; // Keyed by the painted component
+        std::vector<ComponentStatistics> statistics;
+        double frameBudgetMilliseconds = 1000.0 / 60.0;
+        int numTopOffenders = 5;
+        juce::int64 windowStartTicks = 0;
+        juce::int64 refreshRequestTicks = 0;
+        bool refreshPending = false;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PaintProfilerOverlay)
+    };
+}
+
+/** Traces a component's paint and reports it to any PaintProfilerOverlay. */
+#define BD_UI_PROFILE_PAINT(name, component)                 \
+    BD_UI_TRACE_SCOPE_DETAILED (name, (component).getName()); \
+    const BogrenDigital::UILoading::PaintProfilerOverlay::ScopedPaint JUCE_JOIN_MACRO (bdUiPaintScope_, __LINE__) (component)
@@ -9,7 +9,8 @@ void RadioButtonGroup::InvisibleToggleLookAndFeel::drawToggleButton(juce::Graphi
 
 RadioButtonGroup::RadioButtonGroup(const juce::String& name, juce::OwnedArray<juce::Image>& imagesToUse, UILoader::ComponentMetadata metadata, juce::Image maskImage, juce::Image hitboxMaskImage)
 : juce::Component(name)
-, DeferredImageResampler(*dynamic_cast<juce::Component*>(this), std::move(maskImage))
+, DeferredImageResampler(*dynamic_cast<juce::Component*>(this), ImageLoader::getResamplerMask(maskImage))
+, mask (std::move (maskImage))
 , hitboxMask (std::move (hitboxMaskImage))
 {
     images.swapWith(imagesToUse); // Transfer ownership of images
@@ -60,6 +61,8 @@ void RadioButtonGroup::resized()
 
 void RadioButtonGroup::paint(juce::Graphics& g)
 {
+    BD_UI_PROFILE_PAINT ("RadioButtonGroup::paint", *this);
+
     if (selectedButtonIndex >= 0 && selectedButtonIndex < images.size() &&
         images[selectedButtonIndex] != nullptr && images[selectedButtonIndex]->isValid())
     {
@@ -103,6 +106,18 @@ void RadioButtonGroup::setSelectedButtonIndex(int index)
     }
 }
 
+void RadioButtonGroup::getImagesForMemoryReport (MemoryReport::ComponentImages& report) const
+{
+    for (const auto* image : images)
+        report.images.add (*image);
+
+    if (scaledImageSet != nullptr)
+        scaledImageSet->getImagesForMemoryReport (report);
+
+    report.masks.add (mask);
+    report.hitboxMasks.add (hitboxMask);
+}
+
 bool RadioButtonGroup::hitTest (int x, int y)
 {
     return HitBoxMaskTester::hitTest (*this, x, y, hitboxMask);
@@ -9,7 +9,8 @@ namespace BogrenDigital::UILoading
      * the selection logic. Uses invisible toggle buttons for hit detection.
      */
     class RadioButtonGroup : public juce::Component,
-                             public BogrenDigital::ImageResampler::DeferredImageResampler
+                             public BogrenDigital::ImageResampler::DeferredImageResampler,
+                             public ImageMemoryProvider
     {
     private:
         /** @brief Custom LookAndFeel that makes toggle buttons invisible. */
@@ -35,7 +36,10 @@ namespace BogrenDigital::UILoading
 
         void setScaledImageSet (std::unique_ptr<ScaledImageSet> set) { scaledImageSet = std::move (set); }
 
+        void getImagesForMemoryReport (MemoryReport::ComponentImages& report) const override;
+
     private:
+        juce::Image mask;
         juce::Image hitboxMask;
         InvisibleToggleLookAndFeel invisibleLookAndFeel;
         juce::OwnedArray<juce::ToggleButton> buttons;
@@ -0,0 +1,74 @@
+namespace BogrenDigital::UILoading
+{
+
+    StaticLayerComponent::StaticLayerComponent()
+        : juce::Component ("StaticLayer")
+    {
+        setOpaque (false);
+        setInterceptsMouseClicks (false, false);
+    }
+
+    void StaticLayerComponent::setLayerComponents (const juce::Array<juce::Component*>& componentsToFlatten)
+    {
+        layerComponents = componentsToFlatten;
+        invalidate();
+    }
+
+    void StaticLayerComponent::invalidate()
+    {
+        cachedLayer = {};
+        cachedScale = 0.0f;
+        repaint();
+    }
+
+    void StaticLayerComponent::resized()
+    {
+        invalidate();
+    }
+
+    void StaticLayerComponent::paint (juce::Graphics& g)
+    {
+        BD_UI_PROFILE_PAINT ("StaticLayerComponent::paint", *this);
+
+        if (layerComponents.isEmpty() || getWidth() <= 0 || getHeight() <= 0)
+            return;
+
+        const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+        if (! cachedLayer.isValid() || ! juce::approximatelyEqual (cachedScale, scale))
+            renderLayer (scale);
+
+        // The cache matches the physical pixel grid, so this is a plain blit
+        g.setImageResamplingQuality (juce::Graphics::lowResamplingQuality);
+        g.drawImage (cachedLayer, getLocalBounds().toFloat());
+    }
+
+    void StaticLayerComponent::renderLayer (float scale)
+    {
+        cachedScale = scale;
+        cachedLayer = juce::Image (juce::Image::ARGB,
+            juce::jmax (1, juce::roundToInt (static_cast<float> (getWidth()) * scale)),
+            juce::jmax (1, juce::roundToInt (static_cast<float> (getHeight()) * scale)),
+            true);
+
+        juce::Graphics layerGraphics (cachedLayer);
+        layerGraphics.addTransform (juce::AffineTransform::scale (scale));
+
+        for (auto* component : layerComponents)
+        {
+            // Skip anything UILoader found to be completely covered by an opaque image above it
+            if (component == nullptr || static_cast<bool> (component->getProperties()["occluded"]))
+                continue;
+
+            juce::Graphics::ScopedSaveState saveState (layerGraphics);
+            layerGraphics.setOrigin (component->getPosition());
+            layerGraphics.reduceClipRegion (component->getLocalBounds());
+
+            if (auto* image = dynamic_cast<ImageComponent*> (component))
+                image->paintImmediately (layerGraphics);
+            else
+                component->paintEntireComponent (layerGraphics, true);
+        }
+    }
+
+} // namespace BogrenDigital::UILoading
@@ -0,0 +1,45 @@
+#pragma once
+
+namespace BogrenDigital::UILoading
+{
+
+    /**
+     * @brief Paints a set of static components from a single cached bitmap.
+     *
+     * The layered components are kept (hidden) so their layout and properties
+     * stay up to date, but they are composited only once per size and physical
+     * scale. Afterwards every repaint underneath a busy control costs one blit
+     * instead of one high-quality resample per overlapping image.
+     *
+     * ImageComponents are drawn with ImageComponent::paintImmediately(), so the
+     * bitmap never captures a DeferredImageResampler frame that is still pending.
+     */
+    class StaticLayerComponent : public juce::Component,
+                                 public ImageMemoryProvider
+    {
+    public:
+        StaticLayerComponent();
+
+        /** @brief Sets the components to flatten, in back-to-front paint order. */
+        void setLayerComponents (const juce::Array<juce::Component*>& componentsToFlatten);
+        const juce::Array<juce::Component*>& getLayerComponents() const { return layerComponents; }
+
+        /** @brief Drops the cached bitmap so it is recomposited on the next paint. */
+        void invalidate();
+
+        void paint (juce::Graphics& g) override;
+        void resized() override;
+
+        void getImagesForMemoryReport (MemoryReport::ComponentImages& report) const override { report.caches.add (cachedLayer); }
+
+    private:
+        void renderLayer (float scale);
+
+        juce::Array<juce::Component*> layerComponents;
+        juce::Image cachedLayer;
+        float cachedScale = 0.0f;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StaticLayerComponent)
+    };
+
+} // namespace BogrenDigital::UILoading
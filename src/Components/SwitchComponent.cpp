@@ -4,6 +4,7 @@ namespace BogrenDigital::UILoading
                                 bool shouldDrawButtonAsHighlighted, bool shouldDrawButtonAsDown)
     {
         juce::ignoreUnused(shouldDrawButtonAsHighlighted, shouldDrawButtonAsDown);
+        BD_UI_PROFILE_PAINT ("SwitchComponent::paint", button);
 
         if (images != nullptr)
         {
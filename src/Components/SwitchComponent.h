@@ -27,11 +27,12 @@ namespace BogrenDigital::UILoading
      */
     template <DerivedFromSwitchLookAndFeel LookAndFeelType = SwitchLookAndFeel>
     class SwitchComponent : public juce::ToggleButton,
-                            public BogrenDigital::ImageResampler::DeferredImageResampler
+                            public BogrenDigital::ImageResampler::DeferredImageResampler,
+                            public ImageMemoryProvider
     {
     public:
         SwitchComponent (const juce::String& name, juce::OwnedArray<juce::Image>& imagesToUse, UILoader::ComponentMetadata metadata, juce::Image mask, juce::Image hitboxMaskImage = {})
-            : juce::ToggleButton (name), DeferredImageResampler (*dynamic_cast<juce::Component*> (this), std::move (mask)), hitboxMask (std::move (hitboxMaskImage))
+            : juce::ToggleButton (name), DeferredImageResampler (*dynamic_cast<juce::Component*> (this), ImageLoader::getResamplerMask (mask)), maskImage (std::move (mask)), hitboxMask (std::move (hitboxMaskImage))
         {
             this->images.swapWith (imagesToUse); // Transfer ownership of images to inherited member
             switchLookAndFeel.setImages (&this->images);
@@ -69,7 +70,20 @@ namespace BogrenDigital::UILoading
             juce::ToggleButton::mouseUp (e);
         }
 
+        void getImagesForMemoryReport (MemoryReport::ComponentImages& report) const override
+        {
+            for (const auto* image : this->images)
+                report.images.add (*image);
+
+            if (scaledImageSet != nullptr)
+                scaledImageSet->getImagesForMemoryReport (report);
+
+            report.masks.add (maskImage);
+            report.hitboxMasks.add (hitboxMask);
+        }
+
     private:
+        juce::Image maskImage;
         juce::Image hitboxMask;
         LookAndFeelType switchLookAndFeel;
         std::unique_ptr<ScaledImageSet> scaledImageSet;
@@ -2,28 +2,30 @@ namespace BogrenDigital::UILoading
 {
     TweenableComponent::TweenableComponent(const juce::String& name, const juce::Image& imageToUse, UILoader::ComponentMetadata metadata, juce::Image maskImage, juce::Image hitboxMaskImage)
     : ImageComponent(name, imageToUse, std::move(metadata), std::move(maskImage), std::move(hitboxMaskImage))
-    , timerCallback(*this)
     {
-        timerCallback.callback = [](TweenableComponent& comp) {
-            auto& props = comp.getProperties();
-            props.set("x", juce::jmap(comp.normalizedValue.load(),
-                                static_cast<float>(props["minX"].operator int()),
-                                static_cast<float>(props["maxX"].operator int())));
-            props.set(" y", juce::jmap(comp.normalizedValue.load(),
-                                static_cast<float>(props["minY"].operator int()),
-                                static_cast<float>(props["maxY"].operator int())));
-        };
     }
 
     void TweenableComponent::setNormalizedValue(float newValue)
     {
-        normalizedValue.store(juce::jlimit(0.0f, 1.0f, newValue));
-        onNewPositionNeeded(normalizedValue);
-        repaint();
+        const auto limitedValue = juce::jlimit(0.0f, 1.0f, newValue);
+
+        if (normalizedValue.exchange(limitedValue) == limitedValue)
+            return;
+
+        // Only the transform changes here; JUCE repaints the old and new areas itself.
+        onNewPositionNeeded(limitedValue);
     }
 
     float TweenableComponent::getNormalizedValue() const
     {
         return normalizedValue.load();
     }
+
+    void TweenableComponent::resized()
+    {
+        ImageComponent::resized();
+
+        // The layout scale may have changed, so the pixel offset for the current value must be recomputed
+        onNewPositionNeeded(normalizedValue.load());
+    }
 }
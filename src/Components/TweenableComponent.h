@@ -8,6 +8,11 @@ namespace BogrenDigital::UILoading
      * Supports interpolating between min/max X and Y coordinates based
      * on a normalized value. Useful for sliders, meters, and other
      * position-based animations.
+     *
+     * The component is laid out once at its min position; value changes
+     * only update its transform (see onNewPositionNeeded), so the already
+     * resampled image is redrawn at a sub-pixel offset without any
+     * setBounds/resized work.
      */
     class TweenableComponent : public ImageComponent
     {
@@ -17,6 +22,9 @@ namespace BogrenDigital::UILoading
         void setNormalizedValue(float newValue);
         float getNormalizedValue() const;
 
+        void resized() override;
+
+        /** @brief Called whenever the tween offset must be (re)applied, i.e. on value changes and relayouts. */
         std::function<void(float)> onNewPositionNeeded = [](float newValue)
         {
             juce::ignoreUnused(newValue);
@@ -25,25 +33,6 @@ namespace BogrenDigital::UILoading
     private:
         std::atomic<float> normalizedValue{ 0.0f };
 
-        struct TimerCallback : juce::Timer
-        {
-            explicit TimerCallback(TweenableComponent& owner)
-                : comp(owner)
-            {
-                startTimerHz (30);
-            }
-
-            std::function<void(TweenableComponent&)> callback = [](TweenableComponent& /*component*/){};
-        private:
-            void timerCallback() override
-            {
-                callback(comp);
-            }
-            TweenableComponent& comp;
-        };
-
-        TimerCallback timerCallback;
-
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TweenableComponent)
     };
 }
@@ -9,7 +9,109 @@ juce::Component* ComponentFactory::createComponent (const juce::XmlElement* elem
 
 juce::Component* ComponentFactory::createComponent (const UILoader::ComponentMetadata& metadata)
 {
+    // Taken, so a component the override builds in addition is prepared as usual
+    if (const auto* blueprint = std::exchange (preparedBlueprint, nullptr); blueprint != nullptr)
+        return instantiate (*blueprint);
+
+    if (const auto blueprint = prepare (metadata); blueprint != nullptr)
+        return instantiate (*blueprint);
+
     return new PlaceholderComponent (metadata.name, metadata);
 }
 
+juce::Component* ComponentFactory::createComponentFromBlueprint (const juce::XmlElement& element, const ComponentBlueprint& blueprint)
+{
+    const juce::ScopedValueSetter<const ComponentBlueprint*> usePreparedBlueprint (preparedBlueprint, &blueprint);
+    return createComponent (&element);
+}
+
+std::unique_ptr<const ComponentBlueprint> ComponentFactory::prepare (const UILoader::ComponentMetadata& metadata) const
+{
+    juce::ignoreUnused (metadata);
+    return nullptr;
+}
+
+juce::Component* ComponentFactory::instantiate (const ComponentBlueprint& blueprint)
+{
+    return new PlaceholderComponent (blueprint.metadata.name, blueprint.metadata);
+}
+
+juce::OwnedArray<juce::Image> ComponentFactory::toOwnedArray (const juce::Array<juce::Image>& images)
+{
+    juce::OwnedArray<juce::Image> ownedImages;
+
+    for (const auto& image : images)
+        ownedImages.add (new juce::Image (image));
+
+    return ownedImages;
+}
+
+juce::Array<juce::Image> ComponentFactory::toArray (const juce::OwnedArray<juce::Image>& images)
+{
+    juce::Array<juce::Image> imageArray;
+
+    for (const auto* image : images)
+        imageArray.add (*image);
+
+    return imageArray;
+}
+
+juce::StringArray ComponentFactory::getSequenceFilenames (const juce::String& filePrefix, int numberOfFrames, const juce::String& fileSuffix)
+{
+    juce::StringArray filenames;
+
+    for (int i = 0; i < numberOfFrames; ++i)
+        filenames.add (filePrefix + juce::String (i) + fileSuffix);
+
+    return filenames;
+}
+
+void ComponentFactory::addScaledImages (ComponentBlueprint& blueprint, double scale, const juce::Array<juce::Image>& images,
+                                        ScaledImageSet::LevelSource source)
+{
+    if (images.isEmpty() || ! images.getFirst().isValid())
+        return;
+
+    auto& scaledImages = blueprint.scaledImages;
+    const auto position = std::find_if (scaledImages.begin(), scaledImages.end(), [scale] (const ComponentBlueprint::ScaledImages& s) {
+        return s.scale > scale;
+    });
+
+    scaledImages.insert (position, ComponentBlueprint::ScaledImages { scale, images, nullptr, std::move (source) });
+}
+
+ScaledImageSet::LevelSource ComponentFactory::createLevelSource (const ImageLoader& loader, const juce::StringArray& filenames)
+{
+    return { [&loader, filenames] { return ScaledImageSet::LevelImages { toArray (loader.loadImageSequence ({}, filenames.strings, {})), nullptr }; },
+             [&loader, filenames] { loader.releaseCachedAssets (filenames); } };
+}
+
+std::unique_ptr<ScaledImageSet> ComponentFactory::createScaledImageSet (const ComponentBlueprint& blueprint, bool alwaysCreate)
+{
+    if (blueprint.scaledImages.empty() && ! alwaysCreate)
+        return nullptr;
+
+    auto images1x = toOwnedArray (blueprint.images);
+    auto set = std::make_unique<ScaledImageSet> (images1x);
+    set->addScale (1.0, blueprint.compressedImages);
+
+    for (const auto& scaled : blueprint.scaledImages)
+    {
+        if (scaled.compressedImages != nullptr)
+        {
+            set->addScale (scaled.scale, scaled.compressedImages);
+        }
+        else
+        {
+            auto images = toOwnedArray (scaled.images);
+            set->addScale (scaled.scale, images);
+        }
+
+        if (scaled.source.load != nullptr)
+            set->setLevelSource (scaled.scale, scaled.source);
+    }
+
+    return set;
+}
+
 } // namespace BogrenDigital::UILoading
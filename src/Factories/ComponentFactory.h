@@ -4,6 +4,38 @@ namespace BogrenDigital::UILoading {
 
 struct ImageLoader;
 
+/**
+ * @brief Everything needed to build a component, loaded and decoded ahead of time.
+ *
+ * Produced by ComponentFactory::prepare() on a worker thread and consumed,
+ * read-only, by ComponentFactory::instantiate() on the message thread.
+ * Images are reference counted, so instantiating copies handles, not pixels.
+ * Custom factories can derive from it to carry additional data.
+ */
+struct ComponentBlueprint
+{
+    virtual ~ComponentBlueprint() = default;
+
+    /** @brief The images of one of the metadata's scale variants. */
+    struct ScaledImages
+    {
+        double scale = 2.0;
+        juce::Array<juce::Image> images;
+        std::shared_ptr<const CompressedFilmstrip> compressedImages;
+        ScaledImageSet::LevelSource source; // Loads them again once the ScaledImageSet released them
+    };
+
+    UILoader::ComponentMetadata metadata;
+    juce::Array<juce::Image> images;        // Single image or filmstrip frames
+    std::vector<ScaledImages> scaledImages; // The variants that loaded, ordered by scale
+    juce::Image mask;
+    juce::Image hitboxMask;
+
+    // Set instead of images for filmstrips with frameStorage="compressed", and likewise in scaledImages.
+    // With frameStorage="trimmed", images and scaledImages hold ImageTrimming-cropped frames.
+    std::shared_ptr<const CompressedFilmstrip> compressedImages;
+};
+
 /**
  * @brief Base interface for component factories.
  *
@@ -11,8 +43,14 @@ struct ImageLoader;
  * is responsible for creating a specific component type and loading
  * its required resources.
  *
- * The UILoader always calls the XmlElement overload. The default
- * implementation parses the standard ComponentMetadata fields and
+ * Factories that override prepare() and instantiate() are built in two
+ * stages: the UILoader prepares every element in parallel on worker
+ * threads, then builds the components on the message thread through
+ * createComponentFromBlueprint(). All other factories are called through
+ * createComponent() on the message thread.
+ *
+ * The UILoader calls the XmlElement overload of createComponent(). The
+ * default implementation parses the standard ComponentMetadata fields and
  * dispatches to the metadata overload, which existing factories
  * override. Factories that need access to child elements or CDATA
  * can override the XmlElement overload directly.
@@ -39,13 +77,67 @@ public:
     /**
      * @brief Legacy entry point for factories that only need flat metadata.
      *
-     * Called by the default XmlElement overload. Returns a PlaceholderComponent
-     * unless overridden.
+     * Called by the default XmlElement overload. Builds the component through
+     * prepare() and instantiate() if the factory supports them, otherwise
+     * returns a PlaceholderComponent unless overridden. Within
+     * createComponentFromBlueprint(), instantiates that blueprint instead of
+     * preparing another one.
      */
     virtual juce::Component* createComponent(const UILoader::ComponentMetadata& metadata);
 
+    /**
+     * @brief Builds the component of an element from the blueprint prepare() returned for it.
+     *
+     * Called by the UILoader on the message thread. Goes through createComponent(), so a
+     * subclass overriding either overload still builds the component, and one calling the
+     * base implementation gets the prepared blueprint instantiated.
+     */
+    juce::Component* createComponentFromBlueprint(const juce::XmlElement& element, const ComponentBlueprint& blueprint);
+
+    /**
+     * @brief Loads and decodes everything the component needs.
+     *
+     * Called on worker threads, concurrently for different elements, so it must
+     * only use thread-safe state such as the ImageLoader. Returns nullptr if the
+     * factory doesn't support two-stage creation (the default).
+     */
+    virtual std::unique_ptr<const ComponentBlueprint> prepare(const UILoader::ComponentMetadata& metadata) const;
+
+    /** @brief Builds the component from a prepared blueprint. Called on the message thread. */
+    virtual juce::Component* instantiate(const ComponentBlueprint& blueprint);
+
 protected:
+    /** @brief Copies image handles into the OwnedArray the built-in components take ownership of. */
+    static juce::OwnedArray<juce::Image> toOwnedArray(const juce::Array<juce::Image>& images);
+
+    /** @brief Converts a loaded image sequence into blueprint storage. */
+    static juce::Array<juce::Image> toArray(const juce::OwnedArray<juce::Image>& images);
+
+    /** @brief The file names of a filmstrip's frames, as ImageLoader::loadImageSequence() builds them. */
+    static juce::StringArray getSequenceFilenames(const juce::String& filePrefix, int numberOfFrames, const juce::String& fileSuffix);
+
+    /** @brief Adds the images of a scale variant to the blueprint, unless none of them loaded. */
+    static void addScaledImages(ComponentBlueprint& blueprint, double scale, const juce::Array<juce::Image>& images,
+                                ScaledImageSet::LevelSource source = {});
+
+    /**
+     * @brief Loads the files of a scale variant again through the loader, so its ScaledImageSet can release it.
+     *
+     * Captures the loader rather than the factory, since components outlive the factories that built them.
+     */
+    static ScaledImageSet::LevelSource createLevelSource(const ImageLoader& loader, const juce::StringArray& filenames);
+
+    /**
+     * @brief A ScaledImageSet holding the blueprint's images and every scale variant, with their sources.
+     *
+     * Returns nullptr if the blueprint has no scale variants, unless alwaysCreate is set.
+     */
+    static std::unique_ptr<ScaledImageSet> createScaledImageSet(const ComponentBlueprint& blueprint, bool alwaysCreate = false);
+
     ImageLoader& imageLoader;
+
+private:
+    const ComponentBlueprint* preparedBlueprint = nullptr; // Set while createComponentFromBlueprint() runs
 };
 
 } // namespace BogrenDigital::UILoading
\ No newline at end of file
@@ -11,45 +11,49 @@ public:
     {
     }
 
-    juce::Component* createComponent(const UILoader::ComponentMetadata& metadata) override
+    std::unique_ptr<const ComponentBlueprint> prepare(const UILoader::ComponentMetadata& metadata) const override
     {
-        juce::Component* component = nullptr;
-        auto buttonImages = juce::OwnedArray<juce::Image>();
+        auto blueprint = std::make_unique<ComponentBlueprint>();
+        blueprint->metadata = metadata;
 
-        if (metadata.numberOfFrames > 1)
+        if (metadata.frameStorage == "trimmed")
+        {
+            const auto filenames = metadata.numberOfFrames > 1 ? getSequenceFilenames(metadata.fileNamePrefix, metadata.numberOfFrames, metadata.fileNameSuffix)
+                                                               : juce::StringArray(metadata.name + metadata.fileNameSuffix);
+            blueprint->images = imageLoader.loadTrimmedImages(filenames);
+        }
+        else if (metadata.numberOfFrames > 1)
         {
             juce::Array<int> frameIndices;
             for (int i = 0; i < metadata.numberOfFrames; ++i)
                 frameIndices.add(i);
 
-            auto loadedImages = imageLoader.loadImageSequence(metadata.fileNamePrefix, frameIndices, metadata.fileNameSuffix);
-            for (auto* image : loadedImages)
-                buttonImages.add(new juce::Image(*image));
+            blueprint->images = toArray(imageLoader.loadImageSequence(metadata.fileNamePrefix, frameIndices, metadata.fileNameSuffix));
         }
         else
         {
             juce::String imageName = metadata.name + metadata.fileNameSuffix;
-            juce::Image image = imageLoader.loadImageByFilename(imageName);
-            buttonImages.add(new juce::Image(image));
+            blueprint->images.add(imageLoader.loadImageByFilename(imageName));
         }
 
-        if (buttonImages.size() > 0)
-        {
-            juce::Image hitboxMask;
-            if (metadata.hitboxMask.isNotEmpty())
-            {
-                hitboxMask = imageLoader.loadImageByFilename(metadata.hitboxMask);
-            }
-
-            component = new HooverableSwitchComponent(metadata.name, buttonImages, metadata, hitboxMask);
-        }
-        else
+        if (metadata.hitboxMask.isNotEmpty())
         {
-            component = new PlaceholderComponent(metadata.name, metadata);
+            blueprint->hitboxMask = imageLoader.loadMaskByFilename(metadata.hitboxMask);
         }
 
-        return component;
+        return blueprint;
+    }
+
+    juce::Component* instantiate(const ComponentBlueprint& blueprint) override
+    {
+        const auto& metadata = blueprint.metadata;
+
+        if (blueprint.images.isEmpty())
+            return new PlaceholderComponent(metadata.name, metadata);
+
+        auto buttonImages = toOwnedArray(blueprint.images);
+        return new HooverableSwitchComponent(metadata.name, buttonImages, metadata, blueprint.hitboxMask);
     }
 };
 
-} // namespace BogrenDigital::UILoading
\ No newline at end of file
+} // namespace BogrenDigital::UILoading
@@ -11,32 +11,42 @@ public:
     {
     }
 
-    juce::Component* createComponent(const UILoader::ComponentMetadata& metadata) override
+    std::unique_ptr<const ComponentBlueprint> prepare(const UILoader::ComponentMetadata& metadata) const override
     {
-        juce::Image image = imageLoader.loadImageByFilename(metadata.file);
+        auto blueprint = std::make_unique<ComponentBlueprint>();
+        blueprint->metadata = metadata;
+        blueprint->images.add(imageLoader.loadImageByFilename(metadata.file));
 
         const auto filename = metadata.file.upToLastOccurrenceOf(".", false, false);
         const auto extension = metadata.file.fromLastOccurrenceOf(".", true, false);
         const auto maskFilename = filename + "_mask" + extension;
-        juce::Image maskImage = imageLoader.loadImageByFilename(maskFilename);
+        blueprint->mask = imageLoader.loadMaskByFilename(maskFilename);
 
-        juce::Image hitboxMask;
         if (metadata.hitboxMask.isNotEmpty())
         {
-            hitboxMask = imageLoader.loadImageByFilename(metadata.hitboxMask);
+            blueprint->hitboxMask = imageLoader.loadMaskByFilename(metadata.hitboxMask);
         }
 
-        auto* comp = new ImageComponent(metadata.name, image, metadata, maskImage, hitboxMask);
-
-        if (metadata.file2x.isNotEmpty())
+        for (const auto& variant : metadata.getScaleVariants())
         {
-            juce::Image image1x = imageLoader.loadImageByFilename(metadata.file);
-            juce::Image image2x = imageLoader.loadImageByFilename(metadata.file2x);
-            comp->setScaledImageSet (std::make_unique<ScaledImageSet> (image1x, image2x));
+            if (variant.file.isNotEmpty())
+                addScaledImages(*blueprint, variant.scale, juce::Array<juce::Image> { imageLoader.loadImageByFilename(variant.file) },
+                                createLevelSource(imageLoader, juce::StringArray(variant.file)));
         }
 
+        return blueprint;
+    }
+
+    juce::Component* instantiate(const ComponentBlueprint& blueprint) override
+    {
+        const auto& metadata = blueprint.metadata;
+        auto* comp = new ImageComponent(metadata.name, blueprint.images.getFirst(), metadata, blueprint.mask, blueprint.hitboxMask);
+
+        if (auto scaledImageSet = createScaledImageSet(blueprint))
+            comp->setScaledImageSet (std::move (scaledImageSet));
+
         return comp;
     }
 };
 
-} // namespace BogrenDigital::UILoading
\ No newline at end of file
+} // namespace BogrenDigital::UILoading
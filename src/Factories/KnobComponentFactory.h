@@ -12,45 +12,143 @@ namespace BogrenDigital::UILoading
         {
         }
 
-        juce::Component* createComponent(const UILoader::ComponentMetadata& metadata) override
+        std::unique_ptr<const ComponentBlueprint> prepare(const UILoader::ComponentMetadata& metadata) const override
         {
-            juce::Component* component = nullptr;
+            auto blueprint = std::make_unique<ComponentBlueprint>();
+            blueprint->metadata = metadata;
+            blueprint->images = loadFrames(metadata, metadata.fileNameSuffix);
 
-            auto knobImages = imageLoader.loadImageSequence(metadata.fileNamePrefix, metadata.numberOfFrames, metadata.fileNameSuffix);
+            if (blueprint->images.isEmpty())
+                return blueprint;
 
-            if (knobImages.size() > 0)
+            const auto maskImageName = metadata.fileNamePrefix + "mask" + metadata.fileNameSuffix;
+            blueprint->mask = imageLoader.loadMaskByFilename(maskImageName);
+
+            if (metadata.hitboxMask.isNotEmpty())
+            {
+                blueprint->hitboxMask = imageLoader.loadMaskByFilename(metadata.hitboxMask);
+            }
+
+            for (const auto& variant : metadata.getScaleVariants())
+            {
+                if (variant.fileNameSuffix.isNotEmpty())
+                    addScaledImages(*blueprint, variant.scale, loadFrames(metadata, variant.fileNameSuffix), createFramesSource(imageLoader, metadata, variant.fileNameSuffix));
+            }
+
+            if (metadata.frameStorage == "compressed")
+            {
+                compressFrames(*blueprint);
+            }
+
+            return blueprint;
+        }
+
+        juce::Component* instantiate(const ComponentBlueprint& blueprint) override
+        {
+            const auto& metadata = blueprint.metadata;
+
+            if (blueprint.compressedImages != nullptr)
+                return createScaledImageSetKnob(blueprint, createScaledImageSet(blueprint, true));
+
+            if (blueprint.images.isEmpty())
+                return new PlaceholderComponent(metadata.name, metadata);
+
+            // Trimmed frames must be placed by ScaledImageSet, DeferredImageResampler would stretch them
+            if (metadata.frameStorage == "trimmed")
+                return createScaledImageSetKnob(blueprint, createScaledImageSet(blueprint, true));
+
+            auto knobImages = toOwnedArray(blueprint.images);
+            auto* knob = new KnobComponent(metadata.name, knobImages, metadata, blueprint.mask, blueprint.hitboxMask);
+
+            knob->setRange(0.0, 1.0);
+            knob->setValue(0.5, juce::dontSendNotification);
+
+            if (auto scaledImageSet = createScaledImageSet(blueprint))
+                knob->setScaledImageSet (std::move (scaledImageSet));
+
+            return knob;
+        }
+
+    private:
+        /** A knob drawing only through its ScaledImageSet, without frames for DeferredImageResampler. */
+        static KnobComponent* createScaledImageSetKnob(const ComponentBlueprint& blueprint, std::unique_ptr<ScaledImageSet> scaledImageSet)
+        {
+            juce::OwnedArray<juce::Image> noImages;
+            auto* knob = new KnobComponent(blueprint.metadata.name, noImages, blueprint.metadata, blueprint.mask, blueprint.hitboxMask);
+
+            knob->setRange(0.0, 1.0);
+            knob->setValue(0.5, juce::dontSendNotification);
+            knob->setScaledImageSet (std::move (scaledImageSet));
+            return knob;
+        }
+
+        /** Loads the frames for one of the suffixes, cropped by the loader with frameStorage="trimmed". */
+        juce::Array<juce::Image> loadFrames(const UILoader::ComponentMetadata& metadata, const juce::String& fileNameSuffix) const
+        {
+            if (metadata.frameStorage == "trimmed")
+                return imageLoader.loadTrimmedImages(getSequenceFilenames(metadata.fileNamePrefix, metadata.numberOfFrames, fileNameSuffix));
+
+            return toArray(imageLoader.loadImageSequence(metadata.fileNamePrefix, metadata.numberOfFrames, fileNameSuffix));
+        }
+
+        /** Loads the frames of a scale variant again the way prepare() stores them, once its ScaledImageSet released them. */
+        static ScaledImageSet::LevelSource createFramesSource(const ImageLoader& loader, const UILoader::ComponentMetadata& metadata, const juce::String& fileNameSuffix)
+        {
+            const auto filenames = getSequenceFilenames(metadata.fileNamePrefix, metadata.numberOfFrames, fileNameSuffix);
+
+            if (metadata.frameStorage == "trimmed")
+                return { [&loader, filenames] { return ScaledImageSet::LevelImages { loader.loadTrimmedImages(filenames), nullptr }; },
+                         [&loader, filenames] { loader.releaseCachedAssets(filenames); } };
+
+            // The decoded frames are dropped as soon as they are compressed, so there is nothing cached to release
+            if (metadata.frameStorage == "compressed")
+                return { [&loader, filenames] {
+                            auto compressed = CompressedFilmstrip::create(toArray(loader.loadImageSequence({}, filenames.strings, {})));
+                            loader.releaseDecodedImages(filenames);
+                            return ScaledImageSet::LevelImages { {}, std::move(compressed) };
+                        },
+                         {} };
+
+            return createLevelSource(loader, filenames);
+        }
+
+        /**
+         * Replaces the decoded frames by compressed ones, keeping them if they can't be compressed.
+         * The decoded frames are then dropped from the loader's caches, or they would outlive the compression.
+         */
+        void compressFrames(ComponentBlueprint& blueprint) const
+        {
+            const auto& metadata = blueprint.metadata;
+
+            auto compressed = CompressedFilmstrip::create(blueprint.images);
+
+            if (compressed == nullptr)
+                return;
+
+            // A scaled filmstrip that can't be compressed is dropped rather than keeping it decoded
+            for (auto& scaled : blueprint.scaledImages)
             {
-                const auto maskImageName = metadata.fileNamePrefix + "mask" + metadata.fileNameSuffix;
-                const auto maskImage = imageLoader.loadImageByFilename(maskImageName);
-
-                juce::Image hitboxMask;
-                if (metadata.hitboxMask.isNotEmpty())
-                {
-                    hitboxMask = imageLoader.loadImageByFilename(metadata.hitboxMask);
-                }
-
-                component = new KnobComponent(metadata.name, knobImages, metadata, maskImage, hitboxMask);
-
-                if (auto* knob = dynamic_cast<KnobComponent*>(component))
-                {
-                    knob->setRange(0.0, 1.0);
-                    knob->setValue(0.5, juce::dontSendNotification);
-
-                    if (metadata.fileNameSuffix2x.isNotEmpty())
-                    {
-                        auto images1x = imageLoader.loadImageSequence(metadata.fileNamePrefix, metadata.numberOfFrames, metadata.fileNameSuffix);
-                        auto images2x = imageLoader.loadImageSequence(metadata.fileNamePrefix, metadata.numberOfFrames, metadata.fileNameSuffix2x);
-                        knob->setScaledImageSet (std::make_unique<ScaledImageSet> (images1x, images2x));
-                    }
-                }
+                scaled.compressedImages = CompressedFilmstrip::create(scaled.images);
+                scaled.images.clearQuick();
             }
-            else
+
+            blueprint.scaledImages.erase(std::remove_if(blueprint.scaledImages.begin(), blueprint.scaledImages.end(),
+                                                        [] (const ComponentBlueprint::ScaledImages& s) { return s.compressedImages == nullptr; }),
+                                         blueprint.scaledImages.end());
+
+            blueprint.compressedImages = std::move(compressed);
+            blueprint.images.clearQuick();
+
+            auto frameFilenames = getSequenceFilenames(metadata.fileNamePrefix, metadata.numberOfFrames, metadata.fileNameSuffix);
+
+            for (const auto& variant : metadata.getScaleVariants())
             {
-                component = new PlaceholderComponent(metadata.name, metadata);
+                if (variant.fileNameSuffix.isNotEmpty())
+                    frameFilenames.addArray(getSequenceFilenames(metadata.fileNamePrefix, metadata.numberOfFrames, variant.fileNameSuffix));
             }
 
-            return component;
+            imageLoader.releaseDecodedImages(frameFilenames);
         }
     };
 
-} // namespace BogrenDigital::UILoading
\ No newline at end of file
+} // namespace BogrenDigital::UILoading
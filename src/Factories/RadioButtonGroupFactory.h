@@ -12,48 +12,53 @@ public:
     {
     }
 
-    juce::Component* createComponent(const UILoader::ComponentMetadata& metadata) override
+    std::unique_ptr<const ComponentBlueprint> prepare(const UILoader::ComponentMetadata& metadata) const override
     {
-        juce::Component* component = nullptr;
-        auto buttonImages = juce::OwnedArray<juce::Image>();
+        auto blueprint = std::make_unique<ComponentBlueprint>();
+        blueprint->metadata = metadata;
 
         juce::Array<int> frameIndices;
         for (int i = 0; i < metadata.numberOfFrames; ++i)
             frameIndices.add(i);
 
-        auto loadedImages = imageLoader.loadImageSequence(metadata.fileNamePrefix, frameIndices, metadata.fileNameSuffix);
-        for (auto* image : loadedImages)
-            buttonImages.add(new juce::Image(*image));
+        blueprint->images = toArray(imageLoader.loadImageSequence(metadata.fileNamePrefix, frameIndices, metadata.fileNameSuffix));
 
-        if (buttonImages.size() > 0)
-        {
-            const auto maskImageName = metadata.fileNamePrefix + "mask" + metadata.fileNameSuffix;
-            const auto maskImage = imageLoader.loadImageByFilename(maskImageName);
-
-            juce::Image hitboxMask;
-            if (metadata.hitboxMask.isNotEmpty())
-            {
-                hitboxMask = imageLoader.loadImageByFilename(metadata.hitboxMask);
-            }
-
-            auto* group = new RadioButtonGroup(metadata.name, buttonImages, metadata, maskImage, hitboxMask);
+        if (blueprint->images.isEmpty())
+            return blueprint;
 
-            if (metadata.fileNameSuffix2x.isNotEmpty())
-            {
-                auto images1x = imageLoader.loadImageSequence(metadata.fileNamePrefix, frameIndices, metadata.fileNameSuffix);
-                auto images2x = imageLoader.loadImageSequence(metadata.fileNamePrefix, frameIndices, metadata.fileNameSuffix2x);
-                group->setScaledImageSet (std::make_unique<ScaledImageSet> (images1x, images2x));
-            }
+        const auto maskImageName = metadata.fileNamePrefix + "mask" + metadata.fileNameSuffix;
+        blueprint->mask = imageLoader.loadMaskByFilename(maskImageName);
 
-            component = group;
+        if (metadata.hitboxMask.isNotEmpty())
+        {
+            blueprint->hitboxMask = imageLoader.loadMaskByFilename(metadata.hitboxMask);
         }
-        else
+
+        for (const auto& variant : metadata.getScaleVariants())
         {
-            component = new PlaceholderComponent(metadata.name, metadata);
+            if (variant.fileNameSuffix.isNotEmpty())
+                addScaledImages(*blueprint, variant.scale, toArray(imageLoader.loadImageSequence(metadata.fileNamePrefix, frameIndices, variant.fileNameSuffix)),
+                                createLevelSource(imageLoader, getSequenceFilenames(metadata.fileNamePrefix, metadata.numberOfFrames, variant.fileNameSuffix)));
         }
 
-        return component;
+        return blueprint;
+    }
+
+    juce::Component* instantiate(const ComponentBlueprint& blueprint) override
+    {
+        const auto& metadata = blueprint.metadata;
+
+        if (blueprint.images.isEmpty())
+            return new PlaceholderComponent(metadata.name, metadata);
+
+        auto buttonImages = toOwnedArray(blueprint.images);
+        auto* group = new RadioButtonGroup(metadata.name, buttonImages, metadata, blueprint.mask, blueprint.hitboxMask);
+
+        if (auto scaledImageSet = createScaledImageSet(blueprint))
+            group->setScaledImageSet (std::move (scaledImageSet));
+
+        return group;
     }
 };
 
-} // namespace BogrenDigital::UILoading
\ No newline at end of file
+} // namespace BogrenDigital::UILoading
@@ -12,41 +12,48 @@ public:
     {
     }
 
-    juce::Component* createComponent(const UILoader::ComponentMetadata& metadata) override
+    std::unique_ptr<const ComponentBlueprint> prepare(const UILoader::ComponentMetadata& metadata) const override
     {
-        juce::Component* component = nullptr;
+        auto blueprint = std::make_unique<ComponentBlueprint>();
+        blueprint->metadata = metadata;
+        blueprint->images = toArray(imageLoader.loadImageSequence(metadata.fileNamePrefix, metadata.numberOfFrames, metadata.fileNameSuffix));
 
-        auto buttonImages = imageLoader.loadImageSequence(metadata.fileNamePrefix, metadata.numberOfFrames, metadata.fileNameSuffix);
+        if (blueprint->images.isEmpty())
+            return blueprint;
 
-        if (buttonImages.size() > 0)
+        const auto maskImageName = metadata.fileNamePrefix + "mask" + metadata.fileNameSuffix;
+        blueprint->mask = imageLoader.loadMaskByFilename(maskImageName);
+
+        if (metadata.hitboxMask.isNotEmpty())
         {
-            const auto maskImageName = metadata.fileNamePrefix + "mask" + metadata.fileNameSuffix;
-            const auto maskImage = imageLoader.loadImageByFilename(maskImageName);
+            blueprint->hitboxMask = imageLoader.loadMaskByFilename(metadata.hitboxMask);
+        }
 
-            juce::Image hitboxMask;
-            if (metadata.hitboxMask.isNotEmpty())
-            {
-                hitboxMask = imageLoader.loadImageByFilename(metadata.hitboxMask);
-            }
+        for (const auto& variant : metadata.getScaleVariants())
+        {
+            if (variant.fileNameSuffix.isNotEmpty())
+                addScaledImages(*blueprint, variant.scale, toArray(imageLoader.loadImageSequence(metadata.fileNamePrefix, metadata.numberOfFrames, variant.fileNameSuffix)),
+                                createLevelSource(imageLoader, getSequenceFilenames(metadata.fileNamePrefix, metadata.numberOfFrames, variant.fileNameSuffix)));
+        }
 
-            auto* switchComp = new SwitchComponent(metadata.name, buttonImages, metadata, maskImage, hitboxMask);
+        return blueprint;
+    }
 
-            if (metadata.fileNameSuffix2x.isNotEmpty())
-            {
-                auto images1x = imageLoader.loadImageSequence(metadata.fileNamePrefix, metadata.numberOfFrames, metadata.fileNameSuffix);
-                auto images2x = imageLoader.loadImageSequence(metadata.fileNamePrefix, metadata.numberOfFrames, metadata.fileNameSuffix2x);
-                switchComp->setScaledImageSet (std::make_unique<ScaledImageSet> (images1x, images2x));
-            }
+    juce::Component* instantiate(const ComponentBlueprint& blueprint) override
+    {
+        const auto& metadata = blueprint.metadata;
 
-            component = switchComp;
-        }
-        else
-        {
-            component = new PlaceholderComponent(metadata.name, metadata);
-        }
+        if (blueprint.images.isEmpty())
+            return new PlaceholderComponent(metadata.name, metadata);
+
+        auto buttonImages = toOwnedArray(blueprint.images);
+        auto* switchComp = new SwitchComponent(metadata.name, buttonImages, metadata, blueprint.mask, blueprint.hitboxMask);
+
+        if (auto scaledImageSet = createScaledImageSet(blueprint))
+            switchComp->setScaledImageSet (std::move (scaledImageSet));
 
-        return component;
+        return switchComp;
     }
 };
 
-} // namespace BogrenDigital::UILoading
\ No newline at end of file
+} // namespace BogrenDigital::UILoading
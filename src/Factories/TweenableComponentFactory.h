@@ -13,32 +13,47 @@ public:
     {
     }
 
-    juce::Component* createComponent(const UILoader::ComponentMetadata& metadata) override
+    std::unique_ptr<const ComponentBlueprint> prepare(const UILoader::ComponentMetadata& metadata) const override
     {
-        juce::Image image = imageLoader.loadImageByFilename(metadata.file);
+        auto blueprint = std::make_unique<ComponentBlueprint>();
+        blueprint->metadata = metadata;
+        blueprint->images.add(imageLoader.loadImageByFilename(metadata.file));
 
         const auto filename = metadata.file.upToLastOccurrenceOf(".", false, false);
         const auto extension = metadata.file.fromLastOccurrenceOf(".", true, false);
         const auto maskFilename = filename + "_mask" + extension;
-        juce::Image maskImage = imageLoader.loadImageByFilename(maskFilename);
+        blueprint->mask = imageLoader.loadMaskByFilename(maskFilename);
 
-        juce::Image hitboxMask;
         if (metadata.hitboxMask.isNotEmpty())
         {
-            hitboxMask = imageLoader.loadImageByFilename(metadata.hitboxMask);
+            blueprint->hitboxMask = imageLoader.loadMaskByFilename(metadata.hitboxMask);
         }
 
-        TweenableComponent* component = new TweenableComponent(metadata.name, image, metadata, maskImage, hitboxMask);
+        return blueprint;
+    }
+
+    juce::Component* instantiate(const ComponentBlueprint& blueprint) override
+    {
+        const auto& metadata = blueprint.metadata;
+
+        TweenableComponent* component = new TweenableComponent(metadata.name, blueprint.images.getFirst(), metadata, blueprint.mask, blueprint.hitboxMask);
         UILoader* uiBuilder = &uiLoader;
 
-        // Set up the callback for position updates when the normalized value changes
-        component->onNewPositionNeeded = [uiBuilder, component](float normalizedValue)
-        {
-            juce::ignoreUnused(normalizedValue);
+        // The component stays laid out at (minX, minY); value changes only move it via its transform,
+        // so no setBounds/resized/resampling happens while tweening.
+        const auto travel = juce::Point<float>(static_cast<float>(metadata.maxX - metadata.minX),
+                                               static_cast<float>(metadata.maxY - metadata.minY));
 
+        component->onNewPositionNeeded = [uiBuilder, component, travel](float normalizedValue)
+        {
             if(component != nullptr && uiBuilder != nullptr)
             {
-                uiBuilder->applyLayoutToComponent(component);
+                // Inside a CONTAINER, the travel is in the container's coordinate space
+                const auto layoutTransform = uiBuilder->getLayoutTransform(*component);
+                const auto offset = (travel * normalizedValue).transformedBy(layoutTransform)
+                                    - juce::Point<float>().transformedBy(layoutTransform);
+
+                component->setTransform(juce::AffineTransform::translation(offset.x, offset.y));
             }
             else
             {
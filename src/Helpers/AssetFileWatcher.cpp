@@ -0,0 +1,59 @@
+namespace BogrenDigital::UILoading
+{
+    AssetFileWatcher::AssetFileWatcher (const juce::File& directoryToWatch, std::function<void (const juce::StringArray&)> callback)
+        : directory (directoryToWatch),
+          onFilesChanged (std::move (callback)),
+          snapshot (scanDirectory())
+    {
+    }
+
+    AssetFileWatcher::~AssetFileWatcher()
+    {
+        stopTimer();
+    }
+
+    void AssetFileWatcher::startWatching (int pollIntervalMilliseconds)
+    {
+        startTimer (pollIntervalMilliseconds);
+    }
+
+    juce::StringArray AssetFileWatcher::checkForChanges()
+    {
+        auto newSnapshot = scanDirectory();
+        juce::StringArray changedFiles;
+
+        for (const auto& [name, state] : newSnapshot)
+        {
+            if (const auto it = snapshot.find (name); it == snapshot.end() || ! (it->second == state))
+                changedFiles.add (name);
+        }
+
+        for (const auto& [name, state] : snapshot)
+        {
+            if (! newSnapshot.contains (name))
+                changedFiles.add (name);
+        }
+
+        snapshot = std::move (newSnapshot);
+        return changedFiles;
+    }
+
+    AssetFileWatcher::Snapshot AssetFileWatcher::scanDirectory() const
+    {
+        Snapshot files;
+
+        for (const auto& entry : juce::RangedDirectoryIterator (directory, true, "*", juce::File::findFiles))
+        {
+            const auto name = entry.getFile().getRelativePathFrom (directory).replaceCharacter ('\\', '/');
+            files[name] = { entry.getModificationTime(), entry.getFileSize() };
+        }
+
+        return files;
+    }
+
+    void AssetFileWatcher::timerCallback()
+    {
+        if (const auto changedFiles = checkForChanges(); ! changedFiles.isEmpty() && onFilesChanged != nullptr)
+            onFilesChanged (changedFiles);
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <map>
+
+namespace BogrenDigital::UILoading
+{
+    /**
+     * @brief Polls an asset directory and reports the files that were added, modified or removed.
+     *
+     * Used for hot reloading UIs loaded from disk. Files are compared by modification
+     * time and size; names are reported relative to the directory with '/' separators,
+     * as used in the metadata XML. Message thread only.
+     */
+    class AssetFileWatcher : private juce::Timer
+    {
+    public:
+        AssetFileWatcher (const juce::File& directoryToWatch, std::function<void (const juce::StringArray&)> onFilesChanged);
+        ~AssetFileWatcher() override;
+
+        /** @brief Starts polling; onFilesChanged is called with the changes found on each poll. */
+        void startWatching (int pollIntervalMilliseconds = 500);
+
+        /** @brief Rescans the directory and returns what changed since the previous scan. */
+        juce::StringArray checkForChanges();
+
+    private:
+        struct FileState
+        {
+            juce::Time lastModified;
+            juce::int64 size = 0;
+
+            bool operator== (const FileState& other) const { return lastModified == other.lastModified && size == other.size; }
+        };
+
+        using Snapshot = std::map<juce::String, FileState>;
+
+        Snapshot scanDirectory() const;
+        void timerCallback() override;
+
+        juce::File directory;
+        std::function<void (const juce::StringArray&)> onFilesChanged;
+        Snapshot snapshot;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AssetFileWatcher)
+    };
+}
@@ -0,0 +1,140 @@
+#include "../../third_party/include/BS_thread_pool.hpp"
+
+namespace BogrenDigital::UILoading
+{
+    namespace
+    {
+        // Separate from the loaders' own pools: requests block on them while loading sequences
+        struct AsyncImageLoadingThreadPool
+        {
+            BS::thread_pool<> threadPool;
+
+            AsyncImageLoadingThreadPool()
+                : threadPool (static_cast<std::size_t> (juce::SystemStats::getNumCpus())) {}
+        };
+
+        juce::SharedResourcePointer<AsyncImageLoadingThreadPool> asyncThreadPool;
+
+        juce::Array<juce::Image> toArray (juce::OwnedArray<juce::Image> images)
+        {
+            juce::Array<juce::Image> result;
+
+            for (const auto* image : images)
+                result.add (*image);
+
+            return result;
+        }
+    }
+
+    ImageRequest ImageRequest::file (const juce::String& filename)
+    {
+        ImageRequest request;
+        request.filename = filename;
+        return request;
+    }
+
+    ImageRequest ImageRequest::mask (const juce::String& filename)
+    {
+        auto request = file (filename);
+        request.kind = Kind::mask;
+        return request;
+    }
+
+    ImageRequest ImageRequest::sequence (const juce::String& filePrefix, int numberOfFrames, const juce::String& fileSuffix)
+    {
+        ImageRequest request;
+        request.kind = Kind::frameCount;
+        request.filePrefix = filePrefix;
+        request.fileSuffix = fileSuffix;
+        request.numberOfFrames = numberOfFrames;
+        return request;
+    }
+
+    ImageRequest ImageRequest::sequence (const juce::String& filePrefix, const juce::Array<int>& fileIndices, const juce::String& fileSuffix)
+    {
+        auto request = sequence (filePrefix, 0, fileSuffix);
+        request.kind = Kind::frameIndices;
+        request.fileIndices = fileIndices;
+        return request;
+    }
+
+    ImageRequest ImageRequest::sequence (const juce::String& filePrefix, const juce::Array<juce::String>& fileNames, const juce::String& fileSuffix)
+    {
+        auto request = sequence (filePrefix, 0, fileSuffix);
+        request.kind = Kind::frameNames;
+        request.fileNames = fileNames;
+        return request;
+    }
+
+    juce::Array<juce::Image> ImageRequest::load (const ImageLoader& loader) const
+    {
+        switch (kind)
+        {
+            case Kind::file:
+                if (auto image = loader.loadImageByFilename (filename); image.isValid())
+                    return { image };
+
+                return {};
+
+            case Kind::mask:
+                if (auto image = loader.loadMaskByFilename (filename); image.isValid())
+                    return { image };
+
+                return {};
+
+            case Kind::frameCount:
+                return toArray (loader.loadImageSequence (filePrefix, numberOfFrames, fileSuffix));
+
+            case Kind::frameIndices:
+                return toArray (loader.loadImageSequence (filePrefix, fileIndices, fileSuffix));
+
+            case Kind::frameNames:
+                return toArray (loader.loadImageSequence (filePrefix, fileNames, fileSuffix));
+        }
+
+        return {};
+    }
+
+    ImageBatch::ImageBatch (const ImageLoader& loader, std::vector<ImageRequest> requestsToLoad, Callback onLoadedToUse)
+        : requests (std::move (requestsToLoad)), onLoaded (std::move (onLoadedToUse))
+    {
+        futures.reserve (requests.size());
+
+        // Tasks only touch this batch and the loader, and the destructor waits for all of them.
+        // Neither the LoadRecorder nor the PrefetchManifest::Recorder is passed on: a batch may outlive
+        // the load that started it, and with it its recorders, so prefetches never end up in a report or manifest.
+        for (size_t i = 0; i < requests.size(); ++i)
+        {
+            futures.push_back (asyncThreadPool->threadPool.submit_task ([this, &loader, i] {
+                if (cancelled)
+                    return juce::Array<juce::Image>();
+
+                auto images = requests[i].load (loader);
+
+                if (onLoaded != nullptr)
+                    onLoaded ((int) i, images);
+
+                return images;
+            }).share());
+        }
+    }
+
+    ImageBatch::~ImageBatch()
+    {
+        cancel();
+        wait();
+    }
+
+    void ImageBatch::wait() const
+    {
+        for (const auto& future : futures)
+            future.wait();
+    }
+
+    bool ImageBatch::isFinished() const
+    {
+        return std::all_of (futures.begin(), futures.end(), [] (const auto& future) {
+            return future.wait_for (std::chrono::seconds (0)) == std::future_status::ready;
+        });
+    }
+}
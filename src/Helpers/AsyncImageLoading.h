@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <vector>
+
+namespace BogrenDigital::UILoading
+{
+    struct ImageLoader;
+
+    /** @brief One image or image sequence to load through ImageLoader::loadAsync(). */
+    struct ImageRequest
+    {
+        static ImageRequest file (const juce::String& filename);
+        static ImageRequest mask (const juce::String& filename);
+        static ImageRequest sequence (const juce::String& filePrefix, int numberOfFrames, const juce::String& fileSuffix);
+        static ImageRequest sequence (const juce::String& filePrefix, const juce::Array<int>& fileIndices, const juce::String& fileSuffix);
+        static ImageRequest sequence (const juce::String& filePrefix, const juce::Array<juce::String>& fileNames, const juce::String& fileSuffix);
+
+        /** @brief Loads the request with the loader's blocking calls; a file or mask yields at most one image. */
+        juce::Array<juce::Image> load (const ImageLoader& loader) const;
+
+        enum class Kind
+        {
+            file,
+            mask,
+            frameCount,
+            frameIndices,
+            frameNames
+        };
+
+        Kind kind = Kind::file;
+        juce::String filename; // Kind::file and Kind::mask, otherwise filePrefix + frame + fileSuffix
+        juce::String filePrefix;
+        juce::String fileSuffix;
+        int numberOfFrames = 0;
+        juce::Array<int> fileIndices;
+        juce::Array<juce::String> fileNames;
+    };
+
+    /**
+     * @brief The requests of one ImageLoader::loadAsync() call, in flight.
+     *
+     * Each request has a future holding its images, empty if nothing could be loaded or the
+     * request was cancelled before it started. Destroying the batch cancels the requests that
+     * haven't started and waits for the others, so the loader only has to outlive the batch.
+     */
+    class ImageBatch
+    {
+    public:
+        /** Called on a worker thread as each request finishes, in completion order. */
+        using Callback = std::function<void (int requestIndex, const juce::Array<juce::Image>& images)>;
+
+        ~ImageBatch();
+
+        int size() const { return (int) futures.size(); }
+
+        std::shared_future<juce::Array<juce::Image>> getFuture (int requestIndex) const { return futures[(size_t) requestIndex]; }
+
+        /** @brief Requests that haven't started finish without images and without a callback. */
+        void cancel() { cancelled = true; }
+        bool isCancelled() const { return cancelled; }
+
+        /** @brief Blocks until every request has finished or been cancelled. */
+        void wait() const;
+
+        bool isFinished() const;
+
+    private:
+        friend struct ImageLoader;
+
+        ImageBatch (const ImageLoader& loader, std::vector<ImageRequest> requests, Callback onLoaded);
+
+        const std::vector<ImageRequest> requests;
+        const Callback onLoaded;
+        std::atomic<bool> cancelled { false };
+        std::vector<std::shared_future<juce::Array<juce::Image>>> futures;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ImageBatch)
+    };
+}
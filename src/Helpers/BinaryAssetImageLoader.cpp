@@ -18,17 +18,40 @@ namespace BogrenDigital::UILoading
 
     static juce::SharedResourcePointer<SharedImageLoadingThreadPool> sharedThreadPool;
 
+    /** Identifies a BinaryData table by the names and sizes of its resources, which don't depend on where it is loaded. */
+    static juce::String getResourceTableFingerprint (const char* const* namedResourceList,
+        int numAssets,
+        const BinaryAssetUtilities::GetNamedResourceFunc& getNamedResource)
+    {
+        juce::String description;
+
+        for (int i = 0; i < numAssets; ++i)
+        {
+            int dataSize = 0;
+            getNamedResource (namedResourceList[i], dataSize);
+            description << namedResourceList[i] << ':' << dataSize << '\n';
+        }
+
+        return juce::String::toHexString (description.hashCode64());
+    }
+
     BinaryAssetImageLoader::BinaryAssetImageLoader (const char* const* namedResourceListPtr,
         int numAssets,
         BinaryAssetUtilities::GetNamedResourceFunc getNamedResourcePtr,
         BinaryAssetUtilities::GetNamedResourceOriginalFilenameFunc getOriginalFilenamePtr)
-        : BinaryAssetLoader (namedResourceListPtr, numAssets, getNamedResourcePtr, getOriginalFilenamePtr)
+        : BinaryAssetLoader (namedResourceListPtr, numAssets, getNamedResourcePtr, getOriginalFilenamePtr),
+          assetSourceIdentifier ("binary:" + getResourceTableFingerprint (namedResourceListPtr, numAssets, getNamedResourcePtr))
     {
     }
 
     BinaryAssetImageLoader::~BinaryAssetImageLoader() = default;
 
     juce::Image BinaryAssetImageLoader::loadImageFromBinaryData (const juce::String& resourceName) const
+    {
+        return loadResource (resourceName, resourceName);
+    }
+
+    juce::Image BinaryAssetImageLoader::loadResource (const juce::String& resourceName, const juce::String& filename) const
     {
         int dataSize = 0;
         const char* imageData = getNamedResource (resourceName.toRawUTF8(), dataSize);
@@ -41,19 +64,9 @@ namespace BogrenDigital::UILoading
 
         const auto hashCode = resourceName.hashCode64();
 
-        if (auto cachedImage = juce::ImageCache::getFromHashCode (hashCode); cachedImage.isValid())
-        {
-            return cachedImage;
-        }
-
-        auto image = juce::ImageFileFormat::loadFrom (imageData, static_cast<size_t> (dataSize));
-
-        if (image.isValid())
-        {
-            juce::ImageCache::addImageToCache (image, hashCode);
-        }
-
-        return image;
+        return getOrDecodeAsset (filename, hashCode, [this, imageData, dataSize] {
+            return decodeImage (imageData, static_cast<size_t> (dataSize));
+        });
     }
 
     juce::Image BinaryAssetImageLoader::loadImageByFilename (const juce::String& filename) const
@@ -63,7 +76,7 @@ namespace BogrenDigital::UILoading
             return {};
         }
 
-        return loadImageFromBinaryData (getResourceName (filename));
+        return loadResource (getResourceName (filename), filename);
     }
 
     juce::OwnedArray<juce::Image> BinaryAssetImageLoader::loadImageSequenceFromFilenames (
@@ -92,10 +105,15 @@ namespace BogrenDigital::UILoading
         }
 
         std::vector<juce::Image> loadedImages (numImages);
+        std::vector<std::future<void>> pendingLoads;
+        pendingLoads.reserve (filenames.size());
 
         for (int i = 0; i < numImages; ++i)
         {
-            sharedThreadPool->threadPool.detach_task ([this, &loadedImages, filename = filenames[i], index = i] {
+            pendingLoads.push_back (sharedThreadPool->threadPool.submit_task ([this, &loadedImages, filename = filenames[i], index = i, recorder = LoadRecorder::getCurrent(), accessRecorder = PrefetchManifest::Recorder::getCurrent()] {
+                const LoadRecorder::ScopedActivation activation (recorder);
+                const PrefetchManifest::Recorder::ScopedActivation accessActivation (accessRecorder);
+
                 if (const auto image = loadImageByFilename (filename); image.isValid())
                 {
                     loadedImages[index] = std::move (image);
@@ -104,10 +122,12 @@ namespace BogrenDigital::UILoading
                 {
                     juce::Logger::writeToLog ("Could not load " + filename);
                 }
-            });
+            }));
         }
 
-        sharedThreadPool->threadPool.wait();
+        // Wait for this sequence only; other threads may be loading through the shared pool at the same time
+        for (auto& pendingLoad : pendingLoads)
+            pendingLoad.wait();
 
         for (auto& image : loadedImages)
         {
@@ -29,6 +29,9 @@ namespace BogrenDigital::UILoading
         /**
          * @brief Loads an image from binary data by resource name.
          * 
+         * Load reports and prefetch manifests list the image under its resource name, which
+         * loadImageByFilename() can't resolve; use that instead for images worth prefetching.
+         *
          * @param resourceName The resource name (e.g., "Background_png")
          * @return The loaded image, or an empty image if not found
          */
@@ -90,7 +93,22 @@ namespace BogrenDigital::UILoading
             return BinaryAssetUtilities::BinaryAssetLoader::getStringFromAsset (filename);
         }
 
+        [[nodiscard]] juce::String getAssetSourceIdentifier() const override { return assetSourceIdentifier; }
+
+        [[nodiscard]] juce::int64 getCacheKey (const juce::String& filename) const override { return getResourceName (filename).hashCode64(); }
+
     private:
+        /** A fingerprint of the resource table, so loaders of the same BinaryData share warm plans. */
+        juce::String assetSourceIdentifier;
+
+        /**
+         * @brief Loads a resource, reporting it under filename.
+         *
+         * Load reports and prefetch manifests need the name it was requested by: a manifest
+         * is replayed through loadImageByFilename(), which expects the original filename.
+         */
+        [[nodiscard]] juce::Image loadResource (const juce::String& resourceName, const juce::String& filename) const;
+
         /**
          * @brief Core implementation that loads images from an array of filenames.
          *
@@ -0,0 +1,268 @@
+namespace BogrenDigital::UILoading
+{
+    namespace
+    {
+        // Each run is a varint of (length << 2 | kind), followed by one pixel for fills and
+        // length pixels for literals
+        enum RunKind : juce::uint32
+        {
+            unchangedRun = 0,
+            fillRun = 1,
+            literalRun = 2
+        };
+
+        constexpr size_t minimumFillRun = 3;
+
+        void writeRun (std::vector<juce::uint8>& data, RunKind kind, size_t length)
+        {
+            auto value = (juce::uint64) length << 2 | kind;
+
+            while (value >= 0x80)
+            {
+                data.push_back ((juce::uint8) (value | 0x80));
+                value >>= 7;
+            }
+
+            data.push_back ((juce::uint8) value);
+        }
+
+        void writePixels (std::vector<juce::uint8>& data, const juce::uint32* pixels, size_t numPixels)
+        {
+            const auto* bytes = reinterpret_cast<const juce::uint8*> (pixels);
+            data.insert (data.end(), bytes, bytes + numPixels * sizeof (juce::uint32));
+        }
+
+        void readPixels (const juce::Image& frame, std::vector<juce::uint32>& pixels)
+        {
+            const auto argb = frame.getFormat() == juce::Image::ARGB ? frame : frame.convertedToFormat (juce::Image::ARGB);
+            const juce::Image::BitmapData bitmap (argb, juce::Image::BitmapData::readOnly);
+
+            for (int y = 0; y < bitmap.height; ++y)
+                std::memcpy (pixels.data() + (size_t) y * (size_t) bitmap.width, bitmap.getLinePointer (y), (size_t) bitmap.width * sizeof (juce::uint32));
+        }
+
+        void encodeFrame (const std::vector<juce::uint32>& current, const std::vector<juce::uint32>& reference, std::vector<juce::uint8>& data)
+        {
+            const auto numPixels = current.size();
+
+            const auto startsFillRun = [&] (size_t position) {
+                return position + minimumFillRun <= numPixels
+                       && current[position] == current[position + 1] && current[position] == current[position + 2];
+            };
+
+            size_t position = 0;
+
+            while (position < numPixels)
+            {
+                auto end = position;
+
+                while (end < numPixels && current[end] == reference[end])
+                    ++end;
+
+                // Pixels after the last run stay as they are
+                if (end == numPixels)
+                    break;
+
+                if (end > position)
+                    writeRun (data, unchangedRun, end - position);
+
+                position = end;
+
+                while (end < numPixels && current[end] == current[position])
+                    ++end;
+
+                if (end - position >= minimumFillRun)
+                {
+                    writeRun (data, fillRun, end - position);
+                    writePixels (data, &current[position], 1);
+                    position = end;
+                    continue;
+                }
+
+                end = position + 1;
+
+                while (end < numPixels && current[end] != reference[end] && ! startsFillRun (end))
+                    ++end;
+
+                writeRun (data, literalRun, end - position);
+                writePixels (data, &current[position], end - position);
+                position = end;
+            }
+        }
+
+        void copyPixels (const juce::Image& source, const juce::Image::BitmapData& destination)
+        {
+            const juce::Image::BitmapData bitmap (source, juce::Image::BitmapData::readOnly);
+
+            for (int y = 0; y < destination.height; ++y)
+                std::memcpy (destination.getLinePointer (y), bitmap.getLinePointer (y), (size_t) destination.width * sizeof (juce::uint32));
+        }
+
+        void clearPixels (const juce::Image::BitmapData& destination)
+        {
+            for (int y = 0; y < destination.height; ++y)
+                std::memset (destination.getLinePointer (y), 0, (size_t) destination.width * sizeof (juce::uint32));
+        }
+    }
+
+    std::shared_ptr<const CompressedFilmstrip> CompressedFilmstrip::create (const juce::Array<juce::Image>& frames)
+    {
+        if (frames.isEmpty() || ! frames.getFirst().isValid())
+            return nullptr;
+
+        std::shared_ptr<CompressedFilmstrip> filmstrip (new CompressedFilmstrip());
+        filmstrip->width = frames.getFirst().getWidth();
+        filmstrip->height = frames.getFirst().getHeight();
+
+        const auto numPixels = (size_t) filmstrip->width * (size_t) filmstrip->height;
+        std::vector<juce::uint32> previous (numPixels), current (numPixels);
+
+        for (int i = 0; i < frames.size(); ++i)
+        {
+            const auto& frame = frames.getReference (i);
+
+            if (! frame.isValid() || frame.getWidth() != filmstrip->width || frame.getHeight() != filmstrip->height)
+                return nullptr;
+
+            // Keyframes are encoded against a transparent frame, bounding the deltas a random access decodes
+            if (i % keyframeInterval == 0)
+                std::fill (previous.begin(), previous.end(), 0);
+
+            readPixels (frame, current);
+            filmstrip->frameOffsets.push_back (filmstrip->data.size());
+            encodeFrame (current, previous, filmstrip->data);
+            std::swap (previous, current);
+        }
+
+        filmstrip->frameOffsets.push_back (filmstrip->data.size());
+        filmstrip->data.shrink_to_fit();
+        return filmstrip;
+    }
+
+    void CompressedFilmstrip::applyFrame (int index, const juce::Image::BitmapData& bitmap) const
+    {
+        const auto* position = data.data() + frameOffsets[(size_t) index];
+        const auto* end = data.data() + frameOffsets[(size_t) index + 1];
+        int x = 0, y = 0;
+
+        while (position < end)
+        {
+            juce::uint64 value = 0;
+
+            for (int shift = 0;; shift += 7)
+            {
+                const auto byte = *position++;
+                value |= (juce::uint64) (byte & 0x7f) << shift;
+
+                if ((byte & 0x80) == 0)
+                    break;
+            }
+
+            const auto kind = (RunKind) (value & 3);
+            auto length = (size_t) (value >> 2);
+
+            juce::uint32 fillPixel = 0;
+
+            if (kind == fillRun)
+            {
+                std::memcpy (&fillPixel, position, sizeof (fillPixel));
+                position += sizeof (fillPixel);
+            }
+
+            // Runs continue across rows
+            while (length > 0)
+            {
+                jassert (y < bitmap.height);
+
+                const auto count = std::min (length, (size_t) (bitmap.width - x));
+                auto* line = reinterpret_cast<juce::uint32*> (bitmap.getLinePointer (y)) + x;
+
+                if (kind == fillRun)
+                {
+                    std::fill (line, line + count, fillPixel);
+                }
+                else if (kind == literalRun)
+                {
+                    std::memcpy (line, position, count * sizeof (juce::uint32));
+                    position += count * sizeof (juce::uint32);
+                }
+
+                length -= count;
+                x += (int) count;
+
+                if (x == bitmap.width)
+                {
+                    x = 0;
+                    ++y;
+                }
+            }
+        }
+    }
+
+    CompressedFilmstrip::FrameCache::FrameCache (std::shared_ptr<const CompressedFilmstrip> filmstripToUse, int maxFramesToKeep)
+        : filmstrip (std::move (filmstripToUse)), maxFrames (std::max (1, maxFramesToKeep))
+    {
+        jassert (filmstrip != nullptr);
+    }
+
+    juce::Image CompressedFilmstrip::FrameCache::getFrame (int index)
+    {
+        if (! juce::isPositiveAndBelow (index, filmstrip->size()))
+            return {};
+
+        const auto moveToFront = [this] (size_t position) {
+            std::rotate (entries.begin(), entries.begin() + (std::ptrdiff_t) position, entries.begin() + (std::ptrdiff_t) position + 1);
+            return entries.front().image;
+        };
+
+        // The closest earlier frame since the keyframe saves decoding the deltas before it
+        const auto keyframe = getKeyframe (index);
+        std::optional<size_t> reference;
+
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            if (entries[i].index == index)
+                return moveToFront (i);
+
+            if (entries[i].index >= keyframe && entries[i].index < index && (! reference || entries[i].index > entries[*reference].index))
+                reference = i;
+        }
+
+        if ((int) entries.size() < maxFrames)
+            entries.push_back ({ -1, juce::Image (juce::Image::ARGB, filmstrip->getWidth(), filmstrip->getHeight(), true) });
+
+        // Reuses the least recently used frame's pixels, decoding in place if it is the reference
+        const auto target = entries.size() - 1;
+        auto firstFrame = keyframe;
+
+        {
+            const juce::Image::BitmapData bitmap (entries[target].image, juce::Image::BitmapData::readWrite);
+
+            if (reference)
+            {
+                if (*reference != target)
+                    copyPixels (entries[*reference].image, bitmap);
+
+                firstFrame = entries[*reference].index + 1;
+            }
+            else if (entries[target].index >= 0)
+            {
+                clearPixels (bitmap);
+            }
+
+            for (auto frame = firstFrame; frame <= index; ++frame)
+                filmstrip->applyFrame (frame, bitmap);
+        }
+
+        entries[target].index = index;
+        return moveToFront (target);
+    }
+
+    void CompressedFilmstrip::FrameCache::getImagesForMemoryReport (MemoryReport::ComponentImages& report) const
+    {
+        for (const auto& entry : entries)
+            report.caches.add (entry.image);
+
+        report.compressedBytes += filmstrip->getCompressedBytes();
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+
+namespace BogrenDigital::UILoading
+{
+    /**
+     * @brief Filmstrip frames kept run-length encoded in memory instead of as decoded images.
+     *
+     * Every frame is stored as runs of unchanged, repeated and literal pixels against the
+     * previous frame, or against a transparent frame for every keyframeInterval-th frame.
+     * Transparent surroundings and the parts of a knob that don't move between adjacent
+     * frames therefore take almost no space.
+     *
+     * The encoded data is immutable and can be shared between components and threads.
+     * Frames are decoded through a FrameCache, which keeps the most recently used ones.
+     */
+    class CompressedFilmstrip
+    {
+    public:
+        static constexpr int keyframeInterval = 16;
+
+        /** @brief Encodes the frames; returns nullptr if there are none or their sizes differ. */
+        static std::shared_ptr<const CompressedFilmstrip> create (const juce::Array<juce::Image>& frames);
+
+        int size() const { return (int) frameOffsets.size() - 1; }
+        int getWidth() const { return width; }
+        int getHeight() const { return height; }
+
+        /** @brief The encoded size of all frames. */
+        size_t getCompressedBytes() const { return data.size(); }
+
+        /** @brief The size the frames would take as decoded ARGB images. */
+        size_t getDecodedBytes() const { return (size_t) width * (size_t) height * 4 * (size_t) size(); }
+
+        /**
+         * @brief Decodes frames on demand, keeping the most recently used ones.
+         *
+         * Moving to an adjacent frame decodes a single delta from the cached one. Not
+         * thread-safe; use one cache per component and call it from the message thread.
+         */
+        class FrameCache
+        {
+        public:
+            FrameCache (std::shared_ptr<const CompressedFilmstrip> filmstripToUse, int maxFramesToKeep = 3);
+
+            int size() const { return filmstrip->size(); }
+
+            const CompressedFilmstrip& getFilmstrip() const { return *filmstrip; }
+
+            /** @brief The decoded frame; its pixels are reused by later calls, so draw it right away. */
+            juce::Image getFrame (int index);
+
+            /** @brief Adds the cached frames as caches and the encoded data as compressed bytes. */
+            void getImagesForMemoryReport (MemoryReport::ComponentImages& report) const;
+
+        private:
+            struct Entry
+            {
+                int index = -1;
+                juce::Image image;
+            };
+
+            std::shared_ptr<const CompressedFilmstrip> filmstrip;
+            std::vector<Entry> entries; // Most recently used first
+            int maxFrames;
+
+            JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FrameCache)
+        };
+
+    private:
+        CompressedFilmstrip() = default;
+
+        static int getKeyframe (int index) { return index - index % keyframeInterval; }
+
+        /** Applies the runs of one frame to a bitmap holding the frame before it (or a cleared one for keyframes). */
+        void applyFrame (int index, const juce::Image::BitmapData& bitmap) const;
+
+        int width = 0;
+        int height = 0;
+        std::vector<juce::uint8> data;
+        std::vector<size_t> frameOffsets; // One more than there are frames
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CompressedFilmstrip)
+    };
+}
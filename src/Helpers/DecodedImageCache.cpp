@@ -0,0 +1,307 @@
+namespace BogrenDigital::UILoading
+{
+    juce::Image DecodedImageCache::getOrDecode (juce::int64 key, const std::function<juce::Image()>& decode)
+    {
+        if (auto cachedImage = find (key); cachedImage.isValid())
+        {
+            ++hits;
+            return cachedImage;
+        }
+
+        std::promise<juce::Image> decoded;
+
+        {
+            std::unique_lock lock (inFlightMutex);
+
+            // Wait for a decode of the same key that is already running instead of repeating it
+            if (const auto it = inFlightDecodes.find (key); it != inFlightDecodes.end())
+            {
+                const auto pending = it->second;
+                lock.unlock();
+                ++hits;
+                return pending.get();
+            }
+
+            // It may have been stored between the lookup above and taking the lock
+            if (auto cachedImage = find (key); cachedImage.isValid())
+            {
+                ++hits;
+                return cachedImage;
+            }
+
+            inFlightDecodes.emplace (key, decoded.get_future().share());
+        }
+
+        ++misses;
+
+        const auto finishDecode = [this, key] {
+            const std::scoped_lock lock (inFlightMutex);
+            inFlightDecodes.erase (key);
+        };
+
+        juce::Image image;
+
+        try
+        {
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+            image = decode();
+            decodeTicks += juce::Time::getHighResolutionTicks() - startTicks;
+
+            if (image.isValid())
+                store (key, image);
+        }
+        catch (...)
+        {
+            // Callers waiting for this decode get the exception too, and the next request decodes again
+            finishDecode();
+            decoded.set_exception (std::current_exception());
+            throw;
+        }
+
+        finishDecode();
+        decoded.set_value (image);
+        return image;
+    }
+
+    DecodedImageCache::Statistics DecodedImageCache::getStatistics() const
+    {
+        Statistics statistics;
+        statistics.hits = hits.load();
+        statistics.misses = misses.load();
+        statistics.decodeMilliseconds = juce::Time::highResolutionTicksToSeconds (decodeTicks.load()) * 1000.0;
+        fillContentStatistics (statistics);
+        return statistics;
+    }
+
+    void DecodedImageCache::resetStatistics()
+    {
+        hits = 0;
+        misses = 0;
+        decodeTicks = 0;
+    }
+
+    size_t DecodedImageCache::getImageSizeInBytes (const juce::Image& image)
+    {
+        if (! image.isValid())
+            return 0;
+
+        const auto bytesPerPixel = [&image]() -> size_t {
+            switch (image.getFormat())
+            {
+                case juce::Image::SingleChannel:
+                    return 1;
+                case juce::Image::RGB:
+                    return 3;
+                case juce::Image::ARGB:
+                case juce::Image::UnknownFormat:
+                default:
+                    return 4;
+            }
+        }();
+
+        return static_cast<size_t> (image.getWidth()) * static_cast<size_t> (image.getHeight()) * bytesPerPixel;
+    }
+
+    bool DecodedImageCache::contains (juce::int64) const
+    {
+        return false;
+    }
+
+    //==============================================================================
+    juce::Image GlobalImageCache::find (juce::int64 key)
+    {
+        return juce::ImageCache::getFromHashCode (getImageCacheKey (key));
+    }
+
+    void GlobalImageCache::store (juce::int64 key, const juce::Image& image)
+    {
+        const auto imageCacheKey = getImageCacheKey (key);
+        juce::ImageCache::addImageToCache (image, imageCacheKey);
+
+        const std::scoped_lock lock (mutex);
+        storedKeys.insert (imageCacheKey);
+
+        // Sweeping costs a lookup per key, so only do it once the set has doubled since the last sweep
+        if (storedKeys.size() >= numKeysToForgetExpired)
+        {
+            forgetExpiredKeysLocked();
+            numKeysToForgetExpired = juce::jmax ((size_t) 64, storedKeys.size() * 2);
+        }
+    }
+
+    bool GlobalImageCache::contains (juce::int64 key) const
+    {
+        return juce::ImageCache::getFromHashCode (getImageCacheKey (key)).isValid();
+    }
+
+    void GlobalImageCache::purge()
+    {
+        juce::ImageCache::releaseUnusedImages();
+
+        const std::scoped_lock lock (mutex);
+        forgetExpiredKeysLocked();
+    }
+
+    void GlobalImageCache::remove (juce::int64 key)
+    {
+        const std::scoped_lock lock (mutex);
+
+        const auto previousKey = replacedKeys.contains (key) ? replacedKeys[key] : key;
+        storedKeys.erase (previousKey);
+        replacedKeys[key] = (juce::String (key) + "#" + juce::String (++numRemovals)).hashCode64();
+    }
+
+    void GlobalImageCache::forgetExpiredKeysLocked() const
+    {
+        for (auto it = storedKeys.begin(); it != storedKeys.end();)
+        {
+            if (juce::ImageCache::getFromHashCode (*it).isValid())
+            {
+                ++it;
+            }
+            else
+            {
+                it = storedKeys.erase (it);
+                ++evictions;
+            }
+        }
+    }
+
+    juce::int64 GlobalImageCache::getImageCacheKey (juce::int64 key) const
+    {
+        const std::scoped_lock lock (mutex);
+
+        const auto it = replacedKeys.find (key);
+        return it != replacedKeys.end() ? it->second : key;
+    }
+
+    void GlobalImageCache::fillContentStatistics (Statistics& statistics) const
+    {
+        const std::scoped_lock lock (mutex);
+
+        // juce::ImageCache times images out on its own, so only count what is still in there
+        forgetExpiredKeysLocked();
+
+        for (const auto key : storedKeys)
+        {
+            if (const auto image = juce::ImageCache::getFromHashCode (key); image.isValid())
+            {
+                ++statistics.cachedImages;
+                statistics.cachedBytes += getImageSizeInBytes (image);
+            }
+        }
+
+        statistics.evictions = evictions;
+    }
+
+    //==============================================================================
+    LruImageCache::LruImageCache (size_t byteBudgetToUse)
+        : byteBudget (byteBudgetToUse)
+    {
+    }
+
+    void LruImageCache::setByteBudget (size_t newByteBudget)
+    {
+        const std::scoped_lock lock (mutex);
+        byteBudget = newByteBudget;
+        trimToBudgetLocked();
+    }
+
+    size_t LruImageCache::getByteBudget() const
+    {
+        const std::scoped_lock lock (mutex);
+        return byteBudget;
+    }
+
+    void LruImageCache::trimToBudget()
+    {
+        const std::scoped_lock lock (mutex);
+        trimToBudgetLocked();
+    }
+
+    bool LruImageCache::contains (juce::int64 key) const
+    {
+        const std::scoped_lock lock (mutex);
+        return entriesByKey.contains (key);
+    }
+
+    void LruImageCache::purge()
+    {
+        const std::scoped_lock lock (mutex);
+        evictions += entries.size();
+        entries.clear();
+        entriesByKey.clear();
+        cachedBytes = 0;
+    }
+
+    void LruImageCache::remove (juce::int64 key)
+    {
+        const std::scoped_lock lock (mutex);
+
+        const auto it = entriesByKey.find (key);
+
+        if (it == entriesByKey.end())
+            return;
+
+        cachedBytes -= it->second->bytes;
+        entries.erase (it->second);
+        entriesByKey.erase (it);
+    }
+
+    juce::Image LruImageCache::find (juce::int64 key)
+    {
+        const std::scoped_lock lock (mutex);
+
+        const auto it = entriesByKey.find (key);
+
+        if (it == entriesByKey.end())
+            return {};
+
+        entries.splice (entries.begin(), entries, it->second);
+        return it->second->image;
+    }
+
+    void LruImageCache::store (juce::int64 key, const juce::Image& image)
+    {
+        const std::scoped_lock lock (mutex);
+
+        // Another thread may have decoded the same key concurrently; keep the first one
+        if (entriesByKey.contains (key))
+            return;
+
+        const auto bytes = getImageSizeInBytes (image);
+        entries.push_front ({ key, image, bytes });
+        entriesByKey[key] = entries.begin();
+        cachedBytes += bytes;
+
+        trimToBudgetLocked();
+    }
+
+    void LruImageCache::trimToBudgetLocked()
+    {
+        if (byteBudget == 0)
+            return;
+
+        for (auto it = entries.end(); cachedBytes > byteBudget && it != entries.begin();)
+        {
+            --it;
+
+            // Only the cache itself still holds this image, so dropping it actually frees memory
+            if (it->image.getReferenceCount() <= 1)
+            {
+                cachedBytes -= it->bytes;
+                entriesByKey.erase (it->key);
+                it = entries.erase (it);
+                ++evictions;
+            }
+        }
+    }
+
+    void LruImageCache::fillContentStatistics (Statistics& statistics) const
+    {
+        const std::scoped_lock lock (mutex);
+        statistics.cachedImages = entries.size();
+        statistics.cachedBytes = cachedBytes;
+        statistics.evictions = evictions;
+    }
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace BogrenDigital::UILoading
+{
+    /**
+     * @brief Pluggable store for the decoded images an ImageLoader hands out.
+     *
+     * Loaders funnel every decode through getOrDecode(), which keeps hit/miss
+     * and decode-time counters regardless of where the images are stored.
+     * Implementations only decide how images are kept and when they go away.
+     * All methods are thread-safe: loaders call them from their decode pools.
+     */
+    class DecodedImageCache
+    {
+    public:
+        struct Statistics
+        {
+            juce::uint64 hits = 0;
+            juce::uint64 misses = 0;
+            juce::uint64 evictions = 0;
+            size_t cachedImages = 0;
+            size_t cachedBytes = 0;
+            double decodeMilliseconds = 0.0;
+        };
+
+        virtual ~DecodedImageCache() = default;
+
+        /**
+         * @brief Returns the image cached under key, decoding and storing it on a miss.
+         *
+         * Invalid results (missing or undecodable assets) are returned but never stored.
+         * Concurrent misses on the same key decode once; the other callers wait for that
+         * result and count as hits.
+         */
+        juce::Image getOrDecode (juce::int64 key, const std::function<juce::Image()>& decode);
+
+        /**
+         * @brief True if an image is cached under key, without counting a hit or touching its recency.
+         *
+         * Lets loaders skip fetching the bytes of cached assets ahead of time. The default
+         * implementation returns false, which only costs such loaders some needless fetches.
+         */
+        [[nodiscard]] virtual bool contains (juce::int64 key) const;
+
+        /** @brief Drops every cached image. Images still referenced elsewhere stay alive with their owners. */
+        virtual void purge() = 0;
+
+        /** @brief Forgets the image cached under key, e.g. because its asset changed on disk. */
+        virtual void remove (juce::int64 key) = 0;
+
+        /** @brief Returns a snapshot of the counters and the current cache contents. */
+        Statistics getStatistics() const;
+
+        void resetStatistics();
+
+        /** @brief Approximate number of bytes an image's pixels occupy in memory. */
+        static size_t getImageSizeInBytes (const juce::Image& image);
+
+    protected:
+        [[nodiscard]] virtual juce::Image find (juce::int64 key) = 0;
+        virtual void store (juce::int64 key, const juce::Image& image) = 0;
+
+        /** @brief Fills in cachedImages, cachedBytes and evictions. */
+        virtual void fillContentStatistics (Statistics& statistics) const = 0;
+
+    private:
+        std::atomic<juce::uint64> hits { 0 };
+        std::atomic<juce::uint64> misses { 0 };
+        std::atomic<juce::int64> decodeTicks { 0 };
+
+        std::mutex inFlightMutex;
+        std::unordered_map<juce::int64, std::shared_future<juce::Image>> inFlightDecodes;
+    };
+
+    /**
+     * @brief Stores images in the process-global juce::ImageCache.
+     *
+     * Keeps the historical behaviour: images are shared by key with every other
+     * user of juce::ImageCache in the process and released by its own timeout.
+     * Keys whose images have timed out are forgotten as more are stored, and
+     * counted as evictions.
+     */
+    class GlobalImageCache : public DecodedImageCache
+    {
+    public:
+        /** @brief Releases the unused images of the whole process-global juce::ImageCache. */
+        [[nodiscard]] bool contains (juce::int64 key) const override;
+        void purge() override;
+
+        /**
+         * @brief Stops handing out the image cached under key.
+         *
+         * juce::ImageCache can't remove single images, so later lookups of this key
+         * use a fresh hash code and the old image times out on its own.
+         */
+        void remove (juce::int64 key) override;
+
+    protected:
+        [[nodiscard]] juce::Image find (juce::int64 key) override;
+        void store (juce::int64 key, const juce::Image& image) override;
+        void fillContentStatistics (Statistics& statistics) const override;
+
+    private:
+        juce::int64 getImageCacheKey (juce::int64 key) const;
+        void forgetExpiredKeysLocked() const;
+
+        mutable std::mutex mutex;
+        mutable std::unordered_set<juce::int64> storedKeys;
+        mutable size_t numKeysToForgetExpired = 64;
+        mutable juce::uint64 evictions = 0;
+        std::unordered_map<juce::int64, juce::int64> replacedKeys;
+        juce::int64 numRemovals = 0;
+    };
+
+    /**
+     * @brief Per-loader cache with a byte budget and least-recently-used eviction.
+     *
+     * When the budget is exceeded, the least recently used images that nothing
+     * outside the cache references any more are dropped. Images still held by
+     * components are never evicted, so the budget can be exceeded temporarily
+     * while they are alive. A budget of 0 means unlimited.
+     */
+    class LruImageCache : public DecodedImageCache
+    {
+    public:
+        /** @brief The budget of the cache every ImageLoader starts with, so long-running hosts don't keep every asset ever decoded. */
+        static constexpr size_t defaultByteBudget = 64 * 1024 * 1024;
+
+        explicit LruImageCache (size_t byteBudgetToUse = 0);
+
+        void setByteBudget (size_t newByteBudget);
+        size_t getByteBudget() const;
+
+        /** @brief Drops unreferenced images until the cache fits its budget again. */
+        void trimToBudget();
+
+        [[nodiscard]] bool contains (juce::int64 key) const override;
+        void purge() override;
+        void remove (juce::int64 key) override;
+
+    protected:
+        [[nodiscard]] juce::Image find (juce::int64 key) override;
+        void store (juce::int64 key, const juce::Image& image) override;
+        void fillContentStatistics (Statistics& statistics) const override;
+
+    private:
+        struct Entry
+        {
+            juce::int64 key;
+            juce::Image image;
+            size_t bytes;
+        };
+
+        void trimToBudgetLocked();
+
+        mutable std::mutex mutex;
+        std::list<Entry> entries; // Most recently used first
+        std::unordered_map<juce::int64, std::list<Entry>::iterator> entriesByKey;
+        size_t byteBudget = 0;
+        size_t cachedBytes = 0;
+        juce::uint64 evictions = 0;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LruImageCache)
+    };
+}
@@ -0,0 +1,373 @@
+#if JUCE_INTEL && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define BD_UI_LOADER_PNG_SSE2 1
+#else
+    #define BD_UI_LOADER_PNG_SSE2 0
+#endif
+
+namespace BogrenDigital::UILoading
+{
+    namespace
+    {
+        constexpr juce::uint8 pngSignature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+
+        enum PngFilter : juce::uint8
+        {
+            pngFilterNone,
+            pngFilterSub,
+            pngFilterUp,
+            pngFilterAverage,
+            pngFilterPaeth
+        };
+
+        inline int paethPredictor (int a, int b, int c) noexcept
+        {
+            const auto pa = std::abs (b - c);
+            const auto pb = std::abs (a - c);
+            const auto pc = std::abs (a + b - 2 * c);
+
+            if (pa <= pb && pa <= pc)
+                return a;
+
+            return pb <= pc ? b : c;
+        }
+
+       #if BD_UI_LOADER_PNG_SSE2
+        inline __m128i loadPixel (const juce::uint8* pixel) noexcept
+        {
+            int value;
+            std::memcpy (&value, pixel, sizeof (value));
+            return _mm_unpacklo_epi8 (_mm_cvtsi32_si128 (value), _mm_setzero_si128());
+        }
+
+        inline void storePixel (juce::uint8* pixel, __m128i value) noexcept
+        {
+            const auto packed = _mm_cvtsi128_si32 (_mm_packus_epi16 (_mm_and_si128 (value, _mm_set1_epi16 (0xff)), _mm_setzero_si128()));
+            std::memcpy (pixel, &packed, sizeof (packed));
+        }
+
+        inline __m128i absolute (__m128i value) noexcept
+        {
+            return _mm_max_epi16 (value, _mm_sub_epi16 (_mm_setzero_si128(), value));
+        }
+
+        inline __m128i select (__m128i condition, __m128i whenTrue, __m128i whenFalse) noexcept
+        {
+            return _mm_or_si128 (_mm_and_si128 (condition, whenTrue), _mm_andnot_si128 (condition, whenFalse));
+        }
+
+        // Each 4-byte pixel depends on the one before, so the four channels are processed together
+        void unfilterAverage4 (juce::uint8* row, const juce::uint8* previousRow, size_t rowBytes) noexcept
+        {
+            auto left = _mm_setzero_si128();
+
+            for (size_t i = 0; i < rowBytes; i += 4)
+            {
+                const auto above = loadPixel (previousRow + i);
+                left = _mm_add_epi16 (loadPixel (row + i), _mm_srli_epi16 (_mm_add_epi16 (left, above), 1));
+                storePixel (row + i, left);
+                left = _mm_and_si128 (left, _mm_set1_epi16 (0xff));
+            }
+        }
+
+        void unfilterPaeth4 (juce::uint8* row, const juce::uint8* previousRow, size_t rowBytes) noexcept
+        {
+            auto left = _mm_setzero_si128();
+            auto aboveLeft = _mm_setzero_si128();
+
+            for (size_t i = 0; i < rowBytes; i += 4)
+            {
+                const auto above = loadPixel (previousRow + i);
+
+                const auto pa = absolute (_mm_sub_epi16 (above, aboveLeft));
+                const auto pb = absolute (_mm_sub_epi16 (left, aboveLeft));
+                const auto pc = absolute (_mm_add_epi16 (_mm_sub_epi16 (above, aboveLeft), _mm_sub_epi16 (left, aboveLeft)));
+                const auto smallest = _mm_min_epi16 (pc, _mm_min_epi16 (pa, pb));
+
+                const auto predictor = select (_mm_cmpeq_epi16 (pa, smallest), left, select (_mm_cmpeq_epi16 (pb, smallest), above, aboveLeft));
+
+                left = _mm_and_si128 (_mm_add_epi16 (loadPixel (row + i), predictor), _mm_set1_epi16 (0xff));
+                storePixel (row + i, left);
+                aboveLeft = above;
+            }
+        }
+       #endif
+
+        /** Reverses a row's filter in place; previousRow is all zeros for the first row. */
+        bool unfilterRow (juce::uint8 filter, juce::uint8* row, const juce::uint8* previousRow, size_t rowBytes, size_t bytesPerPixel) noexcept
+        {
+            switch (filter)
+            {
+                case pngFilterNone:
+                    return true;
+
+                case pngFilterSub:
+                    for (size_t i = bytesPerPixel; i < rowBytes; ++i)
+                        row[i] = (juce::uint8) (row[i] + row[i - bytesPerPixel]);
+
+                    return true;
+
+                case pngFilterUp:
+                    // Independent bytes: compilers vectorise this loop
+                    for (size_t i = 0; i < rowBytes; ++i)
+                        row[i] = (juce::uint8) (row[i] + previousRow[i]);
+
+                    return true;
+
+                case pngFilterAverage:
+                   #if BD_UI_LOADER_PNG_SSE2
+                    if (bytesPerPixel == 4)
+                    {
+                        unfilterAverage4 (row, previousRow, rowBytes);
+                        return true;
+                    }
+                   #endif
+
+                    for (size_t i = 0; i < bytesPerPixel; ++i)
+                        row[i] = (juce::uint8) (row[i] + (previousRow[i] >> 1));
+
+                    for (size_t i = bytesPerPixel; i < rowBytes; ++i)
+                        row[i] = (juce::uint8) (row[i] + ((row[i - bytesPerPixel] + previousRow[i]) >> 1));
+
+                    return true;
+
+                case pngFilterPaeth:
+                   #if BD_UI_LOADER_PNG_SSE2
+                    if (bytesPerPixel == 4)
+                    {
+                        unfilterPaeth4 (row, previousRow, rowBytes);
+                        return true;
+                    }
+                   #endif
+
+                    for (size_t i = 0; i < bytesPerPixel; ++i)
+                        row[i] = (juce::uint8) (row[i] + previousRow[i]);
+
+                    for (size_t i = bytesPerPixel; i < rowBytes; ++i)
+                        row[i] = (juce::uint8) (row[i] + paethPredictor (row[i - bytesPerPixel], previousRow[i], previousRow[i - bytesPerPixel]));
+
+                    return true;
+
+                default:
+                    return false;
+            }
+        }
+
+        struct PngHeader
+        {
+            juce::uint32 width = 0, height = 0;
+            juce::uint8 bitDepth = 0, colourType = 0, interlace = 0;
+        };
+
+        enum PngColourType : juce::uint8
+        {
+            pngGreyscale = 0,
+            pngRgb = 2,
+            pngPalette = 3,
+            pngGreyscaleAlpha = 4,
+            pngRgba = 6
+        };
+
+        size_t getNumChannels (juce::uint8 colourType) noexcept
+        {
+            switch (colourType)
+            {
+                case pngGreyscale:      return 1;
+                case pngRgb:            return 3;
+                case pngPalette:        return 1;
+                case pngGreyscaleAlpha: return 2;
+                case pngRgba:           return 4;
+                default:                return 0;
+            }
+        }
+    }
+
+    bool FastPngDecoder::isPng (const void* data, size_t numBytes) noexcept
+    {
+        return numBytes >= sizeof (pngSignature) && std::memcmp (data, pngSignature, sizeof (pngSignature)) == 0;
+    }
+
+    juce::Image FastPngDecoder::decode (const void* data, size_t numBytes)
+    {
+        if (! isPng (data, numBytes))
+            return {};
+
+        const auto* bytes = static_cast<const juce::uint8*> (data);
+
+        PngHeader header;
+        juce::MemoryBlock compressed;
+        juce::uint8 palette[256][4] {}; // RGBA
+        size_t numPaletteEntries = 0;
+        bool hasTransparencyChunk = false;
+        bool hasHeader = false;
+
+        for (size_t position = sizeof (pngSignature); position + 12 <= numBytes;)
+        {
+            const auto length = (size_t) juce::ByteOrder::bigEndianInt (bytes + position);
+            const auto* type = bytes + position + 4;
+            const auto* chunk = bytes + position + 8;
+
+            if (length > numBytes - position - 12)
+                return {};
+
+            if (std::memcmp (type, "IHDR", 4) == 0 && length >= 13)
+            {
+                header.width = juce::ByteOrder::bigEndianInt (chunk);
+                header.height = juce::ByteOrder::bigEndianInt (chunk + 4);
+                header.bitDepth = chunk[8];
+                header.colourType = chunk[9];
+                header.interlace = chunk[12];
+                hasHeader = chunk[10] == 0 && chunk[11] == 0; // Deflate, adaptive filtering
+            }
+            else if (std::memcmp (type, "PLTE", 4) == 0)
+            {
+                numPaletteEntries = juce::jmin ((size_t) 256, length / 3);
+
+                for (size_t i = 0; i < numPaletteEntries; ++i)
+                {
+                    palette[i][0] = chunk[i * 3];
+                    palette[i][1] = chunk[i * 3 + 1];
+                    palette[i][2] = chunk[i * 3 + 2];
+                    palette[i][3] = 255;
+                }
+            }
+            else if (std::memcmp (type, "tRNS", 4) == 0)
+            {
+                // Colour-keyed transparency of non-palette images is left to JUCE
+                if (header.colourType != pngPalette)
+                    return {};
+
+                hasTransparencyChunk = true;
+
+                for (size_t i = 0; i < juce::jmin ((size_t) 256, length); ++i)
+                    palette[i][3] = chunk[i];
+            }
+            else if (std::memcmp (type, "IDAT", 4) == 0)
+            {
+                compressed.append (chunk, length);
+            }
+            else if (std::memcmp (type, "IEND", 4) == 0)
+            {
+                break;
+            }
+
+            position += length + 12;
+        }
+
+        const auto numChannels = getNumChannels (header.colourType);
+
+        if (! hasHeader || header.bitDepth != 8 || header.interlace != 0 || numChannels == 0 || compressed.isEmpty()
+            || header.width == 0 || header.height == 0 || header.width > 0x10000 || header.height > 0x10000
+            || (header.colourType == pngPalette && numPaletteEntries == 0))
+            return {};
+
+        const auto width = (int) header.width;
+        const auto height = (int) header.height;
+        const auto rowBytes = (size_t) width * numChannels;
+        const auto rawSize = (rowBytes + 1) * (size_t) height;
+
+        juce::HeapBlock<juce::uint8> raw (rawSize);
+
+        {
+            juce::MemoryInputStream compressedStream (compressed, false);
+            juce::GZIPDecompressorInputStream inflater (&compressedStream, false, juce::GZIPDecompressorInputStream::zlibFormat, (juce::int64) rawSize);
+
+            for (size_t numRead = 0; numRead < rawSize;)
+            {
+                const auto numBytesRead = inflater.read (raw + numRead, (int) juce::jmin (rawSize - numRead, (size_t) 1 << 30));
+
+                if (numBytesRead <= 0)
+                    return {};
+
+                numRead += (size_t) numBytesRead;
+            }
+        }
+
+        const auto hasAlpha = header.colourType == pngGreyscaleAlpha || header.colourType == pngRgba || hasTransparencyChunk;
+        juce::Image image (hasAlpha ? juce::Image::ARGB : juce::Image::RGB, width, height, false);
+        const juce::Image::BitmapData bitmap (image, juce::Image::BitmapData::writeOnly);
+
+        // Palette entries are converted to the image's pixel layout once
+        juce::PixelARGB paletteARGB[256];
+
+        for (size_t i = 0; i < 256; ++i)
+        {
+            paletteARGB[i].setARGB (palette[i][3], palette[i][0], palette[i][1], palette[i][2]);
+            paletteARGB[i].premultiply();
+        }
+
+        juce::HeapBlock<juce::uint8> zeroRow (rowBytes, true);
+        const juce::uint8* previousRow = zeroRow;
+
+        for (int y = 0; y < height; ++y)
+        {
+            auto* row = raw + (size_t) y * (rowBytes + 1);
+            const auto filter = *row++;
+
+            if (! unfilterRow (filter, row, previousRow, rowBytes, numChannels))
+                return {};
+
+            previousRow = row;
+
+            auto* line = bitmap.getLinePointer (y);
+            const auto stride = bitmap.pixelStride;
+
+            switch (header.colourType)
+            {
+                case pngRgba:
+                    for (int x = 0; x < width; ++x)
+                    {
+                        const auto* source = row + x * 4;
+                        auto* pixel = reinterpret_cast<juce::PixelARGB*> (line + x * stride);
+                        pixel->setARGB (source[3], source[0], source[1], source[2]);
+
+                        if (source[3] != 255)
+                            pixel->premultiply();
+                    }
+
+                    break;
+
+                case pngGreyscaleAlpha:
+                    for (int x = 0; x < width; ++x)
+                    {
+                        const auto* source = row + x * 2;
+                        auto* pixel = reinterpret_cast<juce::PixelARGB*> (line + x * stride);
+                        pixel->setARGB (source[1], source[0], source[0], source[0]);
+
+                        if (source[1] != 255)
+                            pixel->premultiply();
+                    }
+
+                    break;
+
+                case pngRgb:
+                    for (int x = 0; x < width; ++x)
+                        reinterpret_cast<juce::PixelRGB*> (line + x * stride)->setARGB (255, row[x * 3], row[x * 3 + 1], row[x * 3 + 2]);
+
+                    break;
+
+                case pngGreyscale:
+                    for (int x = 0; x < width; ++x)
+                        reinterpret_cast<juce::PixelRGB*> (line + x * stride)->setARGB (255, row[x], row[x], row[x]);
+
+                    break;
+
+                default: // Palette
+                    if (hasAlpha)
+                    {
+                        for (int x = 0; x < width; ++x)
+                            *reinterpret_cast<juce::PixelARGB*> (line + x * stride) = paletteARGB[row[x]];
+                    }
+                    else
+                    {
+                        for (int x = 0; x < width; ++x)
+                            reinterpret_cast<juce::PixelRGB*> (line + x * stride)->setARGB (255, palette[row[x]][0], palette[row[x]][1], palette[row[x]][2]);
+                    }
+
+                    break;
+            }
+        }
+
+        return image;
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+namespace BogrenDigital::UILoading
+{
+    /**
+     * @brief Decodes the PNG variants UI assets use, faster than juce::PNGImageFormat.
+     *
+     * Handles non-interlaced 8-bit greyscale, RGB, palette (with tRNS transparency),
+     * greyscale-alpha and RGBA images. IDAT data is inflated with JUCE's zlib, rows are
+     * unfiltered in place (with SSE2 for 4-byte pixels where available) and written
+     * straight into the premultiplied layout of a juce::Image, without libpng's
+     * intermediate RGBA rows. The result matches juce::PNGImageFormat, including the
+     * choice of ARGB or RGB. Chunk CRCs are not verified.
+     *
+     * Returns an invalid image for anything else, including 16-bit, sub-byte and
+     * interlaced PNGs and malformed data, so callers fall back to JUCE's decoder.
+     */
+    struct FastPngDecoder
+    {
+        /** @brief True if the data starts with the PNG signature. */
+        static bool isPng (const void* data, size_t numBytes) noexcept;
+
+        static juce::Image decode (const void* data, size_t numBytes);
+    };
+}
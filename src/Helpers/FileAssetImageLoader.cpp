@@ -19,17 +19,21 @@ juce::Image FileAssetImageLoader::loadImageByFilename (const juce::String& filen
     if (! file.existsAsFile())
         return {};
 
-    const auto hashCode = file.getFullPathName().hashCode64();
+    return getOrDecodeAsset (filename, getCacheKey (file), [this, &file]() -> juce::Image {
+        // Read the bytes ourselves so identical files at different paths share one decoded copy
+        juce::MemoryBlock encodedData;
 
-    if (auto cachedImage = juce::ImageCache::getFromHashCode (hashCode); cachedImage.isValid())
-        return cachedImage;
+        if (! file.loadFileAsData (encodedData))
+            return {};
 
-    auto image = juce::ImageFileFormat::loadFrom (file);
-
-    if (image.isValid())
-        juce::ImageCache::addImageToCache (image, hashCode);
+        return decodeImage (encodedData.getData(), encodedData.getSize());
+    });
+}
 
-    return image;
+void FileAssetImageLoader::invalidateCachedImage (const juce::String& filename) const
+{
+    if (filename.isNotEmpty())
+        removeCachedAsset (getCacheKey (filename));
 }
 
 juce::String FileAssetImageLoader::getStringFromAsset (const juce::String& filename) const
@@ -32,7 +32,18 @@ namespace BogrenDigital::UILoading
 
         [[nodiscard]] juce::String getStringFromAsset (const juce::String& filename) const override;
 
+        [[nodiscard]] juce::String getAssetSourceIdentifier() const override { return "file:" + assetDirectory.getFullPathName(); }
+
+        [[nodiscard]] const juce::File& getAssetDirectory() const { return assetDirectory; }
+
+        [[nodiscard]] juce::int64 getCacheKey (const juce::String& filename) const override { return getCacheKey (assetDirectory.getChildFile (filename)); }
+
+        /** @brief Drops the decoded copy of a file so the next load reads it from disk again. */
+        void invalidateCachedImage (const juce::String& filename) const;
+
     private:
+        [[nodiscard]] juce::int64 getCacheKey (const juce::File& file) const { return file.getFullPathName().hashCode64(); }
+
         [[nodiscard]] juce::OwnedArray<juce::Image> loadImageSequenceFromFilenames (
             const std::vector<juce::String>& filenames) const;
 
@@ -0,0 +1,96 @@
+#pragma once
+
+namespace BogrenDigital::UILoading
+{
+    /**
+     * @brief Stateless utility for inspecting the alpha channel of decoded images.
+     *
+     * Used at load time to find images that completely cover the area they are
+     * drawn into, so that components underneath them can be culled, and to find
+     * the transparent borders ImageTrimming removes.
+     */
+    class ImageAlphaAnalysis
+    {
+    public:
+        ImageAlphaAnalysis() = delete;
+
+        /**
+         * @brief Returns true if every pixel of the image is fully opaque.
+         *
+         * Images without an alpha channel are opaque by definition; invalid
+         * images never are. Returns as soon as a translucent pixel is found.
+         */
+        static bool isFullyOpaque (const juce::Image& image)
+        {
+            if (! image.isValid())
+                return false;
+
+            if (! image.hasAlphaChannel())
+                return true;
+
+            const juce::Image::BitmapData data (image, juce::Image::BitmapData::readOnly);
+            const auto isARGB = image.getFormat() == juce::Image::ARGB;
+
+            for (int y = 0; y < data.height; ++y)
+            {
+                const auto* pixel = data.getLinePointer (y);
+
+                for (int x = 0; x < data.width; ++x, pixel += data.pixelStride)
+                {
+                    const auto alpha = isARGB ? reinterpret_cast<const juce::PixelARGB*> (pixel)->getAlpha() : *pixel;
+
+                    if (alpha != 0xff)
+                        return false;
+                }
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Returns the smallest rectangle containing every pixel that isn't fully transparent.
+         *
+         * The whole image for images without an alpha channel; empty for invalid or fully
+         * transparent images.
+         */
+        static juce::Rectangle<int> getVisibleBounds (const juce::Image& image)
+        {
+            if (! image.isValid())
+                return {};
+
+            if (! image.hasAlphaChannel())
+                return image.getBounds();
+
+            const juce::Image::BitmapData data (image, juce::Image::BitmapData::readOnly);
+            const auto isARGB = image.getFormat() == juce::Image::ARGB;
+            auto left = data.width, right = -1, top = data.height, bottom = -1;
+
+            for (int y = 0; y < data.height; ++y)
+            {
+                const auto* pixel = data.getLinePointer (y);
+
+                for (int x = 0; x < data.width; ++x, pixel += data.pixelStride)
+                {
+                    const auto alpha = isARGB ? reinterpret_cast<const juce::PixelARGB*> (pixel)->getAlpha() : *pixel;
+
+                    if (alpha == 0)
+                        continue;
+
+                    left = std::min (left, x);
+                    right = std::max (right, x);
+                    top = std::min (top, y);
+                    bottom = y;
+                }
+            }
+
+            if (right < 0)
+                return {};
+
+            return { left, top, right - left + 1, bottom - top + 1 };
+        }
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE (ImageAlphaAnalysis)
+    };
+
+} // namespace BogrenDigital::UILoading
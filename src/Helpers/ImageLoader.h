@@ -7,6 +7,12 @@ namespace BogrenDigital::UILoading
      *
      * Concrete implementations load from JUCE BinaryData (BinaryAssetImageLoader)
      * or from a filesystem directory (FileAssetImageLoader).
+     *
+     * Decoded images are memoized per loader in a pluggable DecodedImageCache
+     * (an LruImageCache with LruImageCache::defaultByteBudget by default), keyed by the loader's own asset
+     * names. Underneath, every decode goes through the process-wide
+     * SharedImagePool, so identical encoded bytes share one decoded copy across
+     * all loaders and plugin instances in the process.
      */
     struct ImageLoader
     {
@@ -30,5 +36,270 @@ namespace BogrenDigital::UILoading
             const juce::String& fileSuffix) const = 0;
 
         [[nodiscard]] virtual juce::String getStringFromAsset (const juce::String& filename) const = 0;
+
+        /**
+         * @brief Loads an image of which only the alpha channel is used, e.g. a mask or a hitbox mask.
+         *
+         * Unless disabled with setSingleChannelMasks(), the image is converted to
+         * juce::Image::SingleChannel as it is decoded, and only that copy is cached: a
+         * quarter of the memory of the ARGB decode. The ARGB decode stays in the
+         * SharedImagePool until its next sweep (SharedImagePool::releaseUnusedImages(),
+         * which also runs every 64 decodes).
+         *
+         * Components hand masks to DeferredImageResampler through getResamplerMask().
+         */
+        [[nodiscard]] juce::Image loadMaskByFilename (const juce::String& filename) const
+        {
+            if (! singleChannelMasks)
+                return loadImageByFilename (filename);
+
+            // Loaders decode synchronously through getOrDecodeAsset(), which picks this up
+            const juce::ScopedValueSetter<bool> loadingMask (isLoadingMask(), true);
+            return loadImageByFilename (filename);
+        }
+
+        /**
+         * @brief The mask to hand to DeferredImageResampler, which draws with ARGB masks.
+         *
+         * SingleChannel masks are converted; the component's ARGB copy is the only one, while
+         * the cached single-channel mask stays shared. Other masks are returned as they are.
+         */
+        [[nodiscard]] static juce::Image getResamplerMask (const juce::Image& mask)
+        {
+            return mask.getFormat() == juce::Image::SingleChannel ? mask.convertedToFormat (juce::Image::ARGB) : mask;
+        }
+
+        /**
+         * @brief Loads images cropped to the visible bounds of their pixels, see ImageTrimming.
+         *
+         * The cropped copies are cached under their assets' keys, so elements sharing a filmstrip
+         * share them, while the uncropped decodes are dropped from the cache and the SharedImagePool
+         * right away. Missing or undecodable assets are skipped.
+         */
+        [[nodiscard]] juce::Array<juce::Image> loadTrimmedImages (const juce::StringArray& filenames) const
+        {
+            const auto allCached = std::all_of (filenames.begin(), filenames.end(), [this] (const juce::String& filename) {
+                return decodedImageCache->contains (getTrimmedCacheKey (getCacheKey (filename)));
+            });
+
+            // Decode in parallel first, so cropping below finds the uncropped images cached
+            juce::OwnedArray<juce::Image> uncropped;
+
+            if (! allCached)
+                uncropped = loadImageSequence ({}, filenames.strings, {});
+
+            juce::Array<juce::Image> images;
+            auto decodedAny = ! allCached;
+
+            for (const auto& filename : filenames)
+            {
+                auto image = decodedImageCache->getOrDecode (getTrimmedCacheKey (getCacheKey (filename)), [this, &filename, &decodedAny] {
+                    decodedAny = true;
+                    return ImageTrimming::trim (loadImageByFilename (filename));
+                });
+
+                if (image.isValid())
+                    images.add (std::move (image));
+            }
+
+            uncropped.clear();
+
+            if (decodedAny)
+                releaseDecodedImages (filenames);
+
+            return images;
+        }
+
+        /**
+         * @brief Drops the cached decodes of assets that were only loaded to derive other images from.
+         *
+         * E.g. filmstrip frames that were compressed. The SharedImagePool lets go of them as well,
+         * so their pixels are freed once nothing else holds them.
+         */
+        void releaseDecodedImages (const juce::StringArray& filenames) const
+        {
+            for (const auto& filename : filenames)
+                decodedImageCache->remove (getCacheKey (filename));
+
+            sharedImagePool->releaseUnusedImages();
+        }
+
+        /** @brief Drops every cached copy of the assets, decoded, as masks and trimmed, e.g. of a scale a ScaledImageSet released. */
+        void releaseCachedAssets (const juce::StringArray& filenames) const
+        {
+            for (const auto& filename : filenames)
+                removeCachedAsset (getCacheKey (filename));
+
+            sharedImagePool->releaseUnusedImages();
+        }
+
+        /** @brief The key an asset's decoded image is cached under; loaders that key by something else than the filename override it. */
+        [[nodiscard]] virtual juce::int64 getCacheKey (const juce::String& filename) const { return filename.hashCode64(); }
+
+        /**
+         * @brief Starts loading the requests on a background pool and returns right away.
+         *
+         * Requests run concurrently, each through the blocking calls above, so every loader
+         * gets this for free and shares its caches with them. onLoaded, if set, is called on
+         * a worker thread as each request finishes; post to the message thread from it to
+         * touch components. The loader must outlive the returned batch.
+         */
+        [[nodiscard]] std::unique_ptr<ImageBatch> loadAsync (std::vector<ImageRequest> requests, ImageBatch::Callback onLoaded = {}) const
+        {
+            return std::unique_ptr<ImageBatch> (new ImageBatch (*this, std::move (requests), std::move (onLoaded)));
+        }
+
+        /**
+         * @brief Identifies where the assets come from, so equal sources can be recognised across instances.
+         *
+         * Used as part of the WarmUICache key. An empty identifier (the default) opts out of warm reopening.
+         */
+        [[nodiscard]] virtual juce::String getAssetSourceIdentifier() const { return {}; }
+
+        /**
+         * @brief Replaces the cache decoded images are memoized in.
+         *
+         * Call before loading anything; a cache may be shared between loaders.
+         */
+        void setDecodedImageCache (std::shared_ptr<DecodedImageCache> cacheToUse)
+        {
+            jassert (cacheToUse != nullptr);
+            decodedImageCache = std::move (cacheToUse);
+        }
+
+        [[nodiscard]] DecodedImageCache& getDecodedImageCache() const { return *decodedImageCache; }
+        [[nodiscard]] std::shared_ptr<DecodedImageCache> getSharedDecodedImageCache() const { return decodedImageCache; }
+
+        /** @brief How PNG assets are decoded. */
+        enum class PngDecoder
+        {
+            fast, // FastPngDecoder, falling back to JUCE for the PNG variants it doesn't handle
+            juce  // juce::PNGImageFormat
+        };
+
+        /** @brief Selects the PNG decoder; call before loading anything. Defaults to PngDecoder::fast. */
+        void setPngDecoder (PngDecoder decoderToUse) { pngDecoder = decoderToUse; }
+        [[nodiscard]] PngDecoder getPngDecoder() const { return pngDecoder; }
+
+        /** @brief Whether loadMaskByFilename() converts masks to SingleChannel; call before loading anything. Defaults to true. */
+        void setSingleChannelMasks (bool shouldConvert) { singleChannelMasks = shouldConvert; }
+        [[nodiscard]] bool getSingleChannelMasks() const { return singleChannelMasks; }
+
+    protected:
+        /**
+         * @brief Returns the image cached under key, calling decode on a miss.
+         *
+         * Every loader serves its images through here, so requests are reported to the
+         * LoadRecorder and the PrefetchManifest::Recorder active on the calling thread, if any.
+         */
+        [[nodiscard]] juce::Image getOrDecodeAsset (const juce::String& filename, juce::int64 key, const std::function<juce::Image()>& decode) const
+        {
+            const auto asMask = std::exchange (isLoadingMask(), false);
+
+            // Masks are cached apart from the same file loaded as an image
+            if (asMask)
+                key = getMaskCacheKey (key);
+
+            if (auto* accessRecorder = PrefetchManifest::Recorder::getCurrent())
+                accessRecorder->recordAccess (filename, asMask);
+
+            const auto tracedDecode = [&filename, &decode, asMask] {
+                BD_UI_TRACE_SCOPE_DETAILED ("ImageLoader::decode", filename);
+                auto image = decode();
+                return asMask && image.isValid() ? image.convertedToFormat (juce::Image::SingleChannel) : image;
+            };
+
+            auto* recorder = LoadRecorder::getCurrent();
+
+            if (recorder == nullptr)
+                return decodedImageCache->getOrDecode (key, tracedDecode);
+
+            LoadReport::AssetRecord asset;
+            asset.filename = filename;
+            asset.loader = LoadReport::getTypeName (typeid (*this));
+            asset.source = getAssetSourceIdentifier();
+            asset.cacheHit = true;
+
+            auto image = [&] {
+                const LoadRecorder::ScopedAsset scopedAsset (asset);
+
+                return decodedImageCache->getOrDecode (key, [&asset, &tracedDecode] {
+                    asset.cacheHit = false;
+                    return tracedDecode();
+                });
+            }();
+
+            asset.decodedBytes = DecodedImageCache::getImageSizeInBytes (image);
+            recorder->addAsset (std::move (asset));
+            return image;
+        }
+
+        /**
+         * @brief Decodes encoded image bytes, sharing the pixels of identical assets across the process.
+         *
+         * QOI data is recognised by its content and decoded by QoiImageFormat, PNG data by the
+         * selected PngDecoder; anything else goes through juce::ImageFileFormat (JPEG, GIF).
+         */
+        [[nodiscard]] juce::Image decodeImage (const void* encodedData, size_t numBytes) const
+        {
+            auto* asset = LoadRecorder::getCurrentAsset();
+
+            if (asset != nullptr)
+            {
+                asset->encodedBytes = numBytes;
+                asset->sharedPoolHit = true;
+            }
+
+            return sharedImagePool->getOrDecode (encodedData, numBytes, [encodedData, numBytes, asset, decoder = pngDecoder] {
+                BD_UI_TRACE_SCOPE ("SharedImagePool::decode");
+                const auto startTicks = juce::Time::getHighResolutionTicks();
+                auto image = decodeImageData (encodedData, numBytes, decoder);
+
+                if (asset != nullptr)
+                {
+                    asset->sharedPoolHit = false;
+                    asset->decodeMilliseconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - startTicks) * 1000.0;
+                }
+
+                return image;
+            });
+        }
+
+        /** @brief Forgets the decoded copies of an asset as an image, as a mask and trimmed. */
+        void removeCachedAsset (juce::int64 key) const
+        {
+            decodedImageCache->remove (key);
+            decodedImageCache->remove (getMaskCacheKey (key));
+            decodedImageCache->remove (getTrimmedCacheKey (key));
+        }
+
+        /** @brief Decodes without the SharedImagePool; returns an invalid image for data that isn't an image. */
+        [[nodiscard]] static juce::Image decodeImageData (const void* encodedData, size_t numBytes, PngDecoder decoder)
+        {
+            if (QoiImageFormat::isQoi (encodedData, numBytes))
+                return QoiImageFormat::decode (encodedData, numBytes);
+
+            if (decoder == PngDecoder::fast && FastPngDecoder::isPng (encodedData, numBytes))
+            {
+                if (auto image = FastPngDecoder::decode (encodedData, numBytes); image.isValid())
+                    return image;
+            }
+
+            return juce::ImageFileFormat::loadFrom (encodedData, numBytes);
+        }
+
+        [[nodiscard]] static juce::int64 getMaskCacheKey (juce::int64 key) { return key ^ 0x6d61736b6d61736bLL; }
+        [[nodiscard]] static juce::int64 getTrimmedCacheKey (juce::int64 key) { return key ^ 0x7472696d7472696dLL; }
+
+        [[nodiscard]] static bool& isLoadingMask()
+        {
+            thread_local bool loadingMask = false;
+            return loadingMask;
+        }
+
+        std::shared_ptr<DecodedImageCache> decodedImageCache = std::make_shared<LruImageCache> (LruImageCache::defaultByteBudget);
+        PngDecoder pngDecoder = PngDecoder::fast;
+        bool singleChannelMasks = true;
+        juce::SharedResourcePointer<SharedImagePool> sharedImagePool;
     };
 }
@@ -0,0 +1,89 @@
+#pragma once
+
+namespace BogrenDigital::UILoading
+{
+    /**
+     * @brief Crops the transparent borders off decoded frames and places the cropped frames back.
+     *
+     * A trimmed image keeps only the pixels inside its visible bounds. Where they came from is
+     * stored in the image's properties, so drawing code can map the area the whole frame would
+     * cover to the area of the trimmed pixels with getDrawArea(). Images that were never
+     * trimmed are drawn into the whole area.
+     */
+    class ImageTrimming
+    {
+    public:
+        ImageTrimming() = delete;
+
+        /**
+         * @brief Returns a copy of the image's visible pixels, or the image itself if it has no transparent border.
+         *
+         * A fully transparent image becomes a single transparent pixel.
+         */
+        static juce::Image trim (const juce::Image& image)
+        {
+            if (! image.isValid())
+                return image;
+
+            auto bounds = ImageAlphaAnalysis::getVisibleBounds (image);
+
+            if (bounds == image.getBounds())
+                return image;
+
+            const auto isTransparent = bounds.isEmpty();
+
+            if (isTransparent)
+                bounds = { 0, 0, 1, 1 };
+
+            juce::Image trimmed (image.getFormat(), bounds.getWidth(), bounds.getHeight(), true);
+
+            if (! isTransparent)
+            {
+                const juce::Image::BitmapData source (image, bounds.getX(), bounds.getY(), bounds.getWidth(), bounds.getHeight(), juce::Image::BitmapData::readOnly);
+                const juce::Image::BitmapData destination (trimmed, juce::Image::BitmapData::writeOnly);
+
+                for (int y = 0; y < destination.height; ++y)
+                    std::memcpy (destination.getLinePointer (y), source.getLinePointer (y), (size_t) (destination.width * destination.pixelStride));
+            }
+
+            auto* properties = trimmed.getProperties();
+            properties->set (trimXProperty, bounds.getX());
+            properties->set (trimYProperty, bounds.getY());
+            properties->set (untrimmedWidthProperty, image.getWidth());
+            properties->set (untrimmedHeightProperty, image.getHeight());
+            return trimmed;
+        }
+
+        /** @brief True if the image was cropped by trim(). */
+        static bool isTrimmed (const juce::Image& image)
+        {
+            const auto* properties = image.getProperties();
+            return properties != nullptr && properties->contains (untrimmedWidthProperty);
+        }
+
+        /** @brief Maps the area the untrimmed frame is drawn into to the area its trimmed pixels go. */
+        static juce::Rectangle<float> getDrawArea (const juce::Image& image, juce::Rectangle<float> untrimmedArea)
+        {
+            if (! isTrimmed (image))
+                return untrimmedArea;
+
+            const auto* properties = image.getProperties();
+            const auto scaleX = untrimmedArea.getWidth() / static_cast<float> (static_cast<int> ((*properties)[untrimmedWidthProperty]));
+            const auto scaleY = untrimmedArea.getHeight() / static_cast<float> (static_cast<int> ((*properties)[untrimmedHeightProperty]));
+
+            return { untrimmedArea.getX() + static_cast<float> (static_cast<int> ((*properties)[trimXProperty])) * scaleX,
+                     untrimmedArea.getY() + static_cast<float> (static_cast<int> ((*properties)[trimYProperty])) * scaleY,
+                     static_cast<float> (image.getWidth()) * scaleX,
+                     static_cast<float> (image.getHeight()) * scaleY };
+        }
+
+    private:
+        inline static const juce::Identifier trimXProperty { "trimX" };
+        inline static const juce::Identifier trimYProperty { "trimY" };
+        inline static const juce::Identifier untrimmedWidthProperty { "untrimmedWidth" };
+        inline static const juce::Identifier untrimmedHeightProperty { "untrimmedHeight" };
+
+        JUCE_DECLARE_NON_COPYABLE (ImageTrimming)
+    };
+
+} // namespace BogrenDigital::UILoading
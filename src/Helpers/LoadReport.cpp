@@ -0,0 +1,100 @@
+#if __has_include(<cxxabi.h>)
+    #include <cxxabi.h>
+#endif
+
+namespace BogrenDigital::UILoading
+{
+    thread_local LoadRecorder* LoadRecorder::current = nullptr;
+    thread_local LoadReport::AssetRecord* LoadRecorder::currentAsset = nullptr;
+
+    void LoadRecorder::addAsset (LoadReport::AssetRecord asset)
+    {
+        const std::scoped_lock lock (mutex);
+        record.assets.push_back (std::move (asset));
+    }
+
+    void LoadRecorder::addPrepareTime (double milliseconds)
+    {
+        const std::scoped_lock lock (mutex);
+        record.prepareMilliseconds += milliseconds;
+    }
+
+    void LoadRecorder::addInstantiateTime (double milliseconds)
+    {
+        const std::scoped_lock lock (mutex);
+        record.instantiateMilliseconds += milliseconds;
+    }
+
+    LoadReport::ComponentRecord LoadRecorder::takeRecord()
+    {
+        const std::scoped_lock lock (mutex);
+        return std::exchange (record, {});
+    }
+
+    //==============================================================================
+    juce::String LoadReport::toString (bool includeAssets) const
+    {
+        const auto megabytes = [] (size_t bytes) {
+            return juce::String (static_cast<double> (bytes) / (1024.0 * 1024.0), 2) + " MB";
+        };
+
+        juce::StringArray lines;
+        lines.add (xmlFileName + ": " + juce::String (components.size()) + " components in " + juce::String (totalMilliseconds, 2) + " ms");
+
+        for (const auto& component : components)
+        {
+            size_t decodedBytes = 0;
+            int cacheHits = 0;
+
+            for (const auto& asset : component.assets)
+            {
+                decodedBytes += asset.decodedBytes;
+                cacheHits += asset.cacheHit ? 1 : 0;
+            }
+
+            if (component.reused)
+            {
+                lines.add ("  " + component.name + " (" + component.type + "): reused");
+                continue;
+            }
+
+            lines.add ("  " + component.name + " (" + component.type + ", " + component.factory + "): "
+                       + juce::String (component.getFactoryMilliseconds(), 2) + " ms (prepare " + juce::String (component.prepareMilliseconds, 2)
+                       + ", instantiate " + juce::String (component.instantiateMilliseconds, 2) + "), "
+                       + juce::String (component.assets.size()) + " assets, " + juce::String (cacheHits) + " cache hits, "
+                       + megabytes (decodedBytes) + " decoded");
+
+            if (! includeAssets)
+                continue;
+
+            for (const auto& asset : component.assets)
+            {
+                const auto source = asset.cacheHit ? juce::String ("cache hit") : asset.sharedPoolHit ? juce::String ("shared pool hit") : juce::String ("decoded");
+
+                const auto loader = asset.source.isEmpty() ? asset.loader : asset.loader + " " + asset.source;
+
+                lines.add ("    " + asset.filename + " [" + loader + "]: " + source
+                           + ", " + juce::String (asset.encodedBytes) + " encoded bytes, " + juce::String (asset.decodedBytes) + " decoded bytes, "
+                           + juce::String (asset.decodeMilliseconds, 3) + " ms");
+            }
+        }
+
+        return lines.joinIntoString ("\n");
+    }
+
+    juce::String LoadReport::getTypeName (const std::type_info& type)
+    {
+#if __has_include(<cxxabi.h>)
+        int status = 0;
+
+        if (auto* demangled = abi::__cxa_demangle (type.name(), nullptr, nullptr, &status); demangled != nullptr)
+        {
+            const juce::String name (demangled);
+            std::free (demangled);
+            return name;
+        }
+#endif
+
+        return juce::String (type.name()).fromLastOccurrenceOf ("class ", false, false);
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <mutex>
+#include <utility>
+#include <typeinfo>
+#include <vector>
+
+namespace BogrenDigital::UILoading
+{
+    /**
+     * @brief What a UILoader did to build its UI, element by element.
+     *
+     * Recorded by loadUI()/reloadUI() when enabled with UILoader::setLoadReportEnabled(),
+     * so a slow editor opening can be traced to the components and assets responsible.
+     */
+    struct LoadReport
+    {
+        /** @brief One image request made while building a component. */
+        struct AssetRecord
+        {
+            juce::String filename;
+            juce::String loader;            // The loader's type, e.g. "FileAssetImageLoader"
+            juce::String source;            // Its asset source identifier, if it has one
+            bool cacheHit = false;          // Served from the loader's DecodedImageCache
+            bool sharedPoolHit = false;     // Decoded pixels reused from the SharedImagePool
+            size_t encodedBytes = 0;        // Zero on cache hits, where nothing is read
+            size_t decodedBytes = 0;
+            double decodeMilliseconds = 0.0;
+        };
+
+        /** @brief One element of the XML. */
+        struct ComponentRecord
+        {
+            juce::String name;
+            juce::String type;
+            juce::String factory;
+            bool reused = false;            // Kept from the previous load, so no factory ran
+            double prepareMilliseconds = 0.0;     // Off-thread asset preparation (two-stage factories)
+            double instantiateMilliseconds = 0.0; // Message-thread construction (or all of createComponent())
+            std::vector<AssetRecord> assets;
+
+            double getFactoryMilliseconds() const { return prepareMilliseconds + instantiateMilliseconds; }
+        };
+
+        juce::String xmlFileName;
+        double totalMilliseconds = 0.0;
+        std::vector<ComponentRecord> components;
+
+        /** @brief A readable summary, one line per component and optionally per asset. */
+        juce::String toString (bool includeAssets = false) const;
+
+        /** @brief Readable name of a type, e.g. a factory or loader class. */
+        static juce::String getTypeName (const std::type_info& type);
+    };
+
+    /**
+     * @brief Collects the report of one component while it is being built.
+     *
+     * Activated per thread with ScopedActivation; ImageLoader reports every asset
+     * request to the recorder active on the calling thread. Work handed to other
+     * threads must activate the same recorder there. Thread-safe.
+     */
+    class LoadRecorder
+    {
+    public:
+        LoadRecorder() = default;
+
+        void addAsset (LoadReport::AssetRecord asset);
+        void addPrepareTime (double milliseconds);
+        void addInstantiateTime (double milliseconds);
+
+        /** @brief Returns the collected record; call once building has finished. */
+        LoadReport::ComponentRecord takeRecord();
+
+        /** @brief The recorder active on the calling thread, or nullptr if nothing is being recorded. */
+        static LoadRecorder* getCurrent() noexcept { return current; }
+
+        /** @brief The asset request in progress on the calling thread, filled in by the decode stage. */
+        static LoadReport::AssetRecord* getCurrentAsset() noexcept { return currentAsset; }
+
+        /** @brief Makes a recorder (which may be nullptr) the active one for the current scope. */
+        class ScopedActivation
+        {
+        public:
+            explicit ScopedActivation (LoadRecorder* recorder) noexcept : previous (std::exchange (current, recorder)) {}
+            ~ScopedActivation() { current = previous; }
+
+        private:
+            LoadRecorder* previous;
+            JUCE_DECLARE_NON_COPYABLE (ScopedActivation)
+        };
+
+        /** @brief Exposes an asset record to the decode stage while a request is served. */
+        class ScopedAsset
+        {
+        public:
+            explicit ScopedAsset (LoadReport::AssetRecord& asset) noexcept : previous (std::exchange (currentAsset, &asset)) {}
+            ~ScopedAsset() { currentAsset = previous; }
+
+        private:
+            LoadReport::AssetRecord* previous;
+            JUCE_DECLARE_NON_COPYABLE (ScopedAsset)
+        };
+
+    private:
+        static thread_local LoadRecorder* current;
+        static thread_local LoadReport::AssetRecord* currentAsset;
+
+        std::mutex mutex;
+        LoadReport::ComponentRecord record;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoadRecorder)
+    };
+}
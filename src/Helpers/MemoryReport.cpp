@@ -0,0 +1,192 @@
+namespace BogrenDigital::UILoading
+{
+    namespace
+    {
+        const void* getPixelDataKey (const juce::Image& image)
+        {
+            return &*image.getPixelData();
+        }
+
+        juce::String formatBytes (size_t bytes)
+        {
+            return juce::String (static_cast<double> (bytes) / (1024.0 * 1024.0), 2) + " MB";
+        }
+    }
+
+    MemoryReport MemoryReport::create (const std::vector<Entry>& entries)
+    {
+        struct Buffer
+        {
+            juce::Image image;
+            size_t bytes = 0;
+            juce::StringArray users;
+        };
+
+        MemoryReport report;
+        std::map<const void*, Buffer> buffers;
+        std::vector<std::vector<const void*>> buffersPerComponent;
+
+        for (const auto& entry : entries)
+        {
+            auto& record = report.components.emplace_back();
+            record.name = entry.name;
+            record.type = entry.type;
+
+            auto& componentBuffers = buffersPerComponent.emplace_back();
+
+            // Each buffer is attributed to the first role it appears in
+            const auto addImages = [&] (const juce::Array<juce::Image>& images, size_t& roleBytes) {
+                for (const auto& image : images)
+                {
+                    if (! image.isValid())
+                        continue;
+
+                    const auto key = getPixelDataKey (image);
+
+                    if (std::find (componentBuffers.begin(), componentBuffers.end(), key) != componentBuffers.end())
+                        continue;
+
+                    auto& buffer = buffers[key];
+                    buffer.image = image;
+                    buffer.bytes = DecodedImageCache::getImageSizeInBytes (image);
+                    buffer.users.add (entry.name);
+
+                    componentBuffers.push_back (key);
+                    roleBytes += buffer.bytes;
+                    ++record.numImages;
+                }
+            };
+
+            addImages (entry.images.images, record.imageBytes);
+
+            for (const auto& scaled : entry.images.scaledImages)
+            {
+                size_t scaledBytes = 0;
+                addImages (scaled.images, scaledBytes);
+                record.scaledImageBytes += scaledBytes;
+
+                if (! scaled.drawn && scaledBytes + scaled.compressedBytes > 0)
+                    report.waste.push_back ({ Waste::Kind::undrawnScale, juce::StringArray (entry.name), scaledBytes + scaled.compressedBytes, scaled.scale });
+            }
+
+            addImages (entry.images.masks, record.maskBytes);
+            addImages (entry.images.hitboxMasks, record.hitboxMaskBytes);
+            addImages (entry.images.caches, record.cacheBytes);
+            record.compressedBytes = entry.images.compressedBytes;
+        }
+
+        for (size_t i = 0; i < report.components.size(); ++i)
+        {
+            auto& record = report.components[i];
+            record.exclusiveBytes += record.compressedBytes;
+            report.exclusiveBytes += record.compressedBytes;
+            report.totalBytes += record.compressedBytes;
+
+            for (const auto* key : buffersPerComponent[i])
+            {
+                const auto& buffer = buffers[key];
+                (buffer.users.size() > 1 ? record.sharedBytes : record.exclusiveBytes) += buffer.bytes;
+            }
+        }
+
+        std::map<juce::uint64, std::vector<const Buffer*>> buffersByContent;
+
+        for (const auto& [key, buffer] : buffers)
+        {
+            report.totalBytes += buffer.bytes;
+            (buffer.users.size() > 1 ? report.sharedBytes : report.exclusiveBytes) += buffer.bytes;
+            buffersByContent[SharedImagePool::hashPixels (buffer.image)].push_back (&buffer);
+        }
+
+        for (auto& [hash, candidates] : buffersByContent)
+        {
+            // Equal hashes only suggest equal pixels, so split the candidates by comparing them
+            while (candidates.size() > 1)
+            {
+                const auto* first = candidates.front();
+                const auto duplicatesEnd = std::stable_partition (candidates.begin(), candidates.end(), [first] (const Buffer* buffer) {
+                    return buffer == first || SharedImagePool::havePixelsEqual (buffer->image, first->image);
+                });
+
+                if (duplicatesEnd - candidates.begin() > 1)
+                {
+                    Waste waste { Waste::Kind::duplicatePixels, {}, 0 };
+
+                    // Keeping one copy would be enough
+                    for (auto it = candidates.begin(); it != duplicatesEnd; ++it)
+                    {
+                        waste.componentNames.mergeArray ((*it)->users);
+                        waste.bytes += it != candidates.begin() ? (*it)->bytes : 0;
+                    }
+
+                    report.waste.push_back (std::move (waste));
+                }
+
+                candidates.erase (candidates.begin(), duplicatesEnd);
+            }
+        }
+
+        std::map<juce::String, TypeRecord> types;
+
+        for (const auto& record : report.components)
+        {
+            auto& type = types[record.type];
+            type.type = record.type;
+            ++type.numComponents;
+            type.exclusiveBytes += record.exclusiveBytes;
+            type.sharedBytes += record.sharedBytes;
+        }
+
+        for (const auto& [name, type] : types)
+            report.types.push_back (type);
+
+        std::stable_sort (report.components.begin(), report.components.end(), [] (const auto& a, const auto& b) {
+            return a.getTotalBytes() > b.getTotalBytes();
+        });
+
+        std::stable_sort (report.types.begin(), report.types.end(), [] (const auto& a, const auto& b) {
+            return a.exclusiveBytes + a.sharedBytes > b.exclusiveBytes + b.sharedBytes;
+        });
+
+        std::stable_sort (report.waste.begin(), report.waste.end(), [] (const auto& a, const auto& b) {
+            return a.bytes > b.bytes;
+        });
+
+        return report;
+    }
+
+    juce::String MemoryReport::toString() const
+    {
+        juce::StringArray lines;
+        lines.add ("Total " + formatBytes (totalBytes) + " (" + formatBytes (exclusiveBytes) + " exclusive, " + formatBytes (sharedBytes) + " shared)");
+
+        lines.add ("Types:");
+
+        for (const auto& type : types)
+            lines.add ("  " + type.type + " x" + juce::String (type.numComponents) + ": " + formatBytes (type.exclusiveBytes) + " exclusive, " + formatBytes (type.sharedBytes) + " shared");
+
+        lines.add ("Components:");
+
+        for (const auto& component : components)
+        {
+            lines.add ("  " + component.name + " (" + component.type + "): " + formatBytes (component.getTotalBytes())
+                       + " in " + juce::String (component.numImages) + " images (1x " + formatBytes (component.imageBytes)
+                       + ", scaled " + formatBytes (component.scaledImageBytes) + ", masks " + formatBytes (component.maskBytes)
+                       + ", hitbox masks " + formatBytes (component.hitboxMaskBytes) + ", caches " + formatBytes (component.cacheBytes)
+                       + ", compressed " + formatBytes (component.compressedBytes) + ")");
+        }
+
+        if (! waste.empty())
+            lines.add ("Waste:");
+
+        for (const auto& entry : waste)
+        {
+            const auto description = entry.kind == Waste::Kind::duplicatePixels
+                                         ? juce::String ("duplicate pixels in ")
+                                         : juce::String (entry.scale, 2).trimCharactersAtEnd ("0").trimCharactersAtEnd (".") + "x images never drawn in ";
+            lines.add ("  " + formatBytes (entry.bytes) + ", " + description + entry.componentNames.joinIntoString (", "));
+        }
+
+        return lines.joinIntoString ("\n");
+    }
+}
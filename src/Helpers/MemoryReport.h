@@ -0,0 +1,119 @@
+#pragma once
+
+#include <map>
+#include <vector>
+
+namespace BogrenDigital::UILoading
+{
+    /**
+     * @brief Decoded pixel memory held by a loaded UI, per component and per type.
+     *
+     * Built by UILoader::getMemoryReport(). Images are counted by their pixel data,
+     * so a buffer referenced several times (e.g. as a frame and by a ScaledImageSet)
+     * is counted once. Buffers referenced by one component are exclusive to it;
+     * buffers several components reference are shared, and count towards each of
+     * them but only once towards the totals.
+     *
+     * The resampled copies DeferredImageResampler caches internally are not exposed
+     * by it and therefore not included.
+     */
+    struct MemoryReport
+    {
+        /** @brief The images of one scale other than 1x, held by a ScaledImageSet. */
+        struct ScaledImages
+        {
+            double scale = 2.0;
+            juce::Array<juce::Image> images;
+            size_t compressedBytes = 0; // Also included in ComponentImages::compressedBytes
+            bool drawn = false;
+        };
+
+        /** @brief The images one component holds, gathered via ImageMemoryProvider. */
+        struct ComponentImages
+        {
+            juce::Array<juce::Image> images;       // 1x images or filmstrip frames
+            std::vector<ScaledImages> scaledImages; // Every other scale
+            juce::Array<juce::Image> masks;
+            juce::Array<juce::Image> hitboxMasks;
+            juce::Array<juce::Image> caches;       // Images rendered at runtime, e.g. the static layer
+            size_t compressedBytes = 0;            // Encoded frames, e.g. of a CompressedFilmstrip
+        };
+
+        struct ComponentRecord
+        {
+            juce::String name;
+            juce::String type;
+            int numImages = 0;
+            size_t imageBytes = 0;
+            size_t scaledImageBytes = 0; // Every scale other than 1x
+            size_t maskBytes = 0;
+            size_t hitboxMaskBytes = 0;
+            size_t cacheBytes = 0;
+            size_t compressedBytes = 0; // Counted as exclusive
+            size_t exclusiveBytes = 0;
+            size_t sharedBytes = 0;
+
+            size_t getTotalBytes() const { return exclusiveBytes + sharedBytes; }
+        };
+
+        struct TypeRecord
+        {
+            juce::String type;
+            int numComponents = 0;
+            size_t exclusiveBytes = 0;
+            size_t sharedBytes = 0;
+        };
+
+        /** @brief Memory that could be saved. */
+        struct Waste
+        {
+            enum class Kind
+            {
+                duplicatePixels, // Identical pixels decoded into separate buffers
+                undrawnScale     // The images of a scale other than 1x that have never been drawn
+            };
+
+            Kind kind;
+            juce::StringArray componentNames;
+            size_t bytes = 0;
+            double scale = 0.0; // Of an undrawnScale
+        };
+
+        std::vector<ComponentRecord> components; // Most memory first
+        std::vector<TypeRecord> types;           // Most memory first
+        std::vector<Waste> waste;                // Most bytes first
+
+        size_t totalBytes = 0; // Every distinct pixel buffer, once, plus compressed frames
+        size_t exclusiveBytes = 0;
+        size_t sharedBytes = 0;
+
+        /** @brief A readable summary of the totals, types, components and waste. */
+        juce::String toString() const;
+
+        /** @brief One component to account for, in the order it is reported. */
+        struct Entry
+        {
+            juce::String name;
+            juce::String type;
+            ComponentImages images;
+        };
+
+        /** @brief Builds the report; finds duplicates by hashing every pixel buffer and comparing those with equal hashes. */
+        static MemoryReport create (const std::vector<Entry>& entries);
+    };
+
+    /**
+     * @brief Implemented by components holding decoded images, so their memory is reported.
+     *
+     * DeferredImageResampler doesn't expose the mask it is given, so components keep their
+     * own handle to the mask they loaded to report it. The ARGB copy the resampler draws a
+     * single-channel mask with (see ImageLoader::getResamplerMask()) isn't reported.
+     */
+    struct ImageMemoryProvider
+    {
+        virtual ~ImageMemoryProvider() = default;
+
+        /** @brief Adds every image the component holds. Handles to the same pixels may be added more than once. */
+        virtual void getImagesForMemoryReport (MemoryReport::ComponentImages& images) const = 0;
+    };
+}
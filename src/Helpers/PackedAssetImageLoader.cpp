@@ -2,6 +2,7 @@
 #if BD_UI_LOADER_HAS_PACKED_ASSETS
 
 #include "../../third_party/include/BS_thread_pool.hpp"
+#include <deque>
 #include <vector>
 
 namespace BogrenDigital::UILoading
@@ -19,10 +20,25 @@ namespace BogrenDigital::UILoading
                 : threadPool (static_cast<std::size_t> (juce::SystemStats::getNumCpus())) {}
         };
         juce::SharedResourcePointer<PackedImageLoadingThreadPool> packedImageThreadPool;
+
+        /** The decode tasks of one batch; waits for all of them when it goes out of scope, even while an exception unwinds. */
+        struct PendingDecodes
+        {
+            std::deque<std::future<void>> tasks;
+
+            ~PendingDecodes()
+            {
+                for (auto& task : tasks)
+                    if (task.valid())
+                        task.wait();
+            }
+        };
     }
 
-    PackedAssetImageLoader::PackedAssetImageLoader (std::shared_ptr<const pt::packedassets::PackedAssetSource> src)
-        : source (std::move (src))
+    PackedAssetImageLoader::PackedAssetImageLoader (std::shared_ptr<const pt::packedassets::PackedAssetSource> src,
+                                                    juce::String sourceNameToUse)
+        : source (std::move (src)),
+          sourceName (std::move (sourceNameToUse))
     {
     }
 
@@ -40,70 +56,97 @@ namespace BogrenDigital::UILoading
 
     juce::Image PackedAssetImageLoader::loadOne (const juce::String& filename) const
     {
-        // Memoize decoded images, like BinaryAssetImageLoader/FileAssetImageLoader.
+        // Memoize decoded images in the loader's DecodedImageCache, like BinaryAssetImageLoader/FileAssetImageLoader.
         // PackedAssetSource::getBytes re-decrypts on every call, and the UI
         // factories load the same filmstrip 2-3x at construction, so without this
         // each frame would be decrypted AND decoded repeatedly. Keyed on the
         // ORIGINAL filename (the pak stores originals verbatim).
         const auto hashCode = filename.hashCode64();
 
-        if (auto cached = juce::ImageCache::getFromHashCode (hashCode); cached.isValid())
-        {
-            return cached;
-        }
+        return getOrDecodeAsset (filename, hashCode, [this, &filename]() -> juce::Image {
+            const auto bytes = fetchBytes (filename);
 
-        const auto bytes = fetchBytes (filename);
+            if (! bytes)
+            {
+                // Valid for optional resources like masks; matches the sibling loaders.
+                return {};
+            }
 
-        if (! bytes)
+            return decodeImage (bytes->data(), bytes->size());
+        });
+    }
+
+    juce::Image PackedAssetImageLoader::loadImageByFilename (const juce::String& filename) const
+    {
+        return loadOne (filename);
+    }
+
+    std::vector<juce::Image> PackedAssetImageLoader::loadImageBatch (const std::vector<juce::String>& filenames) const
+    {
+        std::vector<juce::Image> images (filenames.size());
+
+        if (filenames.size() == 1)
         {
-            // Valid for optional resources like masks; matches the sibling loaders.
-            return {};
+            images.front() = loadOne (filenames.front());
+            return images;
         }
 
-        auto image = juce::ImageFileFormat::loadFrom (bytes->data(), bytes->size());
+        auto& threadPool = packedImageThreadPool->threadPool;
+        const auto maxBuffersInFlight = 2 * threadPool.get_thread_count();
+        auto* recorder = LoadRecorder::getCurrent();
+        auto* accessRecorder = PrefetchManifest::Recorder::getCurrent();
 
-        if (image.isValid())
+        // Declared after the images, so a fetch that throws can't unwind them while tasks still write into them
+        PendingDecodes decoding;
+
+        for (size_t i = 0; i < filenames.size(); ++i)
         {
-            juce::ImageCache::addImageToCache (image, hashCode);
+            const auto& filename = filenames[i];
+
+            // Cached images need neither decrypting nor decoding, and missing names no fetch
+            if (source == nullptr || filename.isEmpty() || decodedImageCache->contains (filename.hashCode64()))
+            {
+                images[i] = loadOne (filename);
+                continue;
+            }
+
+            // Decrypt here while the pool decodes the buffers handed over before.
+            // Shared because the pool's tasks must be copyable.
+            const auto bytes = std::make_shared<const std::optional<std::vector<uint8_t>>> (fetchBytes (filename));
+
+            if (decoding.tasks.size() >= maxBuffersInFlight)
+            {
+                decoding.tasks.front().wait();
+                decoding.tasks.pop_front();
+            }
+
+            decoding.tasks.push_back (threadPool.submit_task ([this, &images, &filename, i, bytes, recorder, accessRecorder] {
+                const LoadRecorder::ScopedActivation activation (recorder);
+                const PrefetchManifest::Recorder::ScopedActivation accessActivation (accessRecorder);
+
+                // Another thread may have cached it meanwhile, in which case the bytes go unused
+                images[i] = getOrDecodeAsset (filename, filename.hashCode64(), [this, &bytes]() -> juce::Image {
+                    if (! *bytes)
+                        return {};
+
+                    return decodeImage ((*bytes)->data(), (*bytes)->size());
+                });
+            }));
         }
 
-        return image;
-    }
+        // Wait for this batch only; factories prepare several elements concurrently.
+        for (auto& task : decoding.tasks)
+            task.wait();
 
-    juce::Image PackedAssetImageLoader::loadImageByFilename (const juce::String& filename) const
-    {
-        return loadOne (filename);
+        return images;
     }
 
     juce::OwnedArray<juce::Image> PackedAssetImageLoader::loadImageSequenceFromFilenames (
         const std::vector<juce::String>& filenames) const
     {
         juce::OwnedArray<juce::Image> images;
-        const int n = static_cast<int> (filenames.size());
-        if (n == 0)
-            return images;
 
-        // Small sequences: serial (the thread-pool dispatch isn't worth it).
-        if (n <= 10)
-        {
-            for (const auto& f : filenames)
-                if (auto image = loadOne (f); image.isValid())
-                    images.add (new juce::Image (std::move (image)));
-            return images;
-        }
-
-        // Large filmstrips: decode in parallel. loadOne is thread-safe -- getBytes
-        // decrypts fresh with no shared mutable state, and juce::ImageCache is
-        // internally synchronised.
-        std::vector<juce::Image> decoded (static_cast<size_t> (n));
-        for (int i = 0; i < n; ++i)
-            packedImageThreadPool->threadPool.detach_task ([this, &decoded, f = filenames[(size_t) i], i] {
-                if (auto image = loadOne (f); image.isValid())
-                    decoded[(size_t) i] = std::move (image);
-            });
-        packedImageThreadPool->threadPool.wait();
-
-        for (auto& image : decoded)
+        for (auto& image : loadImageBatch (filenames))
             if (image.isValid())
                 images.add (new juce::Image (std::move (image)));
 
@@ -148,6 +191,13 @@ namespace BogrenDigital::UILoading
 
     juce::String PackedAssetImageLoader::getStringFromAsset (const juce::String& filename) const
     {
+        {
+            const std::scoped_lock lock (stringCacheMutex);
+
+            if (const auto it = stringCache.find (filename); it != stringCache.end())
+                return it->second;
+        }
+
         const auto bytes = fetchBytes (filename);
 
         if (! bytes)
@@ -155,8 +205,22 @@ namespace BogrenDigital::UILoading
             return {};
         }
 
-        return juce::String::fromUTF8 (reinterpret_cast<const char*> (bytes->data()),
+        auto text = juce::String::fromUTF8 (reinterpret_cast<const char*> (bytes->data()),
             static_cast<int> (bytes->size()));
+
+        // The pak is immutable, so a decrypted string never goes stale
+        const std::scoped_lock lock (stringCacheMutex);
+        stringCache.emplace (filename, text);
+        return text;
+    }
+
+    juce::String PackedAssetImageLoader::getAssetSourceIdentifier() const
+    {
+        // The pak can't be enumerated, so it is identified by the name it was given
+        if (source == nullptr || sourceName.isEmpty())
+            return {};
+
+        return "packed:" + sourceName;
     }
 }
 #endif
@@ -3,6 +3,9 @@
     #include <playfultones_packedassets/playfultones_packedassets.h>
     #define BD_UI_LOADER_HAS_PACKED_ASSETS 1
 
+    #include <map>
+    #include <mutex>
+
     #include "ImageLoader.h"
 
 namespace BogrenDigital::UILoading
@@ -16,11 +19,11 @@ namespace BogrenDigital::UILoading
      * PackedAssetSource::getBytes. Missing assets yield an empty juce::Image
      * (mirroring BinaryAssetImageLoader's behaviour for optional resources).
      *
-     * Decoded images are memoized via juce::ImageCache, keyed on the original
-     * filename's hashCode64() (matching BinaryAssetImageLoader/FileAssetImageLoader);
+     * Decoded images are memoized via the loader's DecodedImageCache, keyed on
+     * the original filename's hashCode64() (matching BinaryAssetImageLoader/FileAssetImageLoader);
      * this matters because PackedAssetSource::getBytes re-decrypts on every call.
-     * Unlike BinaryAssetImageLoader it does NOT parallelize large sequences across
-     * a thread pool yet (sequences decode serially) -- see the follow-up issue.
+     * Strings are memoized per loader for the same reason. Sequences load through
+     * loadImageBatch(), which overlaps decryption with decoding.
      */
     struct PackedAssetImageLoader : public ImageLoader
     {
@@ -28,7 +31,12 @@ namespace BogrenDigital::UILoading
         /// so the buffer behind `src`'s span must outlive this loader. The production
         /// path (pt::packedassets::createDefaultSource()) maps with process-static
         /// lifetime and is safe; only callers wrapping a temporary pak need care.
-        explicit PackedAssetImageLoader (std::shared_ptr<const pt::packedassets::PackedAssetSource> src);
+        ///
+        /// `sourceName` names the pak in warm-cache keys and load reports. Loaders
+        /// of the same pak should use the same name; a pak other than the process's
+        /// default source needs a name of its own.
+        explicit PackedAssetImageLoader (std::shared_ptr<const pt::packedassets::PackedAssetSource> src,
+                                         juce::String sourceName = "default");
         ~PackedAssetImageLoader() override;
 
         [[nodiscard]] juce::Image loadImageByFilename (const juce::String& filename) const override;
@@ -48,14 +56,26 @@ namespace BogrenDigital::UILoading
             const juce::Array<juce::String>& fileNames,
             const juce::String& fileSuffix) const override;
 
+        /**
+         * @brief Loads several images, in order; missing assets yield invalid images.
+         *
+         * Entries that aren't cached yet are decrypted one after another on the calling
+         * thread, and each buffer is handed to a decode task on the shared pool as soon as
+         * it is ready, so decrypting the next entry overlaps decoding the previous ones.
+         * The number of decrypted buffers waiting for a decoder is bounded.
+         */
+        [[nodiscard]] std::vector<juce::Image> loadImageBatch (const std::vector<juce::String>& filenames) const;
+
+        /** @brief Decrypts a text asset once; later calls return the memoized string. */
         [[nodiscard]] juce::String getStringFromAsset (const juce::String& filename) const override;
 
+        [[nodiscard]] juce::String getAssetSourceIdentifier() const override;
+
     private:
         [[nodiscard]] juce::Image loadOne (const juce::String& filename) const;
 
-        // Decode a sequence by full filename, in parallel across a shared thread
-        // pool for >10 frames (matching BinaryAssetImageLoader). Invalid frames
-        // are dropped. The three public overloads build the names and delegate.
+        // Decode a sequence by full filename through loadImageBatch(). Invalid
+        // frames are dropped. The three public overloads build the names and delegate.
         [[nodiscard]] juce::OwnedArray<juce::Image> loadImageSequenceFromFilenames (
             const std::vector<juce::String>& filenames) const;
 
@@ -64,6 +84,10 @@ namespace BogrenDigital::UILoading
         [[nodiscard]] std::optional<std::vector<uint8_t>> fetchBytes (const juce::String& filename) const;
 
         std::shared_ptr<const pt::packedassets::PackedAssetSource> source;
+        juce::String sourceName;
+
+        mutable std::mutex stringCacheMutex;
+        mutable std::map<juce::String, juce::String> stringCache;
     };
 }
 #endif
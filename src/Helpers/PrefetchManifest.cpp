@@ -0,0 +1,91 @@
+namespace BogrenDigital::UILoading
+{
+    namespace
+    {
+        // One asset per line: its kind, a tab and the filename
+        const juce::String imagePrefix = "image\t";
+        const juce::String maskPrefix = "mask\t";
+    }
+
+    thread_local PrefetchManifest::Recorder* PrefetchManifest::Recorder::current = nullptr;
+
+    PrefetchManifest PrefetchManifest::fromString (const juce::String& text)
+    {
+        PrefetchManifest manifest;
+
+        for (const auto& line : juce::StringArray::fromLines (text))
+        {
+            if (line.startsWith (imagePrefix))
+                manifest.entries.push_back ({ line.substring (imagePrefix.length()), false });
+            else if (line.startsWith (maskPrefix))
+                manifest.entries.push_back ({ line.substring (maskPrefix.length()), true });
+        }
+
+        return manifest;
+    }
+
+    PrefetchManifest PrefetchManifest::loadFrom (const juce::File& file)
+    {
+        return file.existsAsFile() ? fromString (file.loadFileAsString()) : PrefetchManifest();
+    }
+
+    juce::String PrefetchManifest::toString() const
+    {
+        juce::String text;
+
+        for (const auto& entry : entries)
+            text << (entry.mask ? maskPrefix : imagePrefix) << entry.filename << "\n";
+
+        return text;
+    }
+
+    bool PrefetchManifest::saveTo (const juce::File& file) const
+    {
+        const auto text = toString();
+
+        if (file.existsAsFile() && file.loadFileAsString() == text)
+            return true;
+
+        return file.getParentDirectory().createDirectory() && file.replaceWithText (text);
+    }
+
+    std::vector<ImageRequest> PrefetchManifest::getRequests() const
+    {
+        std::vector<ImageRequest> requests;
+        requests.reserve (entries.size());
+
+        for (const auto& entry : entries)
+            requests.push_back (entry.mask ? ImageRequest::mask (entry.filename) : ImageRequest::file (entry.filename));
+
+        return requests;
+    }
+
+    void PrefetchManifest::Recorder::recordAccess (const juce::String& filename, bool mask)
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+
+        if (recorded.insert ((mask ? maskPrefix : imagePrefix) + filename).second)
+            entries.push_back ({ filename, mask });
+    }
+
+    void PrefetchManifest::Recorder::merge (const Recorder& other)
+    {
+        auto otherEntries = other.getManifest().entries;
+
+        std::sort (otherEntries.begin(), otherEntries.end(), [] (const Entry& a, const Entry& b) {
+            const auto order = a.filename.compareNatural (b.filename);
+            return order != 0 ? order < 0 : a.mask < b.mask;
+        });
+
+        for (const auto& entry : otherEntries)
+            recordAccess (entry.filename, entry.mask);
+    }
+
+    PrefetchManifest PrefetchManifest::Recorder::getManifest() const
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        PrefetchManifest manifest;
+        manifest.entries = entries;
+        return manifest;
+    }
+}
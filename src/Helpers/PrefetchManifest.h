@@ -0,0 +1,100 @@
+#pragma once
+
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace BogrenDigital::UILoading
+{
+    /**
+     * @brief The images a UI loaded, in the order of the elements that first asked for them.
+     *
+     * A UILoader with a manifest file records one on every fresh loadUI() and saves it.
+     * Since a UI asks for the same assets in the same order every time it opens, a later
+     * session can replay the saved manifest with ImageLoader::loadAsync (getRequests())
+     * as early as plugin construction, so the images are decoded by the time the editor's
+     * factories ask for them.
+     */
+    class PrefetchManifest
+    {
+    public:
+        struct Entry
+        {
+            juce::String filename;
+            bool mask = false; // Loaded with loadMaskByFilename()
+
+            bool operator== (const Entry& other) const { return filename == other.filename && mask == other.mask; }
+        };
+
+        PrefetchManifest() = default;
+
+        /** @brief Parses a manifest written by toString(); unknown lines are skipped. */
+        static PrefetchManifest fromString (const juce::String& text);
+
+        /** @brief Reads a saved manifest; empty if the file doesn't exist. */
+        static PrefetchManifest loadFrom (const juce::File& file);
+
+        juce::String toString() const;
+
+        /** @brief Writes the manifest unless the file already holds the same one. */
+        bool saveTo (const juce::File& file) const;
+
+        const std::vector<Entry>& getEntries() const { return entries; }
+        bool isEmpty() const { return entries.empty(); }
+
+        /** @brief One request per entry, in access order, for ImageLoader::loadAsync(). */
+        std::vector<ImageRequest> getRequests() const;
+
+        /**
+         * @brief Collects the first access to every asset while a UI loads.
+         *
+         * Loaders report to the recorder active on the calling thread, see ScopedActivation,
+         * so only the loads made on behalf of that UI are recorded, not concurrent ones such
+         * as a prefetch. Thread-safe, since loaders decode on their pools.
+         */
+        class Recorder
+        {
+        public:
+            Recorder() = default;
+
+            void recordAccess (const juce::String& filename, bool mask);
+
+            /**
+             * @brief Appends the accesses of another recorder that aren't recorded yet.
+             *
+             * They are ordered by filename, since loads that ran in parallel (e.g. the frames
+             * of a filmstrip) were recorded in whichever order they happened to run.
+             */
+            void merge (const Recorder& other);
+
+            PrefetchManifest getManifest() const;
+
+            /** @brief The recorder active on the calling thread, or nullptr if nothing is being recorded. */
+            static Recorder* getCurrent() noexcept { return current; }
+
+            /** @brief Makes a recorder (which may be nullptr) the active one for the current scope. */
+            class ScopedActivation
+            {
+            public:
+                explicit ScopedActivation (Recorder* recorder) noexcept : previous (std::exchange (current, recorder)) {}
+                ~ScopedActivation() { current = previous; }
+
+            private:
+                Recorder* previous;
+                JUCE_DECLARE_NON_COPYABLE (ScopedActivation)
+            };
+
+        private:
+            static thread_local Recorder* current;
+
+            mutable std::mutex mutex;
+            std::vector<Entry> entries;
+            std::unordered_set<juce::String> recorded;
+
+            JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Recorder)
+        };
+
+    private:
+        std::vector<Entry> entries;
+    };
+}
@@ -0,0 +1,250 @@
+namespace BogrenDigital::UILoading
+{
+    namespace
+    {
+        // See https://qoiformat.org/qoi-specification.pdf
+        constexpr juce::uint8 qoiOpIndex = 0x00;
+        constexpr juce::uint8 qoiOpDiff = 0x40;
+        constexpr juce::uint8 qoiOpLuma = 0x80;
+        constexpr juce::uint8 qoiOpRun = 0xc0;
+        constexpr juce::uint8 qoiOpRgb = 0xfe;
+        constexpr juce::uint8 qoiOpRgba = 0xff;
+        constexpr juce::uint8 qoiTagMask = 0xc0;
+
+        constexpr size_t qoiHeaderSize = 14;
+        constexpr juce::uint8 qoiEndMarker[] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+        constexpr juce::uint32 qoiMaxPixels = 400000000;
+
+        struct QoiPixel
+        {
+            juce::uint8 r = 0, g = 0, b = 0, a = 255;
+
+            bool operator== (const QoiPixel& other) const noexcept { return r == other.r && g == other.g && b == other.b && a == other.a; }
+        };
+
+        int getQoiIndexPosition (QoiPixel pixel) noexcept
+        {
+            return (pixel.r * 3 + pixel.g * 5 + pixel.b * 7 + pixel.a * 11) % 64;
+        }
+    }
+
+    bool QoiImageFormat::isQoi (const void* data, size_t numBytes) noexcept
+    {
+        return numBytes >= qoiHeaderSize && std::memcmp (data, "qoif", 4) == 0;
+    }
+
+    bool QoiImageFormat::canUnderstand (juce::InputStream& input)
+    {
+        char magic[4] {};
+        return input.read (magic, 4) == 4 && isQoi (magic, qoiHeaderSize);
+    }
+
+    juce::Image QoiImageFormat::decodeImage (juce::InputStream& input)
+    {
+        juce::MemoryBlock data;
+        input.readIntoMemoryBlock (data);
+        return decode (data.getData(), data.getSize());
+    }
+
+    bool QoiImageFormat::writeImageToStream (const juce::Image& sourceImage, juce::OutputStream& destStream)
+    {
+        const auto data = encode (sourceImage);
+        return data.getSize() > 0 && destStream.write (data.getData(), data.getSize());
+    }
+
+    juce::Image QoiImageFormat::decode (const void* data, size_t numBytes)
+    {
+        if (! isQoi (data, numBytes) || numBytes < qoiHeaderSize + sizeof (qoiEndMarker))
+            return {};
+
+        const auto* bytes = static_cast<const juce::uint8*> (data);
+        const auto width = juce::ByteOrder::bigEndianInt (bytes + 4);
+        const auto height = juce::ByteOrder::bigEndianInt (bytes + 8);
+        const auto channels = bytes[12];
+
+        if (width == 0 || height == 0 || height >= qoiMaxPixels / width || (channels != 3 && channels != 4))
+            return {};
+
+        juce::Image image (channels == 4 ? juce::Image::ARGB : juce::Image::RGB, (int) width, (int) height, false);
+        const juce::Image::BitmapData bitmap (image, juce::Image::BitmapData::writeOnly);
+
+        QoiPixel index[64] {};
+        QoiPixel pixel;
+        int run = 0;
+        size_t position = qoiHeaderSize;
+
+        // Chunks are at most 5 bytes and the end marker is 8, so no chunk can be read past the end
+        const auto chunksEnd = numBytes - sizeof (qoiEndMarker);
+
+        for (int y = 0; y < bitmap.height; ++y)
+        {
+            auto* line = bitmap.getLinePointer (y);
+
+            for (int x = 0; x < bitmap.width; ++x)
+            {
+                if (run > 0)
+                {
+                    --run;
+                }
+                else if (position < chunksEnd)
+                {
+                    const auto b1 = bytes[position++];
+
+                    if (b1 == qoiOpRgb)
+                    {
+                        pixel.r = bytes[position++];
+                        pixel.g = bytes[position++];
+                        pixel.b = bytes[position++];
+                    }
+                    else if (b1 == qoiOpRgba)
+                    {
+                        pixel.r = bytes[position++];
+                        pixel.g = bytes[position++];
+                        pixel.b = bytes[position++];
+                        pixel.a = bytes[position++];
+                    }
+                    else if ((b1 & qoiTagMask) == qoiOpIndex)
+                    {
+                        pixel = index[b1];
+                    }
+                    else if ((b1 & qoiTagMask) == qoiOpDiff)
+                    {
+                        pixel.r = (juce::uint8) (pixel.r + ((b1 >> 4) & 0x03) - 2);
+                        pixel.g = (juce::uint8) (pixel.g + ((b1 >> 2) & 0x03) - 2);
+                        pixel.b = (juce::uint8) (pixel.b + (b1 & 0x03) - 2);
+                    }
+                    else if ((b1 & qoiTagMask) == qoiOpLuma)
+                    {
+                        const auto b2 = bytes[position++];
+                        const auto greenDifference = (b1 & 0x3f) - 32;
+
+                        pixel.r = (juce::uint8) (pixel.r + greenDifference - 8 + ((b2 >> 4) & 0x0f));
+                        pixel.g = (juce::uint8) (pixel.g + greenDifference);
+                        pixel.b = (juce::uint8) (pixel.b + greenDifference - 8 + (b2 & 0x0f));
+                    }
+                    else
+                    {
+                        run = b1 & 0x3f;
+                    }
+
+                    index[getQoiIndexPosition (pixel)] = pixel;
+                }
+
+                auto* destination = line + x * bitmap.pixelStride;
+
+                if (channels == 4)
+                {
+                    auto* argb = reinterpret_cast<juce::PixelARGB*> (destination);
+                    argb->setARGB (pixel.a, pixel.r, pixel.g, pixel.b);
+
+                    if (pixel.a != 255)
+                        argb->premultiply();
+                }
+                else
+                {
+                    reinterpret_cast<juce::PixelRGB*> (destination)->setARGB (255, pixel.r, pixel.g, pixel.b);
+                }
+            }
+        }
+
+        return image;
+    }
+
+    juce::MemoryBlock QoiImageFormat::encode (const juce::Image& image)
+    {
+        if (! image.isValid())
+            return {};
+
+        const auto hasAlpha = image.getFormat() != juce::Image::RGB;
+        const juce::Image::BitmapData bitmap (image, juce::Image::BitmapData::readOnly);
+
+        juce::MemoryOutputStream output ((size_t) (bitmap.width * bitmap.height * (hasAlpha ? 5 : 4)) + qoiHeaderSize + sizeof (qoiEndMarker));
+        output.write ("qoif", 4);
+        output.writeIntBigEndian (bitmap.width);
+        output.writeIntBigEndian (bitmap.height);
+        output.writeByte (hasAlpha ? 4 : 3);
+        output.writeByte (0); // sRGB with linear alpha
+
+        QoiPixel index[64] {};
+        QoiPixel previous;
+        int run = 0;
+        const auto lastPixel = bitmap.width * bitmap.height - 1;
+
+        for (int y = 0; y < bitmap.height; ++y)
+        {
+            for (int x = 0; x < bitmap.width; ++x)
+            {
+                // QOI stores straight (unpremultiplied) alpha
+                const auto colour = bitmap.getPixelColour (x, y);
+                const QoiPixel pixel { colour.getRed(), colour.getGreen(), colour.getBlue(), hasAlpha ? colour.getAlpha() : (juce::uint8) 255 };
+
+                if (pixel == previous)
+                {
+                    if (++run == 62 || y * bitmap.width + x == lastPixel)
+                    {
+                        output.writeByte ((char) (qoiOpRun | (run - 1)));
+                        run = 0;
+                    }
+
+                    continue;
+                }
+
+                if (run > 0)
+                {
+                    output.writeByte ((char) (qoiOpRun | (run - 1)));
+                    run = 0;
+                }
+
+                const auto indexPosition = getQoiIndexPosition (pixel);
+
+                if (index[indexPosition] == pixel)
+                {
+                    output.writeByte ((char) (qoiOpIndex | indexPosition));
+                }
+                else
+                {
+                    index[indexPosition] = pixel;
+
+                    if (pixel.a == previous.a)
+                    {
+                        const auto redDifference = (juce::int8) (pixel.r - previous.r);
+                        const auto greenDifference = (juce::int8) (pixel.g - previous.g);
+                        const auto blueDifference = (juce::int8) (pixel.b - previous.b);
+                        const auto redGreenDifference = redDifference - greenDifference;
+                        const auto blueGreenDifference = blueDifference - greenDifference;
+
+                        if (redDifference > -3 && redDifference < 2 && greenDifference > -3 && greenDifference < 2 && blueDifference > -3 && blueDifference < 2)
+                        {
+                            output.writeByte ((char) (qoiOpDiff | (redDifference + 2) << 4 | (greenDifference + 2) << 2 | (blueDifference + 2)));
+                        }
+                        else if (redGreenDifference > -9 && redGreenDifference < 8 && greenDifference > -33 && greenDifference < 32 && blueGreenDifference > -9 && blueGreenDifference < 8)
+                        {
+                            output.writeByte ((char) (qoiOpLuma | (greenDifference + 32)));
+                            output.writeByte ((char) ((redGreenDifference + 8) << 4 | (blueGreenDifference + 8)));
+                        }
+                        else
+                        {
+                            output.writeByte ((char) qoiOpRgb);
+                            output.writeByte ((char) pixel.r);
+                            output.writeByte ((char) pixel.g);
+                            output.writeByte ((char) pixel.b);
+                        }
+                    }
+                    else
+                    {
+                        output.writeByte ((char) qoiOpRgba);
+                        output.writeByte ((char) pixel.r);
+                        output.writeByte ((char) pixel.g);
+                        output.writeByte ((char) pixel.b);
+                        output.writeByte ((char) pixel.a);
+                    }
+                }
+
+                previous = pixel;
+            }
+        }
+
+        output.write (qoiEndMarker, sizeof (qoiEndMarker));
+        return output.getMemoryBlock();
+    }
+}
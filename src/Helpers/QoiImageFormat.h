@@ -0,0 +1,38 @@
+#pragma once
+
+namespace BogrenDigital::UILoading
+{
+    /**
+     * @brief Reads and writes QOI ("Quite OK Image") files.
+     *
+     * QOI is lossless like PNG but decodes several times faster, at a somewhat larger
+     * size. Every ImageLoader recognises QOI data by its "qoif" magic and decodes it
+     * here, whatever the asset's file name, so converted assets keep their names.
+     * See tools/QoiConverter.cpp.
+     *
+     * Decodes to ARGB (premultiplied, like all JUCE images) or, for 3-channel files, RGB.
+     */
+    class QoiImageFormat : public juce::ImageFileFormat
+    {
+    public:
+        QoiImageFormat() = default;
+
+        juce::String getFormatName() override { return "QOI"; }
+        bool canUnderstand (juce::InputStream& input) override;
+        bool usesFileExtension (const juce::File& file) override { return file.hasFileExtension ("qoi"); }
+        juce::Image decodeImage (juce::InputStream& input) override;
+        bool writeImageToStream (const juce::Image& sourceImage, juce::OutputStream& destStream) override;
+
+        /** @brief True if the data starts with a QOI header. */
+        static bool isQoi (const void* data, size_t numBytes) noexcept;
+
+        /** @brief Decodes QOI data; returns an invalid image if it's malformed. */
+        static juce::Image decode (const void* data, size_t numBytes);
+
+        /** @brief Encodes an image, with an alpha channel unless it's an RGB image. */
+        static juce::MemoryBlock encode (const juce::Image& image);
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (QoiImageFormat)
+    };
+}
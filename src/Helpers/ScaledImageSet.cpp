@@ -0,0 +1,180 @@
+#include "../../third_party/include/BS_thread_pool.hpp"
+
+namespace BogrenDigital::UILoading
+{
+    struct SharedLevelLoadingThreadPool
+    {
+        BS::thread_pool<> threadPool;
+
+        SharedLevelLoadingThreadPool()
+            : threadPool (static_cast<std::size_t> (juce::SystemStats::getNumCpus())) {}
+    };
+
+    static juce::SharedResourcePointer<SharedLevelLoadingThreadPool> levelLoadingThreadPool;
+
+    ScaledImageSet::~ScaledImageSet()
+    {
+        for (auto& level : levels)
+            if (level.loading.valid())
+                level.loading.wait();
+    }
+
+    ScaledImageSet::Level& ScaledImageSet::getLoadedLevel (Level& level, juce::Component& component)
+    {
+        if (level.isLoaded())
+            return level;
+
+        if (! level.loading.valid())
+            startLoading (level, component);
+
+        Level* smaller = nullptr;
+
+        for (auto& other : levels)
+        {
+            if (! other.isLoaded())
+                continue;
+
+            if (other.scale > level.scale)
+                return other;
+
+            smaller = &other;
+        }
+
+        return smaller != nullptr ? *smaller : level;
+    }
+
+    void ScaledImageSet::startLoading (Level& level, juce::Component& component)
+    {
+        BD_UI_TRACE_SCOPE ("ScaledImageSet::startLoading");
+
+        auto loaded = std::make_shared<std::promise<LevelImages>>();
+        level.loading = loaded->get_future();
+
+        // The promise is kept before the repaint is posted, so the repaint finds the images
+        levelLoadingThreadPool->threadPool.detach_task ([loaded, load = level.source.load, safeComponent = juce::Component::SafePointer<juce::Component> (&component)] {
+            try
+            {
+                loaded->set_value (load());
+            }
+            catch (...)
+            {
+                loaded->set_exception (std::current_exception());
+            }
+
+            juce::MessageManager::callAsync ([safeComponent] {
+                if (safeComponent != nullptr)
+                    safeComponent->repaint();
+            });
+        });
+    }
+
+    void ScaledImageSet::finishLoadingLevels()
+    {
+        for (auto& level : levels)
+        {
+            if (! level.loading.valid() || level.loading.wait_for (std::chrono::seconds (0)) != std::future_status::ready)
+                continue;
+
+            LevelImages loaded;
+
+            try
+            {
+                loaded = level.loading.get();
+            }
+            catch (...)
+            {
+                jassertfalse; // The source threw; the level is dropped below
+            }
+
+            for (const auto& image : loaded.images)
+                if (image.isValid())
+                    level.images.add (new juce::Image (image));
+
+            if (loaded.compressed != nullptr)
+                level.compressed = std::make_unique<CompressedFilmstrip::FrameCache> (std::move (loaded.compressed));
+
+            // Without images it can't be loaded again either, e.g. after its files were removed
+            if (! level.isLoaded())
+                level.source = {};
+        }
+
+        std::erase_if (levels, [] (const Level& level) {
+            return ! level.isLoaded() && level.source.load == nullptr;
+        });
+    }
+
+    void ScaledImageSet::releaseLevelsOtherThan (const Level& drawnLevel)
+    {
+        keptScale = drawnLevel.scale;
+
+        for (auto& level : levels)
+        {
+            if (&level == &drawnLevel || level.source.load == nullptr || ! level.isLoaded())
+                continue;
+
+            level.images.clear();
+            level.compressed = nullptr;
+            std::erase_if (resampledFrames, [scale = level.scale] (const ResampledFrame& frame) { return frame.scale == scale; });
+
+            if (level.source.release != nullptr)
+                level.source.release();
+        }
+    }
+
+    void ScaledImageSet::drawResampledFrame (juce::Graphics& g, Level& level, int imageIndex, juce::Rectangle<float> area)
+    {
+        const auto physicalScale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+        // Frames resampled for another size are never drawn again
+        std::erase_if (resampledFrames, [area, physicalScale] (const ResampledFrame& frame) {
+            return frame.area != area || frame.physicalScale != physicalScale;
+        });
+
+        auto cached = std::find_if (resampledFrames.begin(), resampledFrames.end(), [&level, imageIndex] (const ResampledFrame& frame) {
+            return frame.scale == level.scale && frame.index == imageIndex;
+        });
+
+        if (cached == resampledFrames.end())
+        {
+            const auto image = getFrame (level, imageIndex);
+
+            if (! image.isValid())
+                return;
+
+            const auto drawArea = ImageTrimming::getDrawArea (image, area);
+            const auto width = juce::jmax (1, juce::roundToInt (drawArea.getWidth() * physicalScale));
+            const auto height = juce::jmax (1, juce::roundToInt (drawArea.getHeight() * physicalScale));
+
+            // Already at the physical size, so there is nothing to resample
+            if (image.getWidth() == width && image.getHeight() == height)
+            {
+                drawImage (g, image, area);
+                return;
+            }
+
+            BD_UI_TRACE_SCOPE ("ScaledImageSet::resampleFrame");
+
+            juce::Image resampled (juce::Image::ARGB, width, height, true);
+
+            {
+                juce::Graphics resampledGraphics (resampled);
+                resampledGraphics.setImageResamplingQuality (juce::Graphics::highResamplingQuality);
+                resampledGraphics.drawImage (image, resampled.getBounds().toFloat(), juce::RectanglePlacement::stretchToFit);
+            }
+
+            resampledFrames.insert (resampledFrames.begin(), ResampledFrame { level.scale, imageIndex, area, physicalScale, drawArea, std::move (resampled) });
+
+            if (resampledFrames.size() > maxResampledFrames)
+                resampledFrames.pop_back();
+        }
+        else
+        {
+            std::rotate (resampledFrames.begin(), cached, std::next (cached));
+        }
+
+        // Bilinear, so a frame at a fractional position isn't shifted by up to half a pixel
+        const auto& frame = resampledFrames.front();
+        g.setImageResamplingQuality (juce::Graphics::mediumResamplingQuality);
+        g.drawImage (frame.image, frame.drawArea, juce::RectanglePlacement::stretchToFit);
+    }
+}
@@ -1,76 +1,228 @@
 #pragma once
 
+#include <future>
+
 namespace BogrenDigital::UILoading
 {
 
 /**
- * @brief Holds 1x and 2x image variants, selecting which to draw based on display scale.
+ * @brief Holds an image or filmstrip at several scales, drawing the one that fits the physical pixel size.
+ *
+ * At paint time, the area the component's images are drawn into is measured in
+ * physical pixels (including the display scale and any transforms), and the
+ * level with the smallest scale that still covers it is drawn, so images are
+ * only ever downsampled a little. Beyond the largest scale, the largest is
+ * drawn. A scale is relative to the 1x images, whose size matches the
+ * component's metadata width and height. Images are drawn with stretchToFit
+ * into the component's float bounds (stored in component properties by UILoader).
+ *
+ * Filmstrips may instead be held as CompressedFilmstrips, decoding only the
+ * frames being drawn. Frames cropped by ImageTrimming are placed where their
+ * pixels were in the untrimmed frame.
+ *
+ * A frame is resampled with high quality once per size: the last few frames
+ * drawn are kept at the physical size of their area and blitted on later
+ * paints, until the area or the display scale changes.
  *
- * At paint time, detects the component's display scale factor.
- * Scale > 1.0 draws from the 2x set; scale <= 1.0 draws from the 1x set.
- * Images are drawn with stretchToFit into the component's float bounds
- * (stored in component properties by UILoader).
+ * Scales given a LevelSource are released once the set has been drawn at another
+ * scale, so a display only keeps the images it needs; the 1x images are always kept.
+ * When a released scale is selected and loaded again, the scale drawn in the meantime
+ * is released in turn.
  */
 class ScaledImageSet
 {
 public:
+    /** @brief The images of one scale, as a LevelSource loads them. */
+    struct LevelImages
+    {
+        juce::Array<juce::Image> images;
+        std::shared_ptr<const CompressedFilmstrip> compressed;
+    };
+
+    /**
+     * @brief Where the images of a scale come from, so the set can let go of them and load them again.
+     *
+     * Should a released scale be selected later, e.g. on another display, it is loaded on a worker
+     * thread while the closest scale still held is drawn, and the component is repainted once it is there.
+     */
+    struct LevelSource
+    {
+        std::function<LevelImages()> load; // Called on a worker thread
+        std::function<void()> release;     // Drops the loader's cached copies; called on the message thread
+    };
+
+    /** Holds only the 1x images; add the other scales with addScale(). */
+    explicit ScaledImageSet (juce::OwnedArray<juce::Image>& images1xToUse)
+    {
+        addScale (1.0, images1xToUse);
+    }
+
     ScaledImageSet (juce::OwnedArray<juce::Image>& images1xToUse,
                     juce::OwnedArray<juce::Image>& images2xToUse)
+        : ScaledImageSet (images1xToUse)
     {
-        images1x.swapWith (images1xToUse);
-        images2x.swapWith (images2xToUse);
+        addScale (2.0, images2xToUse);
     }
 
     /** Single-image constructor for IMAGE components (Background, etc.) */
     ScaledImageSet (const juce::Image& image1x, const juce::Image& image2x)
     {
-        images1x.add (new juce::Image (image1x));
-        images2x.add (new juce::Image (image2x));
+        addScale (1.0, image1x);
+        addScale (2.0, image2x);
     }
 
-    void drawImage (juce::Graphics& g, int imageIndex, juce::Component& component)
+    /** Compressed filmstrip constructor; without a 2x filmstrip the 1x frames are drawn at every scale. */
+    ScaledImageSet (std::shared_ptr<const CompressedFilmstrip> frames1x,
+                    std::shared_ptr<const CompressedFilmstrip> frames2x)
     {
-        auto& imageSet = shouldUse2x (component) ? images2x : images1x;
+        addScale (1.0, std::move (frames1x));
+        addScale (2.0, std::move (frames2x));
+    }
+
+    /** Waits for the scales being loaded again, since their sources use the loader. */
+    ~ScaledImageSet();
 
-        if (imageIndex < 0 || imageIndex >= imageSet.size())
+    /** @brief Adds the images for a scale, taking them out of the array; empty arrays are ignored. */
+    void addScale (double scale, juce::OwnedArray<juce::Image>& images)
+    {
+        if (images.isEmpty())
             return;
 
-        auto* image = imageSet[imageIndex];
-        if (image == nullptr || ! image->isValid())
+        auto& level = insertLevel (scale);
+        level.images.swapWith (images);
+    }
+
+    void addScale (double scale, const juce::Image& image)
+    {
+        if (! image.isValid())
             return;
 
-        g.setImageResamplingQuality (juce::Graphics::highResamplingQuality);
-        g.drawImage (*image, getFloatRect (component), juce::RectanglePlacement::stretchToFit);
+        insertLevel (scale).images.add (new juce::Image (image));
     }
 
-    bool hasImages() const { return images1x.size() > 0; }
-    int size() const { return images1x.size(); }
+    void addScale (double scale, std::shared_ptr<const CompressedFilmstrip> frames)
+    {
+        if (frames == nullptr)
+            return;
 
-private:
-    static bool shouldUse2x (juce::Component& component)
+        insertLevel (scale).compressed = std::make_unique<CompressedFilmstrip::FrameCache> (std::move (frames));
+    }
+
+    /** @brief Lets the set release a scale other than 1x whenever another scale is drawn, see LevelSource. */
+    void setLevelSource (double scale, LevelSource source)
     {
-        auto& displays = juce::Desktop::getInstance().getDisplays();
+        jassert (scale != 1.0); // The 1x images are what is drawn while another scale loads
 
-        if (component.isShowing() && component.getScreenBounds().getWidth() > 0)
+        for (auto& level : levels)
+            if (level.scale == scale && scale != 1.0)
+                level.source = std::move (source);
+    }
+
+    /**
+     * @brief Draws a frame into the component's float bounds.
+     *
+     * Pass false for cacheResampledFrame when the caller caches what is drawn itself, e.g. the static layer.
+     */
+    void drawImage (juce::Graphics& g, int imageIndex, juce::Component& component, bool cacheResampledFrame = true)
+    {
+        finishLoadingLevels();
+
+        if (levels.empty())
+            return;
+
+        const auto area = getFloatRect (component);
+        auto& selected = selectLevel (g, component, area);
+        auto& level = getLoadedLevel (selected, component);
+        level.drawn = true;
+
+        // Only once the selected level is there, since the one standing in for it is drawn until then
+        if (&level == &selected && level.scale != keptScale)
+            releaseLevelsOtherThan (level);
+
+        if (cacheResampledFrame)
+            drawResampledFrame (g, level, imageIndex, area);
+        else
+            drawImage (g, getFrame (level, imageIndex), area);
+    }
+
+    bool hasImages() const { return size() > 0; }
+
+    int size() const
+    {
+        const auto* level = findLevel (1.0);
+
+        if (level == nullptr)
+            return 0;
+
+        return level->compressed != nullptr ? level->compressed->size() : level->images.size();
+    }
+
+    /** @brief The scales held, in ascending order. */
+    juce::Array<double> getScales() const
+    {
+        juce::Array<double> scales;
+
+        for (const auto& level : levels)
+            scales.add (level.scale);
+
+        return scales;
+    }
+
+    /** True if every image of every scale fully covers the area it is drawn into. */
+    bool isFullyOpaque() const
+    {
+        if (! hasImages())
+            return false;
+
+        for (const auto& level : levels)
         {
-            if (const auto* display = displays.getDisplayForPoint (component.getScreenBounds().getCentre()))
-                return display->scale > 1.0;
+            if (level.compressed != nullptr)
+                return false;
+
+            for (const auto* image : level.images)
+                if (image == nullptr || ! ImageAlphaAnalysis::isFullyOpaque (*image))
+                    return false;
         }
 
-        if (auto* topLevel = component.getTopLevelComponent())
+        return true;
+    }
+
+    /** Adds the 1x images as images, every other scale held as one of scaledImages and the resampled frames as caches. */
+    void getImagesForMemoryReport (MemoryReport::ComponentImages& report) const
+    {
+        for (const auto& frame : resampledFrames)
+            report.caches.add (frame.image);
+
+        for (const auto& level : levels)
         {
-            if (topLevel->isOnDesktop() && topLevel->getScreenBounds().getWidth() > 0)
+            if (level.compressed != nullptr)
+                level.compressed->getImagesForMemoryReport (report);
+
+            if (level.scale == 1.0)
             {
-                if (const auto* display = displays.getDisplayForPoint (topLevel->getScreenBounds().getCentre()))
-                    return display->scale > 1.0;
+                for (const auto* image : level.images)
+                    report.images.add (*image);
+
+                continue;
             }
-        }
 
-        // Default to 1x if we can't detect
-        return false;
+            if (! level.isLoaded())
+                continue;
+
+            auto& scaled = report.scaledImages.emplace_back();
+            scaled.scale = level.scale;
+            scaled.drawn = level.drawn;
+
+            for (const auto* image : level.images)
+                scaled.images.add (*image);
+
+            if (level.compressed != nullptr)
+                scaled.compressedBytes = level.compressed->getFilmstrip().getCompressedBytes();
+        }
     }
 
-    static juce::Rectangle<float> getFloatRect (juce::Component& component)
+    /** @brief The area a component's images are drawn into: the float bounds UILoader stores in its properties. */
+    static juce::Rectangle<float> getFloatRect (const juce::Component& component)
     {
         const auto& props = component.getProperties();
         if (props.contains ("floatX") && props.contains ("floatY")
@@ -85,8 +237,121 @@ private:
         return component.getLocalBounds().toFloat();
     }
 
-    juce::OwnedArray<juce::Image> images1x;
-    juce::OwnedArray<juce::Image> images2x;
+private:
+    struct Level
+    {
+        double scale = 1.0;
+        juce::OwnedArray<juce::Image> images;
+        std::unique_ptr<CompressedFilmstrip::FrameCache> compressed;
+        bool drawn = false;
+
+        LevelSource source;
+        std::future<LevelImages> loading; // Valid while a released level is loaded again
+
+        bool isLoaded() const { return ! images.isEmpty() || compressed != nullptr; }
+    };
+
+    /** @brief A frame resampled to the physical size of the area it was drawn into. */
+    struct ResampledFrame
+    {
+        double scale = 1.0; // Of the level it was resampled from
+        int index = -1;
+        juce::Rectangle<float> area;
+        float physicalScale = 1.0f;
+
+        juce::Rectangle<float> drawArea; // Where the frame's pixels go, see ImageTrimming
+        juce::Image image;
+    };
+
+    static constexpr size_t maxResampledFrames = 4;
+
+    /** Returns the level for a scale, replacing what it held, keeping the levels ordered by scale. */
+    Level& insertLevel (double scale)
+    {
+        jassert (scale > 0.0);
+
+        const auto position = std::lower_bound (levels.begin(), levels.end(), scale, [] (const Level& level, double value) {
+            return level.scale < value;
+        });
+
+        if (position != levels.end() && position->scale == scale)
+        {
+            if (position->loading.valid())
+                position->loading.wait();
+
+            std::erase_if (resampledFrames, [scale] (const ResampledFrame& frame) { return frame.scale == scale; });
+
+            *position = Level();
+            position->scale = scale;
+            return *position;
+        }
+
+        auto inserted = levels.emplace (position);
+        inserted->scale = scale;
+        return *inserted;
+    }
+
+    const Level* findLevel (double scale) const
+    {
+        for (const auto& level : levels)
+            if (level.scale == scale)
+                return &level;
+
+        return nullptr;
+    }
+
+    Level& selectLevel (juce::Graphics& g, juce::Component& component, juce::Rectangle<float> area)
+    {
+        const auto metadataWidth = static_cast<double> (static_cast<int> (component.getProperties()["width"]));
+        const auto physicalWidth = static_cast<double> (area.getWidth()) * static_cast<double> (g.getInternalContext().getPhysicalPixelScaleFactor());
+        const auto requiredScale = metadataWidth > 0.0 ? physicalWidth / metadataWidth : 1.0;
+
+        // The tolerance keeps rounding in the layout from skipping to the next scale up
+        for (auto& level : levels)
+            if (level.scale >= requiredScale * 0.995)
+                return level;
+
+        return levels.back();
+    }
+
+    /** Returns the level if it is loaded; otherwise starts loading it and returns the closest loaded one, preferably larger. */
+    Level& getLoadedLevel (Level& level, juce::Component& component);
+
+    /** Starts loading a released level on a worker thread, repainting the component once it is done. */
+    void startLoading (Level& level, juce::Component& component);
+
+    /** Takes over the levels that finished loading, dropping those that failed. */
+    void finishLoadingLevels();
+
+    void releaseLevelsOtherThan (const Level& drawnLevel);
+
+    /** Blits the frame resampled for this area and display scale, resampling it first if it isn't cached. */
+    void drawResampledFrame (juce::Graphics& g, Level& level, int imageIndex, juce::Rectangle<float> area);
+
+    /** A compressed frame's pixels are reused by the next call, so it must be drawn or copied right away. */
+    static juce::Image getFrame (Level& level, int imageIndex)
+    {
+        if (level.compressed != nullptr)
+            return level.compressed->getFrame (imageIndex);
+
+        if (imageIndex < 0 || imageIndex >= level.images.size() || level.images[imageIndex] == nullptr)
+            return {};
+
+        return *level.images[imageIndex];
+    }
+
+    static void drawImage (juce::Graphics& g, const juce::Image& image, juce::Rectangle<float> area)
+    {
+        if (! image.isValid())
+            return;
+
+        g.setImageResamplingQuality (juce::Graphics::highResamplingQuality);
+        g.drawImage (image, ImageTrimming::getDrawArea (image, area), juce::RectanglePlacement::stretchToFit);
+    }
+
+    std::vector<Level> levels; // Ordered by scale
+    std::vector<ResampledFrame> resampledFrames; // Most recently drawn first, all for the same area
+    double keptScale = 0.0; // Of the level the others were last released for; none before the first paint
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScaledImageSet)
 };
@@ -0,0 +1,181 @@
+namespace BogrenDigital::UILoading
+{
+    juce::Image SharedImagePool::getOrDecode (const void* encodedData, size_t numBytes, const std::function<juce::Image()>& decode)
+    {
+        if (encodedData == nullptr || numBytes == 0)
+            return decode();
+
+        const auto contentHash = hashBytes (encodedData, numBytes);
+        const auto checkHash = checkHashBytes (encodedData, numBytes);
+
+        {
+            const std::scoped_lock lock (mutex);
+
+            if (const auto it = images.find (contentHash); it != images.end() && it->second.hasEncodedData (numBytes, checkHash))
+                return it->second.image;
+        }
+
+        auto image = decode();
+
+        if (! image.isValid())
+            return image;
+
+        const auto pixelHash = hashPixels (image);
+        const std::scoped_lock lock (mutex);
+
+        // Another loader may have decoded the same bytes meanwhile: hand out the pooled copy and drop ours.
+        // Different bytes with the same hash keep their own, unpooled decode.
+        if (const auto it = images.find (contentHash); it != images.end())
+            return it->second.hasEncodedData (numBytes, checkHash) ? it->second.image : image;
+
+        if (const auto it = imagesByPixels.find (pixelHash); it != imagesByPixels.end())
+        {
+            if (const auto& pooled = images.at (it->second).image; havePixelsEqual (pooled, image))
+            {
+                image = pooled;
+                ++numPixelDuplicates;
+            }
+        }
+        else
+        {
+            imagesByPixels.emplace (pixelHash, contentHash);
+        }
+
+        images.emplace (contentHash, Entry { image, numBytes, checkHash, pixelHash });
+
+        // Sweep now and then rather than on every release, which the pool can't observe
+        if (++insertionsSinceSweep >= 64)
+            releaseUnusedImagesLocked();
+
+        return image;
+    }
+
+    void SharedImagePool::releaseUnusedImages()
+    {
+        const std::scoped_lock lock (mutex);
+        releaseUnusedImagesLocked();
+    }
+
+    void SharedImagePool::releaseUnusedImagesLocked()
+    {
+        insertionsSinceSweep = 0;
+
+        // Pixel duplicates are pooled under several keys, so an image is unused once the pool holds all its references
+        std::unordered_map<const juce::ImagePixelData*, int> poolReferences;
+
+        for (const auto& [key, entry] : images)
+            ++poolReferences[entry.image.getPixelData().get()];
+
+        for (auto it = images.begin(); it != images.end();)
+        {
+            // Looked up first: the pointer returned by getPixelData() holds a reference while it lives
+            const auto numPoolReferences = poolReferences[it->second.image.getPixelData().get()];
+
+            if (it->second.image.getReferenceCount() <= numPoolReferences)
+                it = images.erase (it);
+            else
+                ++it;
+        }
+
+        for (auto it = imagesByPixels.begin(); it != imagesByPixels.end();)
+        {
+            if (images.find (it->second) == images.end())
+                it = imagesByPixels.erase (it);
+            else
+                ++it;
+        }
+    }
+
+    size_t SharedImagePool::getNumPixelDuplicates() const
+    {
+        const std::scoped_lock lock (mutex);
+        return numPixelDuplicates;
+    }
+
+    size_t SharedImagePool::getNumImages() const
+    {
+        const std::scoped_lock lock (mutex);
+        return images.size();
+    }
+
+    namespace
+    {
+        // 8 bytes per step with murmur-style mixing: PNGs are megabytes, so a byte-wise hash would show up next to decoding
+        juce::uint64 hashBytesWith (const void* data, size_t numBytes, juce::uint64 seed, juce::uint64 multiplier1, juce::uint64 multiplier2) noexcept
+        {
+            const auto mix = [] (juce::uint64 k) noexcept {
+                k ^= k >> 33;
+                k *= 0xff51afd7ed558ccdULL;
+                k ^= k >> 33;
+                k *= 0xc4ceb9fe1a85ec53ULL;
+                k ^= k >> 33;
+                return k;
+            };
+
+            const auto* bytes = static_cast<const juce::uint8*> (data);
+            auto hash = seed ^ static_cast<juce::uint64> (numBytes);
+
+            size_t offset = 0;
+
+            for (; offset + sizeof (juce::uint64) <= numBytes; offset += sizeof (juce::uint64))
+            {
+                juce::uint64 chunk;
+                std::memcpy (&chunk, bytes + offset, sizeof (chunk));
+
+                chunk *= multiplier1;
+                chunk = (chunk << 31) | (chunk >> 33);
+                chunk *= multiplier2;
+
+                hash ^= chunk;
+                hash = ((hash << 27) | (hash >> 37)) * 5 + 0x52dce729;
+            }
+
+            juce::uint64 tail = 0;
+
+            for (size_t i = 0; offset + i < numBytes; ++i)
+                tail |= static_cast<juce::uint64> (bytes[offset + i]) << (8 * i);
+
+            return mix (hash ^ (tail * multiplier1));
+        }
+    }
+
+    juce::uint64 SharedImagePool::hashBytes (const void* data, size_t numBytes) noexcept
+    {
+        return hashBytesWith (data, numBytes, 0x9e3779b97f4a7c15ULL, 0x87c37b91114253d5ULL, 0x4cf5ad432745937fULL);
+    }
+
+    juce::uint64 SharedImagePool::checkHashBytes (const void* data, size_t numBytes) noexcept
+    {
+        return hashBytesWith (data, numBytes, 0xc2b2ae3d27d4eb4fULL, 0x165667b19e3779f9ULL, 0x85ebca77c2b2ae63ULL);
+    }
+
+    juce::uint64 SharedImagePool::hashPixels (const juce::Image& image)
+    {
+        const juce::Image::BitmapData bitmap (image, juce::Image::BitmapData::readOnly);
+        const auto rowBytes = (size_t) (bitmap.width * bitmap.pixelStride);
+
+        auto hash = (juce::uint64) image.getFormat() * 0x9e3779b97f4a7c15ULL
+                    ^ ((juce::uint64) (juce::uint32) bitmap.width << 32 | (juce::uint32) bitmap.height);
+
+        for (int y = 0; y < bitmap.height; ++y)
+            hash = hash * 0x100000001b3ULL ^ hashBytes (bitmap.getLinePointer (y), rowBytes);
+
+        return hash;
+    }
+
+    bool SharedImagePool::havePixelsEqual (const juce::Image& a, const juce::Image& b)
+    {
+        if (a.getFormat() != b.getFormat() || a.getBounds() != b.getBounds())
+            return false;
+
+        const juce::Image::BitmapData bitmapA (a, juce::Image::BitmapData::readOnly);
+        const juce::Image::BitmapData bitmapB (b, juce::Image::BitmapData::readOnly);
+        const auto rowBytes = (size_t) (bitmapA.width * bitmapA.pixelStride);
+
+        for (int y = 0; y < bitmapA.height; ++y)
+            if (std::memcmp (bitmapA.getLinePointer (y), bitmapB.getLinePointer (y), rowBytes) != 0)
+                return false;
+
+        return true;
+    }
+}
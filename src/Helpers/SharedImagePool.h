@@ -0,0 +1,84 @@
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+
+namespace BogrenDigital::UILoading
+{
+    /**
+     * @brief Process-wide pool of decoded images, addressed by the content of their encoded bytes.
+     *
+     * Every ImageLoader decodes through this pool, so identical files shipped by
+     * different plugins, under different names or from different sources are
+     * decoded once and share one set of pixels for as long as anything holds them.
+     * Obtain it via juce::SharedResourcePointer<SharedImagePool>: the pool lives
+     * as long as any loader does, and each pooled image is released once the pool
+     * holds its last reference (juce::Image pixel data is reference counted).
+     *
+     * Entries are found by a hash of the encoded bytes and then checked against their size
+     * and a second, independently seeded hash, so the pool keeps no copy of the encoded
+     * bytes and only a collision of both 64-bit hashes could hand out the wrong image.
+     *
+     * Freshly decoded images are also indexed by a hash of their pixels, so assets
+     * whose encoded bytes differ but decode to identical pixels (repeated filmstrip
+     * states, re-exported copies, a PNG and its QOI conversion) share one copy too.
+     */
+    class SharedImagePool
+    {
+    public:
+        SharedImagePool() = default;
+
+        /**
+         * @brief Returns the image decoded from these bytes, decoding only if no live copy exists.
+         *
+         * Thread-safe. The decode runs outside the pool's lock; invalid results are not pooled.
+         * If another pooled image has identical pixels, that one is returned instead of the decode.
+         */
+        juce::Image getOrDecode (const void* encodedData, size_t numBytes, const std::function<juce::Image()>& decode);
+
+        /** @brief Drops every pooled image nothing outside the pool references any more. */
+        void releaseUnusedImages();
+
+        /** @brief Number of distinct decoded images currently pooled. */
+        size_t getNumImages() const;
+
+        /** @brief Number of decodes that were replaced by a pooled image with identical pixels. */
+        size_t getNumPixelDuplicates() const;
+
+        /** @brief Fast 64-bit content hash of a byte range. */
+        static juce::uint64 hashBytes (const void* data, size_t numBytes) noexcept;
+
+        /** @brief Hash of an image's format, size and visible pixels, ignoring row padding. */
+        static juce::uint64 hashPixels (const juce::Image& image);
+
+        /** @brief True if both images have the same format, size and pixels. */
+        static bool havePixelsEqual (const juce::Image& a, const juce::Image& b);
+
+    private:
+        struct Entry
+        {
+            juce::Image image;
+            size_t numEncodedBytes = 0;
+            juce::uint64 checkHash = 0; // checkHashBytes() of the encoded bytes
+            juce::uint64 pixelHash = 0;
+
+            bool hasEncodedData (size_t numBytes, juce::uint64 checkHashOfData) const
+            {
+                return numEncodedBytes == numBytes && checkHash == checkHashOfData;
+            }
+        };
+
+        /** @brief A hash of a byte range independent of hashBytes(), with its own seed and multipliers. */
+        static juce::uint64 checkHashBytes (const void* data, size_t numBytes) noexcept;
+
+        void releaseUnusedImagesLocked();
+
+        mutable std::mutex mutex;
+        std::unordered_map<juce::uint64, Entry> images;             // By hash of the encoded bytes
+        std::unordered_map<juce::uint64, juce::uint64> imagesByPixels; // Pixel hash to a key of images
+        size_t numPixelDuplicates = 0;
+        int insertionsSinceSweep = 0;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedImagePool)
+    };
+}
@@ -0,0 +1,169 @@
+namespace BogrenDigital::UILoading
+{
+    std::atomic<bool> TraceRecorder::enabled { false };
+    std::atomic<TraceRecorder::Buffer*> TraceRecorder::buffer { nullptr };
+    std::mutex TraceRecorder::threadNamesMutex;
+    juce::StringArray TraceRecorder::threadNames;
+
+    void TraceRecorder::setEnabled (bool shouldBeEnabled, size_t numEvents)
+    {
+        // Never freed while the process runs, so writers on other threads can't see one go away
+        static std::vector<std::unique_ptr<Buffer>> ownedBuffers;
+        static std::mutex ownedBuffersMutex;
+
+        if (shouldBeEnabled)
+        {
+            const auto size = (size_t) juce::nextPowerOfTwo ((int) juce::jmax ((size_t) 2, numEvents));
+            const std::scoped_lock lock (ownedBuffersMutex);
+
+            if (ownedBuffers.empty() || ownedBuffers.back()->mask + 1 != size)
+            {
+                ownedBuffers.push_back (std::make_unique<Buffer> (size));
+                buffer.store (ownedBuffers.back().get(), std::memory_order_release);
+            }
+        }
+
+        enabled.store (shouldBeEnabled, std::memory_order_relaxed);
+    }
+
+    void TraceRecorder::clear()
+    {
+        if (auto* b = buffer.load (std::memory_order_acquire))
+        {
+            for (size_t i = 0; i <= b->mask; ++i)
+                b->events[i].sequence.store (0, std::memory_order_relaxed);
+
+            b->writeIndex.store (0, std::memory_order_release);
+        }
+    }
+
+    void TraceRecorder::addEvent (const char* name, const juce::String& detail, juce::int64 startTicks, juce::int64 endTicks) noexcept
+    {
+        auto* b = buffer.load (std::memory_order_acquire);
+
+        if (b == nullptr)
+            return;
+
+        const auto threadId = getCurrentThreadId();
+        const auto index = b->writeIndex.fetch_add (1, std::memory_order_relaxed);
+        auto& event = b->events[index & b->mask];
+
+        // Seqlock: readers skip the slot until its sequence matches the index again
+        event.sequence.store (0, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+
+        event.name = name;
+        detail.copyToUTF8 (event.detail, sizeof (event.detail));
+        event.startTicks = startTicks;
+        event.endTicks = endTicks;
+        event.threadId = threadId;
+
+        event.sequence.store (index + 1, std::memory_order_release);
+    }
+
+    juce::uint32 TraceRecorder::getCurrentThreadId()
+    {
+        thread_local juce::uint32 threadId = 0;
+
+        // Registered once per thread; every later event from it is lock-free
+        if (threadId == 0)
+        {
+            juce::String threadName;
+
+            if (juce::MessageManager::getInstanceWithoutCreating() != nullptr && juce::MessageManager::existsAndIsCurrentThread())
+                threadName = "Message thread";
+            else if (auto* thread = juce::Thread::getCurrentThread())
+                threadName = thread->getThreadName();
+
+            const std::scoped_lock lock (threadNamesMutex);
+            threadId = (juce::uint32) threadNames.size() + 1;
+            threadNames.add (threadName.isNotEmpty() ? threadName : "Worker thread " + juce::String (threadId));
+        }
+
+        return threadId;
+    }
+
+    juce::String TraceRecorder::getChromeTraceJson()
+    {
+        juce::Array<juce::var> traceEvents;
+        auto* b = buffer.load (std::memory_order_acquire);
+
+        if (b != nullptr)
+        {
+            const auto endIndex = b->writeIndex.load (std::memory_order_acquire);
+            const auto beginIndex = endIndex > b->mask + 1 ? endIndex - (b->mask + 1) : 0;
+            const auto ticksPerMicrosecond = (double) juce::Time::getHighResolutionTicksPerSecond() / 1.0e6;
+            std::optional<juce::int64> originTicks;
+
+            for (auto index = beginIndex; index < endIndex; ++index)
+            {
+                auto& slot = b->events[index & b->mask];
+
+                if (slot.sequence.load (std::memory_order_acquire) != index + 1)
+                    continue;
+
+                const auto name = slot.name;
+                const juce::String detail (juce::CharPointer_UTF8 (slot.detail));
+                const auto startTicks = slot.startTicks;
+                const auto endTicks = slot.endTicks;
+                const auto threadId = slot.threadId;
+
+                // Overwritten by a writer that lapped us while copying
+                std::atomic_thread_fence (std::memory_order_acquire);
+
+                if (slot.sequence.load (std::memory_order_relaxed) != index + 1)
+                    continue;
+
+                if (! originTicks.has_value())
+                    originTicks = startTicks;
+
+                auto* event = new juce::DynamicObject();
+                event->setProperty ("name", juce::String (name));
+                event->setProperty ("cat", "bd_ui_loader");
+                event->setProperty ("ph", "X");
+                event->setProperty ("ts", (double) (startTicks - *originTicks) / ticksPerMicrosecond);
+                event->setProperty ("dur", (double) (endTicks - startTicks) / ticksPerMicrosecond);
+                event->setProperty ("pid", 1);
+                event->setProperty ("tid", (int) threadId);
+
+                if (detail.isNotEmpty())
+                {
+                    auto* args = new juce::DynamicObject();
+                    args->setProperty ("detail", detail);
+                    event->setProperty ("args", juce::var (args));
+                }
+
+                traceEvents.add (juce::var (event));
+            }
+        }
+
+        {
+            const std::scoped_lock lock (threadNamesMutex);
+
+            for (int i = 0; i < threadNames.size(); ++i)
+            {
+                auto* args = new juce::DynamicObject();
+                args->setProperty ("name", threadNames[i]);
+
+                auto* event = new juce::DynamicObject();
+                event->setProperty ("name", "thread_name");
+                event->setProperty ("ph", "M");
+                event->setProperty ("pid", 1);
+                event->setProperty ("tid", i + 1);
+                event->setProperty ("args", juce::var (args));
+                traceEvents.add (juce::var (event));
+            }
+        }
+
+        auto* root = new juce::DynamicObject();
+        root->setProperty ("traceEvents", traceEvents);
+        root->setProperty ("displayTimeUnit", "ms");
+
+        return juce::JSON::toString (juce::var (root));
+    }
+
+    bool TraceRecorder::writeChromeTrace (const juce::File& file)
+    {
+        return file.replaceWithText (getChromeTraceJson());
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace BogrenDigital::UILoading
+{
+    /**
+     * @brief Process-wide recorder of timed scopes, exportable as Chrome trace JSON.
+     *
+     * Scopes are added with BD_UI_TRACE_SCOPE() around loading, decoding, layout and
+     * painting. While recording is off a scope costs one relaxed atomic load. While on,
+     * completed scopes are written to a fixed-size ring buffer without locking, from any
+     * thread; once it is full the oldest events are overwritten.
+     *
+     * The JSON loads in chrome://tracing and https://ui.perfetto.dev, with one track per
+     * thread, which shows how busy the decode and preparation pools are while an editor opens.
+     */
+    class TraceRecorder
+    {
+    public:
+        /**
+         * @brief Starts or stops recording into a buffer of numEvents slots, rounded up to a power of two.
+         *
+         * Starting with another size than the current buffer's starts a new, empty one. The
+         * previous buffer stays allocated, as threads may still be writing to it.
+         */
+        static void setEnabled (bool shouldBeEnabled, size_t numEvents = 1 << 16);
+
+        static bool isEnabled() noexcept { return enabled.load (std::memory_order_relaxed); }
+
+        /** @brief Discards every recorded event. Call while not recording. */
+        static void clear();
+
+        /** @brief The recorded events, oldest first, as Chrome trace event format JSON. */
+        static juce::String getChromeTraceJson();
+
+        /** @brief Writes getChromeTraceJson() to a file; returns false if it can't be written. */
+        static bool writeChromeTrace (const juce::File& file);
+
+        /** @brief Records a completed scope; normally called by TraceScope. */
+        static void addEvent (const char* name, const juce::String& detail, juce::int64 startTicks, juce::int64 endTicks) noexcept;
+
+    private:
+        struct Event
+        {
+            std::atomic<juce::uint64> sequence { 0 }; // Index of the event + 1 once written, 0 while being written
+            const char* name = nullptr;
+            char detail[64] {};
+            juce::int64 startTicks = 0;
+            juce::int64 endTicks = 0;
+            juce::uint32 threadId = 0;
+        };
+
+        struct Buffer
+        {
+            explicit Buffer (size_t numEvents) : events (new Event[numEvents]), mask (numEvents - 1) {}
+
+            std::unique_ptr<Event[]> events;
+            const size_t mask;
+            std::atomic<juce::uint64> writeIndex { 0 };
+        };
+
+        static juce::uint32 getCurrentThreadId();
+
+        static std::atomic<bool> enabled;
+        static std::atomic<Buffer*> buffer;
+        static std::mutex threadNamesMutex;
+        static juce::StringArray threadNames; // Indexed by thread id - 1
+    };
+
+    /** @brief Times the enclosing scope into the TraceRecorder; use via BD_UI_TRACE_SCOPE(). */
+    class TraceScope
+    {
+    public:
+        explicit TraceScope (const char* nameToUse) noexcept
+            : name (TraceRecorder::isEnabled() ? nameToUse : nullptr),
+              startTicks (name != nullptr ? juce::Time::getHighResolutionTicks() : 0)
+        {
+        }
+
+        /** @brief The detail (e.g. a file or component name) is only evaluated while recording. */
+        template <typename DetailFunction>
+        TraceScope (const char* nameToUse, DetailFunction&& getDetail)
+            : TraceScope (nameToUse)
+        {
+            if (name != nullptr)
+                detail = getDetail();
+        }
+
+        ~TraceScope()
+        {
+            if (name != nullptr)
+                TraceRecorder::addEvent (name, detail, startTicks, juce::Time::getHighResolutionTicks());
+        }
+
+    private:
+        const char* name;
+        juce::int64 startTicks;
+        juce::String detail;
+
+        JUCE_DECLARE_NON_COPYABLE (TraceScope)
+    };
+}
+
+#if BD_UI_LOADER_ENABLE_TRACING
+    /** Records the enclosing scope under a string literal name. */
+    #define BD_UI_TRACE_SCOPE(name) \
+        const BogrenDigital::UILoading::TraceScope JUCE_JOIN_MACRO (bdUiTraceScope_, __LINE__) (name)
+
+    /** Records the enclosing scope with a detail string, which is only evaluated while recording. */
+    #define BD_UI_TRACE_SCOPE_DETAILED(name, detail) \
+        const BogrenDigital::UILoading::TraceScope JUCE_JOIN_MACRO (bdUiTraceScope_, __LINE__) (name, [&] { return juce::String (detail); })
+#else
+    #define BD_UI_TRACE_SCOPE(name)
+    #define BD_UI_TRACE_SCOPE_DETAILED(name, detail)
+#endif
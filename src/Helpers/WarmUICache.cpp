@@ -0,0 +1,101 @@
+namespace BogrenDigital::UILoading
+{
+    JUCE_IMPLEMENT_SINGLETON (WarmUICache)
+
+    WarmUICache::~WarmUICache()
+    {
+        clearSingletonInstance();
+    }
+
+    std::shared_ptr<WarmUIPlan> WarmUICache::acquire (const ImageLoader& imageLoader, const juce::String& xmlFileName, const juce::String& xmlContent)
+    {
+        JUCE_ASSERT_MESSAGE_THREAD
+
+        const auto sourceIdentifier = imageLoader.getAssetSourceIdentifier();
+        const auto key = sourceIdentifier + "|" + xmlFileName;
+        const auto cacheable = sourceIdentifier.isNotEmpty() && timeToLive > juce::RelativeTime();
+
+        if (cacheable)
+        {
+            if (const auto it = plans.find (key); it != plans.end() && it->second->xmlContent == xmlContent)
+                return it->second;
+        }
+
+        BD_UI_TRACE_SCOPE_DETAILED ("WarmUICache::parse", xmlFileName);
+
+        auto document = juce::parseXML (xmlContent);
+
+        if (document == nullptr)
+            return nullptr;
+
+        auto plan = std::make_shared<WarmUIPlan>();
+        plan->xmlContent = xmlContent;
+
+        UILoader::collectElements (*document, plan->elements, plan->containers);
+
+        for (const auto* element : plan->elements)
+            plan->metadata.push_back (UILoader::parseElement (element));
+
+        plan->document = std::move (document);
+        plan->retainedImages = imageLoader.getSharedDecodedImageCache();
+
+        if (cacheable)
+        {
+            plans[key] = plan;
+            startTimer (1000);
+        }
+
+        return plan;
+    }
+
+    void WarmUICache::release (std::shared_ptr<WarmUIPlan> plan, std::shared_ptr<DecodedImageCache> imagesToRetain)
+    {
+        JUCE_ASSERT_MESSAGE_THREAD
+
+        if (plan == nullptr)
+            return;
+
+        // Retain the cache of the loader that used the plan last: it references every image the UI needs
+        if (imagesToRetain != nullptr)
+            plan->retainedImages = std::move (imagesToRetain);
+
+        plan->releaseTime = juce::Time::getCurrentTime();
+    }
+
+    void WarmUICache::setTimeToLive (juce::RelativeTime newTimeToLive)
+    {
+        JUCE_ASSERT_MESSAGE_THREAD
+
+        timeToLive = newTimeToLive;
+        expirePlans (juce::Time::getCurrentTime());
+    }
+
+    void WarmUICache::clear()
+    {
+        JUCE_ASSERT_MESSAGE_THREAD
+
+        expirePlans (juce::Time::getCurrentTime() + timeToLive);
+    }
+
+    void WarmUICache::timerCallback()
+    {
+        expirePlans (juce::Time::getCurrentTime());
+    }
+
+    void WarmUICache::expirePlans (juce::Time now)
+    {
+        for (auto it = plans.begin(); it != plans.end();)
+        {
+            // Only the cache holds it, so no UILoader is using the plan any more
+            const auto isUnused = it->second.use_count() == 1;
+
+            if (isUnused && it->second->releaseTime + timeToLive <= now)
+                it = plans.erase (it);
+            else
+                ++it;
+        }
+
+        if (plans.empty())
+            stopTimer();
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <map>
+
+namespace BogrenDigital::UILoading
+{
+    /** @brief A parsed UI description plus the decoded images retained on its behalf. */
+    struct WarmUIPlan
+    {
+        juce::String xmlContent;
+        std::unique_ptr<const juce::XmlElement> document;
+        std::vector<const juce::XmlElement*> elements;     // Every element of document, CONTAINER contents after their container
+        std::vector<int> containers;                       // Per element, the index of the CONTAINER it is in, or -1
+        std::vector<UILoader::ComponentMetadata> metadata; // One per element
+        std::shared_ptr<DecodedImageCache> retainedImages;
+        juce::Time releaseTime;
+    };
+
+    /**
+     * @brief Process-level cache that keeps a loaded UI warm between editor instances.
+     *
+     * Hosts destroy and recreate the plugin editor every time its window is closed
+     * and reopened. Once a time to live is set, this cache keeps each UI's parsed
+     * metadata (the component plan) and the decoded images of its last loader alive
+     * for that long after the UILoader using them is destroyed. A reopen within that
+     * time skips XML parsing, and every image decode resolves from the SharedImagePool.
+     * The XML is still read to check it is unchanged, and the factories still prepare
+     * every component from the retained images.
+     *
+     * Retained images use their full decoded size in memory while the editor is
+     * closed, so warm reopening is disabled until setTimeToLive() is called.
+     *
+     * Plans are keyed by the loader's asset source identifier and the XML file
+     * name, and only reused while the XML content is unchanged. Loaders without
+     * a source identifier are never cached. Message thread only.
+     */
+    class WarmUICache : private juce::Timer,
+                        private juce::DeletedAtShutdown
+    {
+    public:
+        ~WarmUICache() override;
+
+        /**
+         * @brief Returns the plan for this UI, reusing a warm one if the XML is unchanged.
+         *
+         * Returns nullptr if the XML can't be parsed.
+         */
+        std::shared_ptr<WarmUIPlan> acquire (const ImageLoader& imageLoader, const juce::String& xmlFileName, const juce::String& xmlContent);
+
+        /**
+         * @brief Hands a plan back when its UILoader goes away.
+         *
+         * The plan (and the images the loader decoded) stay alive for the time to live.
+         */
+        void release (std::shared_ptr<WarmUIPlan> plan, std::shared_ptr<DecodedImageCache> imagesToRetain);
+
+        /** @brief How long released plans are kept; zero (the default) disables warm reopening. */
+        void setTimeToLive (juce::RelativeTime newTimeToLive);
+        juce::RelativeTime getTimeToLive() const { return timeToLive; }
+
+        /** @brief Drops every plan no UILoader currently uses. */
+        void clear();
+
+        JUCE_DECLARE_SINGLETON_SINGLETHREADED_MINIMAL (WarmUICache)
+
+    private:
+        WarmUICache() = default;
+
+        void timerCallback() override;
+        void expirePlans (juce::Time now);
+
+        std::map<juce::String, std::shared_ptr<WarmUIPlan>> plans;
+        juce::RelativeTime timeToLive;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WarmUICache)
+    };
+}
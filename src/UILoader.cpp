@@ -1,5 +1,60 @@
+#include "../third_party/include/BS_thread_pool.hpp"
+
 namespace BogrenDigital::UILoading
 {
+    /**
+     * @brief Worker threads that prepare component blueprints.
+     *
+     * Separate from the image loaders' pools: a prepare task waits for the
+     * filmstrip frames it loads through those, which must never happen on
+     * the pool that runs the frame tasks.
+     */
+    struct SharedComponentPreparationThreadPool
+    {
+        BS::thread_pool<> threadPool;
+
+        SharedComponentPreparationThreadPool()
+            : threadPool (static_cast<std::size_t> (juce::SystemStats::getNumCpus())) {}
+    };
+
+    static juce::SharedResourcePointer<SharedComponentPreparationThreadPool> componentPreparationThreadPool;
+
+    /** @brief Waits for the blueprints still being prepared when it goes out of scope, even while an exception unwinds. */
+    struct PendingBlueprints
+    {
+        std::vector<std::future<std::unique_ptr<const ComponentBlueprint>>>& blueprints;
+
+        ~PendingBlueprints()
+        {
+            for (auto& blueprint : blueprints)
+                if (blueprint.valid())
+                    blueprint.wait();
+        }
+    };
+
+    /** @brief A GROUP or PAGE element and, once shown, the components built from its children. */
+    struct UILoader::DeferredGroup
+    {
+        std::unique_ptr<const juce::XmlElement> element; // Copied, so it outlives the document it came from
+        std::vector<const juce::XmlElement*> elements;   // Its contents, as collected by collectElements()
+        std::vector<int> containers;
+        std::vector<ComponentMetadata> metadata;         // One per element
+        juce::OwnedArray<juce::Component> components;
+        bool visible = false;
+        bool built = false;
+
+        // While building; a build whose generation is no longer current was abandoned
+        bool building = false;
+        int buildGeneration = 0;
+        std::vector<ComponentFactory*> factories;
+        std::vector<std::future<std::unique_ptr<const ComponentBlueprint>>> blueprints;
+        std::vector<std::function<void()>> onShownCallbacks;
+    };
+
+    static double getMillisecondsSince (juce::int64 startTicks)
+    {
+        return juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - startTicks) * 1000.0;
+    }
 
     class AspectRatioListener : public juce::ComponentListener
     {
@@ -34,13 +89,20 @@ namespace BogrenDigital::UILoading
             double aspectRatio = bitmapLayout.getAspectRatio();
 
             // Create and attach the listener to maintain aspect ratio during resizes
+            if (aspectRatioListener != nullptr)
+                parentComponent.removeComponentListener (aspectRatioListener.get());
+
             aspectRatioListener = std::make_unique<AspectRatioListener> (aspectRatio);
             parentComponent.addComponentListener (aspectRatioListener.get());
         }
     }
 
     UILoader::UILoader (juce::Component& parent, ImageLoader& imgLoader)
-        : parentComponent (parent), imageLoader (imgLoader), componentFactoryRegistry (std::make_unique<ComponentFactoryRegistry>())
+        : parentComponent (parent),
+          imageLoader (imgLoader),
+          staticLayer (std::make_unique<StaticLayerComponent>()),
+          loadReport (std::make_unique<LoadReport>()),
+          componentFactoryRegistry (std::make_unique<ComponentFactoryRegistry>())
     {
         registerComponentFactories();
     }
@@ -49,6 +111,8 @@ namespace BogrenDigital::UILoading
         : parentComponent (parent),
           ownedImageLoader (std::make_unique<FileAssetImageLoader> (assetDirectory)),
           imageLoader (*ownedImageLoader),
+          staticLayer (std::make_unique<StaticLayerComponent>()),
+          loadReport (std::make_unique<LoadReport>()),
           componentFactoryRegistry (std::make_unique<ComponentFactoryRegistry>())
     {
         registerComponentFactories();
@@ -56,18 +120,211 @@ namespace BogrenDigital::UILoading
 
     UILoader::~UILoader()
     {
+        assetFileWatcher = nullptr;
+        paintProfilerOverlay = nullptr;
+
+        // Preparations still running use the factories, which go away with this loader
+        for (auto& [name, group] : deferredGroups)
+            abandonPreparations (*group);
+
+        for (auto& preparation : abandonedPreparations)
+            preparation.wait();
+
         if (aspectRatioListener != nullptr)
         {
             parentComponent.removeComponentListener (aspectRatioListener.get());
         }
+
+        parentComponent.removeChildComponent (staticLayer.get());
+
+        releaseWarmPlan();
     }
 
     void UILoader::loadUI (const juce::String& xmlFileName)
     {
-        const auto xmlContent = imageLoader.getStringFromAsset (xmlFileName);
-        parseXML (xmlContent);
+        BD_UI_TRACE_SCOPE_DETAILED ("UILoader::loadUI", xmlFileName);
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+
+        // Only a load that builds every component asks for every asset
+        std::unique_ptr<PrefetchManifest::Recorder> accessRecorder;
+
+        if (prefetchManifestFile != juce::File() && components.isEmpty())
+            accessRecorder = std::make_unique<PrefetchManifest::Recorder>();
+
+        loadedXmlFileName = xmlFileName;
+
+        if (loadReportEnabled)
+            *loadReport = {};
+
+        const auto loaded = [this, &accessRecorder] {
+            const PrefetchManifest::Recorder::ScopedActivation activation (accessRecorder.get());
+            return updateFromXML ({});
+        }();
+
+        if (accessRecorder != nullptr)
+        {
+            if (const auto manifest = accessRecorder->getManifest(); loaded && ! manifest.isEmpty())
+                manifest.saveTo (prefetchManifestFile);
+        }
+
         applyProportionalResize();
         applyLayout();
+
+        if (loadReportEnabled && loaded)
+        {
+            loadReport->xmlFileName = xmlFileName;
+            loadReport->totalMilliseconds = getMillisecondsSince (startTicks);
+        }
+    }
+
+    void UILoader::reloadUI (const juce::StringArray& changedAssets)
+    {
+        if (loadedXmlFileName.isEmpty())
+            return;
+
+        BD_UI_TRACE_SCOPE_DETAILED ("UILoader::reloadUI", loadedXmlFileName);
+
+        if (auto* fileAssetImageLoader = dynamic_cast<FileAssetImageLoader*> (&imageLoader))
+        {
+            for (const auto& asset : changedAssets)
+                fileAssetImageLoader->invalidateCachedImage (asset);
+        }
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        const auto previousWidth = bitmapLayout.width;
+        const auto previousHeight = bitmapLayout.height;
+
+        // A reload that fails leaves an empty report rather than the previous one
+        if (loadReportEnabled)
+            *loadReport = {};
+
+        // Keep the current UI while the XML is mid-edit or malformed
+        if (! updateFromXML (changedAssets))
+            return;
+
+        if (bitmapLayout.width != previousWidth || bitmapLayout.height != previousHeight)
+            applyProportionalResize();
+
+        applyLayout();
+
+        if (loadReportEnabled)
+        {
+            loadReport->xmlFileName = loadedXmlFileName;
+            loadReport->totalMilliseconds = getMillisecondsSince (startTicks);
+        }
+    }
+
+    void UILoader::setLoadReportEnabled (bool shouldBeEnabled)
+    {
+        loadReportEnabled = shouldBeEnabled;
+
+        if (! loadReportEnabled)
+            *loadReport = {};
+    }
+
+    const LoadReport& UILoader::getLoadReport() const
+    {
+        return *loadReport;
+    }
+
+    MemoryReport UILoader::getMemoryReport() const
+    {
+        std::vector<MemoryReport::Entry> entries;
+
+        const auto addEntry = [&entries] (const juce::Component* component) {
+            auto& entry = entries.emplace_back();
+            entry.name = component->getProperties()["name"].toString();
+            entry.type = component->getProperties()["type"].toString();
+
+            if (auto* provider = dynamic_cast<const ImageMemoryProvider*> (component))
+                provider->getImagesForMemoryReport (entry.images);
+        };
+
+        for (auto* component : components)
+            addEntry (component);
+
+        for (const auto& [name, group] : deferredGroups)
+            for (auto* component : group->components)
+                addEntry (component);
+
+        auto& staticLayerEntry = entries.emplace_back();
+        staticLayerEntry.name = "Static layer";
+        staticLayerEntry.type = "STATIC_LAYER";
+        staticLayer->getImagesForMemoryReport (staticLayerEntry.images);
+
+        return MemoryReport::create (entries);
+    }
+
+    void UILoader::setPaintProfilerEnabled (bool shouldBeEnabled)
+    {
+        if (! shouldBeEnabled)
+            paintProfilerOverlay = nullptr;
+        else if (paintProfilerOverlay == nullptr)
+            paintProfilerOverlay = std::make_unique<PaintProfilerOverlay> (parentComponent);
+    }
+
+    void UILoader::setHotReloadEnabled (bool shouldBeEnabled)
+    {
+        if (! shouldBeEnabled)
+        {
+            assetFileWatcher = nullptr;
+            return;
+        }
+
+        auto* fileAssetImageLoader = dynamic_cast<FileAssetImageLoader*> (&imageLoader);
+
+        if (fileAssetImageLoader == nullptr)
+        {
+            jassertfalse; // Hot reload needs assets on disk
+            return;
+        }
+
+        if (assetFileWatcher == nullptr)
+        {
+            assetFileWatcher = std::make_unique<AssetFileWatcher> (fileAssetImageLoader->getAssetDirectory(), [this] (const juce::StringArray& changedFiles) {
+                reloadUI (changedFiles);
+            });
+
+            assetFileWatcher->startWatching();
+        }
+    }
+
+    bool UILoader::updateFromXML (const juce::StringArray& changedAssets)
+    {
+        const auto xmlContent = imageLoader.getStringFromAsset (loadedXmlFileName);
+
+        // Acquire before releasing the previous plan so a reload of the same UI keeps its images alive
+        auto plan = WarmUICache::getInstance()->acquire (imageLoader, loadedXmlFileName, xmlContent);
+
+        if (plan == nullptr)
+            return false;
+
+        // The previous document stays alive until its components have been diffed against the new one
+        const auto previousPlan = std::exchange (warmPlan, std::move (plan));
+        const auto previousPlanImages = std::exchange (warmPlanImages, imageLoader.getSharedDecodedImageCache());
+
+        parseXML (*warmPlan, previousPlan.get(), changedAssets);
+        updateDeferredGroups (*warmPlan->document, changedAssets);
+
+        if (previousPlan != nullptr && previousPlan != warmPlan)
+            WarmUICache::getInstance()->release (previousPlan, previousPlanImages);
+
+        return true;
+    }
+
+    void UILoader::releaseWarmPlan()
+    {
+        // At shutdown the cache may already be gone; getInstance() would recreate and leak it
+        if (auto* warmCache = WarmUICache::getInstanceWithoutCreating(); warmCache != nullptr && warmPlan != nullptr)
+            warmCache->release (std::move (warmPlan), std::move (warmPlanImages));
+
+        warmPlan = nullptr;
+        warmPlanImages = nullptr;
+    }
+
+    void UILoader::setWarmCacheTimeToLive (juce::RelativeTime timeToLive)
+    {
+        WarmUICache::getInstance()->setTimeToLive (timeToLive);
     }
 
     UILoader::ComponentMetadata UILoader::parseElement (const juce::XmlElement* element)
@@ -92,57 +349,952 @@ namespace BogrenDigital::UILoading
             metadata.y = metadata.minY;
         }
 
+        // Scale variants besides 2x, whose attributes are fields: file1.5x="Knob@1.5x.png", fileNameSuffix3x="@3x.png"
+        for (int i = 0; i < element->getNumAttributes(); ++i)
+        {
+            const auto attribute = element->getAttributeName (i);
+            const juce::String prefix = attribute.startsWith ("fileNameSuffix") ? "fileNameSuffix" : "file";
+
+            if (! attribute.startsWith (prefix) || ! attribute.endsWithChar ('x'))
+                continue;
+
+            // Exporters that only write identifier-like names can use file1_5x for file1.5x
+            const auto scaleText = attribute.substring (prefix.length(), attribute.length() - 1).replaceCharacter ('_', '.');
+
+            if (scaleText.isEmpty() || ! scaleText.containsOnly ("0123456789."))
+                continue;
+
+            const auto scale = scaleText.getDoubleValue();
+
+            if (scale <= 0.0 || scale == 1.0 || scale == 2.0)
+                continue;
+
+            auto variant = std::find_if (metadata.scaleVariants.begin(), metadata.scaleVariants.end(), [scale] (const ScaleVariant& v) {
+                return v.scale == scale;
+            });
+
+            if (variant == metadata.scaleVariants.end())
+                variant = metadata.scaleVariants.insert (metadata.scaleVariants.end(), ScaleVariant { scale, {}, {} });
+
+            (prefix == "file" ? variant->file : variant->fileNameSuffix) = element->getStringAttribute (attribute);
+        }
+
         return metadata;
     }
 
 // Clean up the macro now that we're done with it
 #undef COMPONENT_METADATA_FIELDS
 
-    void UILoader::parseXML (const juce::String& xmlContent)
+    bool UILoader::isContainerElement (const juce::XmlElement& element)
     {
-        auto xmlDocument = juce::parseXML (xmlContent);
+        return element.hasTagName ("CONTAINER");
+    }
 
-        if (xmlDocument != nullptr)
+    void UILoader::collectElements (const juce::XmlElement& parent,
+                                    std::vector<const juce::XmlElement*>& elements,
+                                    std::vector<int>& containers,
+                                    int containerIndex)
+    {
+        for (const auto* element : parent.getChildIterator())
         {
-            components.clear();
-            componentsByName.clear();
+            const auto index = static_cast<int> (elements.size());
+            elements.push_back (element);
+            containers.push_back (containerIndex);
 
-            bitmapLayout.setDimensions (
-                xmlDocument->getIntAttribute ("width", 0),
-                xmlDocument->getIntAttribute ("height", 0));
+            if (isContainerElement (*element))
+                collectElements (*element, elements, containers, index);
+        }
+    }
 
-            for (auto* element : xmlDocument->getChildIterator())
-            {
-                const auto name = element->getStringAttribute ("name", "");
+    void UILoader::parseXML (const WarmUIPlan& plan,
+                             const WarmUIPlan* previousPlan,
+                             const juce::StringArray& changedAssets)
+    {
+        BD_UI_TRACE_SCOPE ("UILoader::parseXML");
+
+        staticLayer->setLayerComponents ({});
+
+        // Take the current components out of the tree's bookkeeping; whatever isn't reused is destroyed at the end
+        std::unordered_map<juce::String, std::unique_ptr<juce::Component>> previousComponents;
 
-                if (componentsByName.contains (name))
+        while (! components.isEmpty())
+        {
+            std::unique_ptr<juce::Component> component (components.removeAndReturn (components.size() - 1));
+            const auto name = component->getProperties()["name"].toString();
+            previousComponents[name] = std::move (component);
+        }
+
+        componentsByName.clear();
+
+        std::unordered_map<juce::String, const juce::XmlElement*> previousElements;
+
+        if (previousPlan != nullptr)
+        {
+            for (const auto* element : previousPlan->elements)
+                previousElements.try_emplace (element->getStringAttribute ("name", ""), element);
+        }
+
+        bitmapLayout.setDimensions (
+            plan.document->getIntAttribute ("width", 0),
+            plan.document->getIntAttribute ("height", 0));
+
+        const auto& elements = plan.elements;
+        const auto& metadataList = plan.metadata;
+        jassert (metadataList.size() == elements.size() && plan.containers.size() == elements.size());
+
+        // Decide up front what survives, so owners can let go of the others while they still exist
+        enum class ElementAction { reuse, create, skip };
+
+        std::vector<ElementAction> elementActions;
+        std::unordered_set<juce::String> seenNames;
+        std::unordered_set<juce::String> reusedNames;
+
+        for (size_t index = 0; index < elements.size(); ++index)
+        {
+            const auto& element = *elements[index];
+            const auto& metadata = metadataList[index];
+            const auto container = plan.containers[index];
+
+            // Groups are built on demand by showGroup(), and the contents of a skipped container have nowhere to go
+            if (isGroupElement (element) || (container >= 0 && elementActions[(size_t) container] == ElementAction::skip))
+            {
+                if (isGroupElement (element) && container >= 0)
                 {
-                    jassertfalse; // Duplicate component name detected
-                    juce::Logger::writeToLog ("Duplicate component name detected: " + name + " - skipping component");
-                    continue;
+                    jassertfalse; // GROUP inside CONTAINER not supported
+                    juce::Logger::writeToLog ("GROUP inside CONTAINER not supported: " + metadata.name + " - skipping group");
                 }
 
-                if (auto* factory = componentFactoryRegistry->getFactory (element, this); factory != nullptr)
+                elementActions.push_back (ElementAction::skip);
+                continue;
+            }
+
+            if (! seenNames.insert (metadata.name).second)
+            {
+                jassertfalse; // Duplicate component name detected
+                juce::Logger::writeToLog ("Duplicate component name detected: " + metadata.name + " - skipping component");
+                elementActions.push_back (ElementAction::skip);
+                continue;
+            }
+
+            const auto previousComponent = previousComponents.find (metadata.name);
+            const auto previousElement = previousElements.find (metadata.name);
+
+            // Containers hold nothing but their children, which are diffed on their own
+            const auto reuse = previousComponent != previousComponents.end()
+                               && (isContainerElement (element)
+                                       ? dynamic_cast<ContainerComponent*> (previousComponent->second.get()) != nullptr
+                                       : previousElement != previousElements.end()
+                                             && canReuseComponent (*previousElement->second, element, metadata, changedAssets));
+
+            elementActions.push_back (reuse ? ElementAction::reuse : ElementAction::create);
+
+            if (reuse)
+                reusedNames.insert (metadata.name);
+        }
+
+        // Factories are created lazily by the registry, so resolve them here before any worker runs.
+        // Then load and decode the assets of all new components in parallel.
+        std::vector<ComponentFactory*> factories (elements.size(), nullptr);
+        std::vector<std::future<std::unique_ptr<const ComponentBlueprint>>> blueprints (elements.size());
+        std::vector<std::unique_ptr<LoadRecorder>> recorders (elements.size());
+
+        // Elements record their accesses apart and are merged in document order, so a manifest doesn't depend on which prepared first
+        auto* manifestRecorder = PrefetchManifest::Recorder::getCurrent();
+        std::vector<std::unique_ptr<PrefetchManifest::Recorder>> accessRecorders (elements.size());
+
+        // Declared after everything the preparations use, so a factory that throws can't unwind it while they run
+        const PendingBlueprints pendingBlueprints { blueprints };
+
+        for (size_t index = 0; index < elements.size(); ++index)
+        {
+            if (elementActions[index] != ElementAction::create || isContainerElement (*elements[index]))
+                continue;
+
+            factories[index] = componentFactoryRegistry->getFactory (elements[index], this);
+
+            if (factories[index] == nullptr)
+            {
+                juce::Logger::writeToLog ("No factory found for component type: " + elements[index]->getTagName());
+                continue;
+            }
+
+            if (loadReportEnabled)
+                recorders[index] = std::make_unique<LoadRecorder>();
+
+            if (manifestRecorder != nullptr)
+                accessRecorders[index] = std::make_unique<PrefetchManifest::Recorder>();
+
+            blueprints[index] = componentPreparationThreadPool->threadPool.submit_task ([factory = factories[index], &metadata = metadataList[index], recorder = recorders[index].get(), accessRecorder = accessRecorders[index].get()] {
+                BD_UI_TRACE_SCOPE_DETAILED ("ComponentFactory::prepare", metadata.name);
+                const LoadRecorder::ScopedActivation activation (recorder);
+                const PrefetchManifest::Recorder::ScopedActivation accessActivation (accessRecorder);
+                const auto startTicks = juce::Time::getHighResolutionTicks();
+
+                auto blueprint = factory->prepare (metadata);
+
+                if (recorder != nullptr)
+                    recorder->addPrepareTime (getMillisecondsSince (startTicks));
+
+                return blueprint;
+            });
+        }
+
+        juce::StringArray replacedNames;
+
+        for (const auto& [name, component] : previousComponents)
+        {
+            if (! reusedNames.contains (name))
+                replacedNames.add (name);
+        }
+
+        if (! replacedNames.isEmpty() && onComponentsAboutToBeReplaced != nullptr)
+            onComponentsAboutToBeReplaced (replacedNames);
+
+        juce::StringArray createdNames;
+        std::vector<juce::Component*> builtComponents (elements.size(), nullptr);
+
+        for (size_t index = 0; index < elements.size(); ++index)
+        {
+            const auto& element = *elements[index];
+            const auto& metadata = metadataList[index];
+            const auto& name = metadata.name;
+
+            if (elementActions[index] == ElementAction::skip)
+                continue;
+
+            // Containers come before their contents and are never skipped while those aren't
+            const auto container = plan.containers[index];
+            auto* parent = container >= 0 ? builtComponents[(size_t) container] : &parentComponent;
+            juce::Component* component = nullptr;
+
+            if (elementActions[index] == ElementAction::reuse)
+            {
+                component = previousComponents[name].release();
+
+                if (component->getParentComponent() != parent)
+                    parent->addAndMakeVisible (component);
+                else
+                    component->toFront (false);
+            }
+            else if ((component = isContainerElement (element) ? new ContainerComponent()
+                                                               : createComponentForElement (element, factories[index], blueprints[index], recorders[index].get())) != nullptr)
+            {
+                if (const auto previous = previousComponents.find (name); previous != previousComponents.end() && previous->second != nullptr)
+                    transferControlState (*previous->second, *component);
+
+                parent->addAndMakeVisible (component);
+                createdNames.add (name);
+            }
+
+            // The blueprint has been taken, so its preparation is done
+            if (accessRecorders[index] != nullptr)
+                manifestRecorder->merge (*accessRecorders[index]);
+
+            if (component != nullptr)
+            {
+                builtComponents[index] = component;
+                components.add (component);
+                componentsByName[name] = component;
+
+                applyMetadataToProperties (component, metadata);
+                applyLayoutToComponent (component);
+            }
+        }
+
+        // Destroys the components that were removed or recreated; they detach from their parents themselves
+        previousComponents.clear();
+
+        if (loadReportEnabled)
+        {
+            loadReport->components.clear();
+
+            for (size_t index = 0; index < elements.size(); ++index)
+            {
+                if (elementActions[index] == ElementAction::skip)
+                    continue;
+
+                auto record = recorders[index] != nullptr ? recorders[index]->takeRecord() : LoadReport::ComponentRecord();
+                record.name = metadataList[index].name;
+                record.type = elements[index]->getTagName();
+                record.reused = elementActions[index] == ElementAction::reuse;
+
+                if (factories[index] != nullptr)
+                    record.factory = LoadReport::getTypeName (typeid (*factories[index]));
+
+                loadReport->components.push_back (std::move (record));
+            }
+        }
+
+        updateStaticLayer();
+
+        if (previousPlan != nullptr && ! createdNames.isEmpty() && onComponentsReplaced != nullptr)
+            onComponentsReplaced (createdNames);
+    }
+
+    bool UILoader::isGroupElement (const juce::XmlElement& element)
+    {
+        return element.hasTagName ("GROUP") || element.hasTagName ("PAGE");
+    }
+
+    void UILoader::showGroup (const juce::String& groupName, std::function<void()> onShown)
+    {
+        const auto it = deferredGroups.find (groupName);
+
+        if (it == deferredGroups.end())
+        {
+            jassertfalse; // No GROUP or PAGE element with this name
+            return;
+        }
+
+        const auto group = it->second;
+        group->visible = true;
+
+        if (onShown != nullptr)
+            group->onShownCallbacks.push_back (std::move (onShown));
+
+        if (! group->built)
+        {
+            startBuildingGroup (group);
+            return;
+        }
+
+        setGroupComponentsVisible (*group, true);
+
+        for (auto& callback : std::exchange (group->onShownCallbacks, {}))
+            callback();
+    }
+
+    void UILoader::hideGroup (const juce::String& groupName, bool releaseComponents)
+    {
+        const auto it = deferredGroups.find (groupName);
+
+        if (it == deferredGroups.end())
+        {
+            jassertfalse; // No GROUP or PAGE element with this name
+            return;
+        }
+
+        auto& group = *it->second;
+        group.visible = false;
+        group.onShownCallbacks.clear();
+
+        setGroupComponentsVisible (group, false);
+
+        if (releaseComponents)
+            releaseGroup (group);
+    }
+
+    bool UILoader::isGroupVisible (const juce::String& groupName) const
+    {
+        const auto it = deferredGroups.find (groupName);
+        return it != deferredGroups.end() && it->second->visible;
+    }
+
+    juce::StringArray UILoader::getGroupNames() const
+    {
+        juce::StringArray names;
+
+        for (const auto& [name, group] : deferredGroups)
+            names.add (name);
+
+        names.sort (true);
+        return names;
+    }
+
+    void UILoader::updateDeferredGroups (const juce::XmlElement& xmlDocument, const juce::StringArray& changedAssets)
+    {
+        auto previousGroups = std::exchange (deferredGroups, {});
+        std::vector<std::shared_ptr<DeferredGroup>> groupsToBuild, keptGroups;
+
+        for (auto* element : xmlDocument.getChildIterator())
+        {
+            if (! isGroupElement (*element))
+                continue;
+
+            const auto name = element->getStringAttribute ("name");
+
+            if (deferredGroups.contains (name))
+            {
+                jassertfalse; // Duplicate group name detected
+                juce::Logger::writeToLog ("Duplicate group name detected: " + name + " - skipping group");
+                continue;
+            }
+
+            const auto previous = previousGroups.find (name);
+
+            if (previous != previousGroups.end())
+            {
+                auto& previousGroup = previous->second;
+
+                const auto assetChanged = std::any_of (previousGroup->metadata.begin(), previousGroup->metadata.end(), [&changedAssets] (const auto& metadata) {
+                    return std::any_of (changedAssets.begin(), changedAssets.end(), [&metadata] (const auto& asset) {
+                        return usesAsset (metadata, asset);
+                    });
+                });
+
+                if (! assetChanged && previousGroup->element->isEquivalentTo (element, true))
                 {
-                    if (auto* component = factory->createComponent (element); component != nullptr)
-                    {
-                        parentComponent.addAndMakeVisible (component);
-                        components.add (component);
-                        componentsByName[name] = component;
-
-                        const auto metadata = parseElement (element);
-                        applyMetadataToProperties (component, metadata);
-                        applyLayoutToComponent (component);
-                    }
+                    for (auto* component : previousGroup->components)
+                        componentsByName[component->getProperties()["name"].toString()] = component;
+
+                    keptGroups.push_back (previousGroup);
+                    deferredGroups[name] = std::move (previousGroup);
+                    previousGroups.erase (previous);
+                    continue;
                 }
-                else
+            }
+
+            auto group = std::make_shared<DeferredGroup>();
+            group->element = std::make_unique<const juce::XmlElement> (*element);
+
+            collectElements (*group->element, group->elements, group->containers);
+
+            for (const auto* child : group->elements)
+                group->metadata.push_back (parseElement (child));
+
+            if (previous != previousGroups.end() && previous->second->visible)
+            {
+                group->visible = true;
+                group->onShownCallbacks = std::exchange (previous->second->onShownCallbacks, {});
+                groupsToBuild.push_back (group);
+            }
+
+            deferredGroups[name] = std::move (group);
+        }
+
+        for (auto& [name, group] : previousGroups)
+            releaseGroup (*group);
+
+        // parseXML() restacked the reused components. Last group first, so every group finds the ones after it in place.
+        for (auto it = keptGroups.rbegin(); it != keptGroups.rend(); ++it)
+            stackGroupComponents (**it);
+
+        for (const auto& group : groupsToBuild)
+            startBuildingGroup (group);
+    }
+
+    void UILoader::startBuildingGroup (const std::shared_ptr<DeferredGroup>& group)
+    {
+        if (group->built || group->building)
+            return;
+
+        BD_UI_TRACE_SCOPE_DETAILED ("UILoader::startBuildingGroup", group->element->getStringAttribute ("name"));
+
+        group->building = true;
+        const auto generation = ++group->buildGeneration;
+        const auto numElements = group->metadata.size();
+        group->factories.assign (numElements, nullptr);
+        group->blueprints.clear();
+        group->blueprints.resize (numElements);
+
+        for (size_t index = 0; index < numElements; ++index)
+        {
+            const auto* element = group->elements[index];
+
+            if (isContainerElement (*element))
+                continue;
+
+            if ((group->factories[index] = componentFactoryRegistry->getFactory (element, this)) == nullptr)
+                juce::Logger::writeToLog ("No factory found for component type: " + element->getTagName());
+        }
+
+        // The components are created on the message thread once the last blueprint is prepared,
+        // unless the build has been abandoned by then (released, reloaded or this loader destroyed)
+        const auto finish = [this, weakGroup = std::weak_ptr<DeferredGroup> (group), generation] {
+            juce::MessageManager::callAsync ([this, weakGroup, generation] {
+                if (const auto lockedGroup = weakGroup.lock(); lockedGroup != nullptr && lockedGroup->buildGeneration == generation)
+                    finishBuildingGroup (*lockedGroup);
+            });
+        };
+
+        const auto numToPrepare = std::count_if (group->factories.begin(), group->factories.end(), [] (auto* factory) { return factory != nullptr; });
+
+        if (numToPrepare == 0)
+        {
+            finish();
+            return;
+        }
+
+        const auto remaining = std::make_shared<std::atomic<std::ptrdiff_t>> (numToPrepare);
+
+        for (size_t index = 0; index < numElements; ++index)
+        {
+            if (group->factories[index] == nullptr)
+                continue;
+
+            group->blueprints[index] = componentPreparationThreadPool->threadPool.submit_task ([group, index, remaining, finish, factory = group->factories[index]] {
+                const auto& metadata = group->metadata[index];
+                BD_UI_TRACE_SCOPE_DETAILED ("ComponentFactory::prepare", metadata.name);
+
+                auto blueprint = factory->prepare (metadata);
+
+                // Finishing waits for this task's result, which is ready right after it returns
+                if (--*remaining == 0)
+                    finish();
+
+                return blueprint;
+            });
+        }
+    }
+
+    void UILoader::finishBuildingGroup (DeferredGroup& group)
+    {
+        BD_UI_TRACE_SCOPE_DETAILED ("UILoader::finishBuildingGroup", group.element->getStringAttribute ("name"));
+
+        juce::StringArray createdNames;
+        std::vector<juce::Component*> builtComponents (group.elements.size(), nullptr);
+
+        for (size_t index = 0; index < group.elements.size(); ++index)
+        {
+            const auto& element = *group.elements[index];
+            const auto& metadata = group.metadata[index];
+            const auto container = group.containers[index];
+            auto* parent = container >= 0 ? builtComponents[(size_t) container] : &parentComponent;
+
+            if (parent == nullptr)
+                continue;
+
+            if (componentsByName.contains (metadata.name))
+            {
+                jassertfalse; // Duplicate component name detected
+                juce::Logger::writeToLog ("Duplicate component name detected: " + metadata.name + " - skipping component");
+                continue;
+            }
+
+            auto* component = isContainerElement (element) ? new ContainerComponent()
+                                                           : createComponentForElement (element, group.factories[index], group.blueprints[index], nullptr);
+
+            if (component == nullptr)
+                continue;
+
+            builtComponents[index] = component;
+            group.components.add (component);
+            componentsByName[metadata.name] = component;
+
+            applyMetadataToProperties (component, metadata);
+
+            // Top-level components stay hidden until the whole group is shown
+            if (parent == &parentComponent)
+                parent->addChildComponent (component);
+            else
+                parent->addAndMakeVisible (component);
+
+            applyLayoutToComponent (component);
+            createdNames.add (metadata.name);
+        }
+
+        stackGroupComponents (group);
+
+        group.building = false;
+        group.built = true;
+        group.factories.clear();
+        group.blueprints.clear();
+
+        if (! createdNames.isEmpty() && onComponentsReplaced != nullptr)
+            onComponentsReplaced (createdNames);
+
+        if (! group.visible)
+            return;
+
+        setGroupComponentsVisible (group, true);
+
+        for (auto& callback : std::exchange (group.onShownCallbacks, {}))
+            callback();
+    }
+
+    void UILoader::stackGroupComponents (DeferredGroup& group)
+    {
+        auto* componentAfterGroup = getComponentAfterGroup (group);
+
+        // Each goes right behind the same component, so the group keeps its own order
+        for (auto* component : group.components)
+        {
+            if (component->getParentComponent() != &parentComponent)
+                continue;
+
+            if (componentAfterGroup != nullptr)
+                component->toBehind (componentAfterGroup);
+            else
+                component->toFront (false);
+        }
+    }
+
+    juce::Component* UILoader::getComponentAfterGroup (const DeferredGroup& group) const
+    {
+        if (warmPlan == nullptr)
+            return nullptr;
+
+        const auto groupName = group.element->getStringAttribute ("name");
+        auto isAfterGroup = false;
+
+        for (const auto* element : warmPlan->document->getChildIterator())
+        {
+            const auto name = element->getStringAttribute ("name");
+
+            if (! isAfterGroup)
+            {
+                isAfterGroup = isGroupElement (*element) && name == groupName;
+                continue;
+            }
+
+            // Groups that aren't built have no components yet
+            if (isGroupElement (*element))
+            {
+                if (const auto it = deferredGroups.find (name); it != deferredGroups.end())
                 {
-                    juce::Logger::writeToLog ("No factory found for component type: " + element->getTagName());
+                    for (auto* component : it->second->components)
+                        if (component->getParentComponent() == &parentComponent)
+                            return component;
                 }
             }
+            else if (const auto it = componentsByName.find (name); it != componentsByName.end() && it->second->getParentComponent() == &parentComponent)
+            {
+                return it->second;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void UILoader::setGroupComponentsVisible (DeferredGroup& group, bool shouldBeVisible)
+    {
+        // Components inside the group's containers are hidden along with them
+        for (auto* component : group.components)
+            if (component->getParentComponent() == &parentComponent)
+                component->setVisible (shouldBeVisible);
+    }
+
+    void UILoader::releaseGroup (DeferredGroup& group)
+    {
+        abandonPreparations (group);
+        group.built = false;
+
+        if (group.components.isEmpty())
+            return;
+
+        juce::StringArray names;
+
+        for (auto* component : group.components)
+            names.add (component->getProperties()["name"].toString());
+
+        if (onComponentsAboutToBeReplaced != nullptr)
+            onComponentsAboutToBeReplaced (names);
+
+        // After a reload, a name may belong to a top-level component by now
+        for (auto* component : group.components)
+            if (const auto it = componentsByName.find (component->getProperties()["name"].toString()); it != componentsByName.end() && it->second == component)
+                componentsByName.erase (it);
+
+        group.components.clear();
+    }
+
+    void UILoader::abandonPreparations (DeferredGroup& group)
+    {
+        ++group.buildGeneration;
+        group.building = false;
+        group.factories.clear();
+
+        for (auto& blueprint : group.blueprints)
+            if (blueprint.valid())
+                abandonedPreparations.push_back (std::move (blueprint));
+
+        group.blueprints.clear();
+
+        std::erase_if (abandonedPreparations, [] (const auto& preparation) {
+            return preparation.wait_for (std::chrono::seconds (0)) == std::future_status::ready;
+        });
+    }
+
+    juce::Component* UILoader::createComponentForElement (const juce::XmlElement& element,
+                                                          ComponentFactory* factory,
+                                                          std::future<std::unique_ptr<const ComponentBlueprint>>& blueprint,
+                                                          LoadRecorder* recorder)
+    {
+        if (factory == nullptr)
+            return nullptr;
+
+        const auto preparedBlueprint = [&blueprint, &element]() -> std::unique_ptr<const ComponentBlueprint> {
+            BD_UI_TRACE_SCOPE_DETAILED ("UILoader::waitForBlueprint", element.getStringAttribute ("name"));
+            return blueprint.valid() ? blueprint.get() : nullptr;
+        }();
+
+        BD_UI_TRACE_SCOPE_DETAILED ("ComponentFactory::instantiate", element.getStringAttribute ("name"));
+        const LoadRecorder::ScopedActivation activation (recorder);
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+
+        // Factories without two-stage support prepare nothing and build everything here. Either way the
+        // component is built through createComponent(), so subclasses overriding it aren't bypassed.
+        auto* component = preparedBlueprint != nullptr ? factory->createComponentFromBlueprint (element, *preparedBlueprint)
+                                                       : factory->createComponent (&element);
+
+        if (recorder != nullptr)
+            recorder->addInstantiateTime (getMillisecondsSince (startTicks));
+
+        return component;
+    }
+
+    bool UILoader::canReuseComponent (const juce::XmlElement& previousElement,
+                                      const juce::XmlElement& element,
+                                      const ComponentMetadata& metadata,
+                                      const juce::StringArray& changedAssets)
+    {
+        const auto assetChanged = std::any_of (changedAssets.begin(), changedAssets.end(), [&metadata] (const auto& asset) {
+            return usesAsset (metadata, asset);
+        });
+
+        if (assetChanged)
+            return false;
+
+        // Position and size only feed the layout, which runs for every component anyway.
+        // Tweenables bake their travel into the component, so their min/max still count.
+        juce::XmlElement comparedElement (previousElement);
+
+        for (const auto* attribute : { "x", "y", "width", "height" })
+        {
+            if (element.hasAttribute (attribute))
+                comparedElement.setAttribute (attribute, element.getStringAttribute (attribute));
+            else
+                comparedElement.removeAttribute (attribute);
+        }
+
+        return comparedElement.isEquivalentTo (&element, true);
+    }
+
+    bool UILoader::usesAsset (const ComponentMetadata& metadata, const juce::String& assetName)
+    {
+        if (assetName.isEmpty())
+            return false;
+
+        // A file's mask is its stem followed by "_mask", e.g. knob_mask.png for knob.png
+        const auto matchesFile = [&assetName] (const juce::String& file) {
+            if (file.isEmpty())
+                return false;
+
+            const auto stem = file.upToLastOccurrenceOf (".", false, false);
+            const auto extension = file.fromLastOccurrenceOf (".", true, false);
+            return assetName == file || assetName == stem + "_mask" + extension;
+        };
+
+        // Filmstrip frames are the prefix followed by a frame index or "mask" and one of the suffixes
+        const auto matchesSequence = [&assetName, &metadata] (const juce::String& suffix) {
+            if (metadata.fileNamePrefix.isEmpty() || suffix.isEmpty()
+                || ! assetName.startsWith (metadata.fileNamePrefix) || ! assetName.endsWith (suffix)
+                || assetName.length() <= metadata.fileNamePrefix.length() + suffix.length())
+                return false;
+
+            const auto frame = assetName.substring (metadata.fileNamePrefix.length(), assetName.length() - suffix.length());
+            return frame == "mask" || frame.containsOnly ("0123456789");
+        };
+
+        if (matchesFile (metadata.file) || matchesFile (metadata.file2x) || assetName == metadata.hitboxMask)
+            return true;
+
+        // Single-frame HOOVERABLE and LED elements load their name followed by the suffix
+        if (metadata.name.isNotEmpty() && metadata.fileNameSuffix.isNotEmpty() && assetName == metadata.name + metadata.fileNameSuffix)
+            return true;
+
+        if (matchesSequence (metadata.fileNameSuffix) || matchesSequence (metadata.fileNameSuffix2x))
+            return true;
+
+        for (const auto& variant : metadata.scaleVariants)
+            if (matchesFile (variant.file) || matchesSequence (variant.fileNameSuffix))
+                return true;
+
+        return false;
+    }
+
+    void UILoader::transferControlState (juce::Component& source, juce::Component& destination)
+    {
+        destination.setEnabled (source.isEnabled());
+
+        if (auto* sourceTweenable = dynamic_cast<TweenableComponent*> (&source))
+        {
+            if (auto* tweenable = dynamic_cast<TweenableComponent*> (&destination))
+                tweenable->setNormalizedValue (sourceTweenable->getNormalizedValue());
+        }
+        else if (auto* sourceSlider = dynamic_cast<juce::Slider*> (&source))
+        {
+            if (auto* slider = dynamic_cast<juce::Slider*> (&destination))
+                slider->setValue (sourceSlider->getValue(), juce::dontSendNotification);
+        }
+        else if (auto* sourceGroup = dynamic_cast<RadioButtonGroup*> (&source))
+        {
+            if (auto* group = dynamic_cast<RadioButtonGroup*> (&destination))
+                group->setSelectedButtonIndex (sourceGroup->getSelectedButtonIndex());
+        }
+        else if (auto* sourceButton = dynamic_cast<juce::Button*> (&source))
+        {
+            if (auto* button = dynamic_cast<juce::Button*> (&destination))
+                button->setToggleState (sourceButton->getToggleState(), juce::dontSendNotification);
+        }
+        else if (auto* sourceComboBox = dynamic_cast<juce::ComboBox*> (&source))
+        {
+            if (auto* comboBox = dynamic_cast<juce::ComboBox*> (&destination))
+                comboBox->setSelectedId (sourceComboBox->getSelectedId(), juce::dontSendNotification);
+        }
+    }
+
+    juce::Rectangle<int> UILoader::getSourceBounds (const juce::Component& component)
+    {
+        const auto& props = component.getProperties();
+        return { props["x"].operator int(), props["y"].operator int(), props["width"].operator int(), props["height"].operator int() };
+    }
+
+    void UILoader::updateStaticLayer()
+    {
+        juce::Array<juce::Component*> staticComponents;
+        juce::Array<juce::Rectangle<int>> liveSourceBounds;
+
+        // Groups are stacked where their elements are, in front of the static layer, so nothing after one can be baked
+        std::unordered_set<juce::String> namesAfterGroups;
+
+        if (warmPlan != nullptr)
+        {
+            auto isAfterGroup = false;
+
+            for (const auto* element : warmPlan->document->getChildIterator())
+            {
+                if (isGroupElement (*element))
+                    isAfterGroup = true;
+                else if (isAfterGroup)
+                    namesAfterGroups.insert (element->getStringAttribute ("name"));
+            }
+        }
+
+        for (auto* component : components)
+        {
+            auto& props = component->getProperties();
+
+            // Only components the loader hid itself are shown again; the rest of visibility belongs to the application
+            const auto wasHiddenByLoader = static_cast<bool> (props["flattened"]) || static_cast<bool> (props["occluded"]);
+            props.set ("flattened", false);
+            props.set ("occluded", false);
+
+            // Inside a container, source bounds are in its coordinate space and the container clips and paints them.
+            // They are never flattened or occluded, so only a component that was hidden at the top level is shown again.
+            if (component->getParentComponent() != &parentComponent)
+            {
+                if (wasHiddenByLoader)
+                    component->setVisible (true);
+
+                continue;
+            }
+
+            const auto sourceBounds = getSourceBounds (*component);
+
+            // Only images that never change and don't react to clicks can be baked. Flattening moves them
+            // behind every live component, so an image must not sit above any earlier live component either.
+            const auto isStaticImage = props["type"].toString() == "IMAGE"
+                                       && props["hitboxMask"].toString().isEmpty()
+                                       && ! namesAfterGroups.contains (props["name"].toString())
+                                       && dynamic_cast<ImageComponent*> (component) != nullptr
+                                       && dynamic_cast<TweenableComponent*> (component) == nullptr;
+
+            const auto coversLiveComponent = std::any_of (liveSourceBounds.begin(), liveSourceBounds.end(), [&sourceBounds] (const auto& liveBounds) {
+                return liveBounds.intersects (sourceBounds);
+            });
+
+            // updateOcclusion() hides covered components again
+            if (staticLayerEnabled && isStaticImage && ! coversLiveComponent)
+            {
+                props.set ("flattened", true);
+                component->setVisible (false);
+                staticComponents.add (component);
+            }
+            else
+            {
+                if (wasHiddenByLoader)
+                    component->setVisible (true);
+
+                liveSourceBounds.add (sourceBounds);
+            }
+        }
+
+        staticLayer->setLayerComponents (staticComponents);
+
+        if (staticComponents.isEmpty())
+        {
+            parentComponent.removeChildComponent (staticLayer.get());
+        }
+        else
+        {
+            parentComponent.addAndMakeVisible (*staticLayer, 0);
+            staticLayer->toBack();
+            staticLayer->setBounds (parentComponent.getLocalBounds());
         }
     }
 
+    void UILoader::setOcclusionCullingEnabled (bool shouldBeEnabled)
+    {
+        occlusionCullingEnabled = shouldBeEnabled;
+        updateOcclusion();
+    }
+
+    void UILoader::updateOcclusion()
+    {
+        const auto& flattenedComponents = staticLayer->getLayerComponents();
+
+        const auto isDrawn = [&flattenedComponents] (juce::Component* component) {
+            return component->isVisible() || flattenedComponents.contains (component);
+        };
+
+        // Pixels of the parent that an opaque image paints completely. Its edges are drawn at
+        // sub-pixel positions, so only the whole pixels inside its float bounds count.
+        const auto getCoveredArea = [] (juce::Component* component) -> juce::Rectangle<int> {
+            auto* image = dynamic_cast<ImageComponent*> (component);
+
+            if (image == nullptr || ! image->isFullyOpaque() || dynamic_cast<TweenableComponent*> (component) != nullptr)
+                return {};
+
+            const auto& props = component->getProperties();
+            const auto drawnBounds = juce::Rectangle<float> (static_cast<float> (props["floatX"]), static_cast<float> (props["floatY"]),
+                                                             static_cast<float> (props["floatW"]), static_cast<float> (props["floatH"]))
+                                         + component->getPosition().toFloat();
+
+            return juce::Rectangle<int>::leftTopRightBottom (juce::roundToInt (std::ceil (drawnBounds.getX())),
+                juce::roundToInt (std::ceil (drawnBounds.getY())),
+                juce::roundToInt (std::floor (drawnBounds.getRight())),
+                juce::roundToInt (std::floor (drawnBounds.getBottom())));
+        };
+
+        juce::Array<juce::Rectangle<int>> coveredAreas;
+
+        // Walk front to back so every component is only tested against the ones painted above it
+        for (int i = components.size(); --i >= 0;)
+        {
+            auto* component = components[i];
+
+            // Bounds of components inside containers aren't in the parent's coordinates; hiding their container culls them
+            if (component->getParentComponent() != &parentComponent)
+                continue;
+
+            auto& props = component->getProperties();
+            const auto wasOccluded = static_cast<bool> (props["occluded"]);
+
+            // Tweenables move by transform between layouts, so their bounds can't be trusted here
+            const auto isOccluded = occlusionCullingEnabled
+                                    && (wasOccluded || isDrawn (component))
+                                    && dynamic_cast<TweenableComponent*> (component) == nullptr
+                                    && std::any_of (coveredAreas.begin(), coveredAreas.end(), [component] (const auto& area) {
+                                           return area.contains (component->getBounds());
+                                       });
+
+            props.set ("occluded", isOccluded);
+
+            if (isOccluded != wasOccluded && ! flattenedComponents.contains (component))
+                component->setVisible (! isOccluded);
+
+            if (! isOccluded && isDrawn (component))
+                if (const auto coveredArea = getCoveredArea (component); ! coveredArea.isEmpty())
+                    coveredAreas.add (coveredArea);
+        }
+    }
+
+    void UILoader::invalidateStaticLayer()
+    {
+        staticLayer->invalidate();
+    }
+
     juce::Rectangle<float> UILoader::calculateTransformedBounds (
         const juce::Rectangle<float>& sourceBounds,
         const juce::Rectangle<float>& targetBounds,
@@ -152,6 +1304,38 @@ namespace BogrenDigital::UILoading
         return componentSourceBounds.transformedBy (transform);
     }
 
+    juce::AffineTransform UILoader::getLayoutTransform() const
+    {
+        if (bitmapLayout.sourceBounds.isEmpty() || bitmapLayout.targetBounds.isEmpty())
+            return {};
+
+        return PlayfulTones::ComponentResizer::getRectTransform (bitmapLayout.sourceBounds, bitmapLayout.targetBounds);
+    }
+
+    juce::AffineTransform UILoader::getLayoutTransform (const juce::Component& component) const
+    {
+        const auto space = getLayoutSpace (component);
+
+        if (space.source.isEmpty() || space.target.isEmpty())
+            return {};
+
+        return PlayfulTones::ComponentResizer::getRectTransform (space.source, space.target);
+    }
+
+    UILoader::LayoutSpace UILoader::getLayoutSpace (const juce::Component& component) const
+    {
+        // A container's metadata size maps onto the area it was laid out to, relative to its own position
+        if (auto* container = dynamic_cast<ContainerComponent*> (component.getParentComponent()))
+        {
+            const auto& props = container->getProperties();
+            return { juce::Rectangle<float> (0.0f, 0.0f, static_cast<float> (props["width"]), static_cast<float> (props["height"])),
+                     juce::Rectangle<float> (static_cast<float> (props["floatX"]), static_cast<float> (props["floatY"]),
+                                             static_cast<float> (props["floatW"]), static_cast<float> (props["floatH"])) };
+        }
+
+        return { bitmapLayout.sourceBounds, bitmapLayout.targetBounds };
+    }
+
     void UILoader::registerComponentFactories()
     {
         auto& registry = *componentFactoryRegistry;
@@ -175,15 +1359,14 @@ namespace BogrenDigital::UILoading
 
     void UILoader::applyLayoutToComponent (juce::Component* component)
     {
-        const auto props = component->getProperties();
-        const auto compX = props["x"].operator int();
-        const auto compY = props["y"].operator int();
-        const auto compWidth = props["width"].operator int();
-        const auto compHeight = props["height"].operator int();
-        const auto componentSourceBounds = juce::Rectangle { static_cast<float> (compX), static_cast<float> (compY), static_cast<float> (compWidth), static_cast<float> (compHeight) };
+        const auto componentSourceBounds = getSourceBounds (*component).toFloat();
+        const auto space = getLayoutSpace (*component);
+
+        if (space.source.isEmpty())
+            return;
 
         juce::Rectangle<float> transformedBounds = calculateTransformedBounds (
-            bitmapLayout.sourceBounds, bitmapLayout.targetBounds, componentSourceBounds);
+            space.source, space.target, componentSourceBounds);
 
         const auto floatX = transformedBounds.getX();
         const auto floatY = transformedBounds.getY();
@@ -208,8 +1391,48 @@ namespace BogrenDigital::UILoading
         component->getProperties().set("floatH", floatHeight);
     }
 
+    void UILoader::applyLayoutToSubtree (juce::Component& component)
+    {
+        BD_UI_TRACE_SCOPE_DETAILED ("UILoader::applyLayoutToSubtree", component.getProperties()["name"].toString());
+
+        const std::function<void (juce::Component&)> layOut = [this, &layOut] (juce::Component& subtree) {
+            applyLayoutToComponent (&subtree);
+
+            if (dynamic_cast<ContainerComponent*> (&subtree) != nullptr)
+                for (auto* child : subtree.getChildren())
+                    layOut (*child);
+        };
+
+        layOut (component);
+
+        // Components inside containers are never occluded, so only a top-level move can change what is covered
+        if (component.getParentComponent() == &parentComponent)
+            updateOcclusion();
+    }
+
+    void UILoader::setSourceBounds (const juce::String& componentName, juce::Rectangle<int> sourceBounds)
+    {
+        auto* component = getComponentByName (componentName);
+
+        if (component == nullptr)
+        {
+            jassertfalse; // No component with this name
+            return;
+        }
+
+        auto& props = component->getProperties();
+        props.set ("x", sourceBounds.getX());
+        props.set ("y", sourceBounds.getY());
+        props.set ("width", sourceBounds.getWidth());
+        props.set ("height", sourceBounds.getHeight());
+
+        applyLayoutToSubtree (*component);
+    }
+
     void UILoader::applyLayout()
     {
+        BD_UI_TRACE_SCOPE ("UILoader::applyLayout");
+
         if (bitmapLayout.width <= 0 || bitmapLayout.height <= 0)
             return;
 
@@ -218,6 +1441,16 @@ namespace BogrenDigital::UILoading
 
         for (int i = 0; i < components.size(); ++i)
             applyLayoutToComponent (components[i]);
+
+        for (const auto& [name, group] : deferredGroups)
+            for (auto* component : group->components)
+                applyLayoutToComponent (component);
+
+        updateOcclusion();
+
+        // Components only move when the parent size changes, so the static layer is recomposited at the new size
+        staticLayer->setBounds (parentComponent.getLocalBounds());
+        staticLayer->invalidate();
     }
 
 } // namespace BogrenDigital::UILoading
\ No newline at end of file
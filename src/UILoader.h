@@ -1,13 +1,23 @@
 #pragma once
+#include <future>
 #include <unordered_map>
 
 namespace BogrenDigital::UILoading
 {
     class AspectRatioListener;
+    class AssetFileWatcher;
     class ComponentFactory;
     class ComponentFactoryRegistry;
+    struct ComponentBlueprint;
+    struct LoadReport;
+    struct MemoryReport;
+    class LoadRecorder;
+    class PaintProfilerOverlay;
+    class StaticLayerComponent;
 
     struct ImageLoader;
+    class DecodedImageCache;
+    struct WarmUIPlan;
 
     /**
      * @brief Main UI loading and layout management system.
@@ -25,22 +35,195 @@ namespace BogrenDigital::UILoading
 
         /**
          * @brief Loads UI from XML metadata file and applies layout.
+         *
+         * If warm reopening is enabled and the same UI was loaded from the same asset
+         * source recently, its parsed metadata and decoded images are reused from the
+         * WarmUICache.
+         *
+         * Loading again updates the current UI incrementally: components whose
+         * element is unchanged (or only moved or resized) are kept, and only added,
+         * removed or modified elements are created or destroyed.
+         *
          * @param xmlFileName Name of the XML file in binary resources
          */
         void loadUI(const juce::String& xmlFileName);
 
+        /**
+         * @brief Re-reads the loaded XML and updates the UI incrementally, keeping the current size.
+         *
+         * Components that use one of changedAssets are recreated with freshly loaded
+         * images. Recreated components take over the state of the ones they replace
+         * (slider value, toggle state, radio selection, dropdown selection, tween value).
+         */
+        void reloadUI (const juce::StringArray& changedAssets = {});
+
+        /**
+         * @brief Watches the asset directory and calls reloadUI() whenever the XML or an image changes.
+         *
+         * Meant for iterating on skins; only available when the assets come from a
+         * FileAssetImageLoader (e.g. a UILoader constructed from an asset directory).
+         */
+        void setHotReloadEnabled (bool shouldBeEnabled);
+        bool isHotReloadEnabled() const { return assetFileWatcher != nullptr; }
+
+        /**
+         * @brief Called before a reload destroys components, while they are still reachable by name.
+         *
+         * Also called before hideGroup() releases a group's components. Use it to delete
+         * parameter attachments or listeners bound to those components.
+         */
+        std::function<void (const juce::StringArray& componentNames)> onComponentsAboutToBeReplaced;
+
+        /**
+         * @brief Called after a reload with the names of the components it created, e.g. to attach parameters again.
+         *
+         * Also called with a group's components once they have been built.
+         */
+        std::function<void (const juce::StringArray& componentNames)> onComponentsReplaced;
+
+        /**
+         * @brief Builds the components of a GROUP or PAGE element if needed and shows them.
+         *
+         * The elements inside a group are parsed with the UI but not created until the group
+         * is first shown. Their assets are then prepared on the worker threads and the
+         * components created on the message thread, so this returns right away and onShown
+         * is called once they are visible. Showing a group that is built is immediate.
+         */
+        void showGroup (const juce::String& groupName, std::function<void()> onShown = {});
+
+        /**
+         * @brief Hides the components of a group.
+         *
+         * With releaseComponents, they are destroyed as well (and their images released by
+         * the loader's cache policy) until the group is shown again.
+         */
+        void hideGroup (const juce::String& groupName, bool releaseComponents = false);
+
+        /** @brief True if the group was shown last, even while its components are still being built. */
+        bool isGroupVisible (const juce::String& groupName) const;
+
+        /** @brief The names of the GROUP and PAGE elements of the loaded UI. */
+        juce::StringArray getGroupNames() const;
+
+        /**
+         * @brief Records per-component factory times and per-asset cache, size and decode details.
+         *
+         * Disabled by default. Takes effect from the next loadUI() or reloadUI().
+         */
+        void setLoadReportEnabled (bool shouldBeEnabled);
+
+        /** @brief The report of the last loadUI() or reloadUI(); empty unless recording is enabled, or if the XML failed to parse. */
+        const LoadReport& getLoadReport() const;
+
+        /**
+         * @brief Totals the decoded pixel memory the loaded components hold, per component and type.
+         *
+         * Counts filmstrips, 1x images and every other scale held, masks, hitbox masks and the static
+         * layer, separates shared from exclusive bytes and flags duplicate pixels and scales never drawn.
+         */
+        MemoryReport getMemoryReport() const;
+
+        /**
+         * @brief Shows a PaintProfilerOverlay over the parent component.
+         *
+         * It shades the loaded components by what their paints cost and flags those
+         * slower than its frame budget. Disabled by default.
+         */
+        void setPaintProfilerEnabled (bool shouldBeEnabled);
+
+        /** @brief The overlay while the paint profiler is enabled, e.g. to set its frame budget; otherwise nullptr. */
+        PaintProfilerOverlay* getPaintProfilerOverlay() const { return paintProfilerOverlay.get(); }
+
+        /**
+         * @brief Records the images a fresh loadUI() asks for, in order, into a PrefetchManifest saved to this file.
+         *
+         * Replay it in a later session with imageLoader.loadAsync (PrefetchManifest::loadFrom (file).getRequests()),
+         * e.g. from the processor's constructor, so decoding starts before the editor exists.
+         * The file is only rewritten when the manifest changes. Call before loadUI().
+         */
+        void setPrefetchManifestFile (const juce::File& manifestFile) { prefetchManifestFile = manifestFile; }
+        const juce::File& getPrefetchManifestFile() const { return prefetchManifestFile; }
+
+        /**
+         * @brief Sets how long a closed editor's parsed UI and decoded images stay warm for reopening.
+         *
+         * Process-wide; zero (the default) disables warm reopening. While warm, the decoded images
+         * of a closed editor stay in memory, so keep the time short.
+         */
+        static void setWarmCacheTimeToLive (juce::RelativeTime timeToLive);
+
         /** @brief Registers all available component factories with the registry. */
         void registerComponentFactories();
 
         /** @brief Applies layout to all loaded components. */
         void applyLayout();
 
-        /** @brief Applies layout to a specific component based on its metadata properties. */
+        /**
+         * @brief Applies layout to a specific component based on its metadata properties.
+         *
+         * Components inside a CONTAINER are placed in its coordinate space, so the container must be laid out first.
+         */
         void applyLayoutToComponent(juce::Component* component);
 
+        /**
+         * @brief Lays out a component again and, if it is a CONTAINER, everything inside it.
+         *
+         * Use it after changing a component's x, y, width or height property, e.g. to slide a
+         * panel, instead of applyLayout(), which lays out the whole UI.
+         */
+        void applyLayoutToSubtree (juce::Component& component);
+
+        /**
+         * @brief Moves or resizes a component in metadata coordinates and lays out its subtree.
+         *
+         * The bounds are in the coordinate space of the component's container, if it is in one.
+         * The static layer isn't rebuilt, so a component moved beneath a later static IMAGE is
+         * still drawn above it.
+         */
+        void setSourceBounds (const juce::String& componentName, juce::Rectangle<int> sourceBounds);
+
+        /**
+         * @brief Returns the transform currently mapping metadata (bitmap) coordinates to parent pixels.
+         *
+         * Identity until a layout has been applied.
+         */
+        juce::AffineTransform getLayoutTransform() const;
+
+        /**
+         * @brief Returns the transform mapping a component's metadata coordinates to its parent's pixels.
+         *
+         * Inside a CONTAINER that is the container's own coordinate space, otherwise getLayoutTransform().
+         */
+        juce::AffineTransform getLayoutTransform (const juce::Component& component) const;
+
         /** @brief Maintains the aspect ratio of the parent component based on bitmap dimensions. */
         void applyProportionalResize();
 
+        /**
+         * @brief Enables flattening of static IMAGE components into one cached background bitmap.
+         *
+         * Disabled by default. Flattened components stay accessible by name but are hidden, so
+         * isVisible() returns false for them; only enable it before loadUI() if code doesn't need to
+         * show, hide or repaint them individually.
+         */
+        void setStaticLayerEnabled (bool shouldBeEnabled) { staticLayerEnabled = shouldBeEnabled; }
+
+        /** @brief Forces the static background bitmap to be recomposited on the next paint. */
+        void invalidateStaticLayer();
+
+        /**
+         * @brief Enables hiding components that are completely covered by a later, fully opaque image.
+         *
+         * Disabled by default. A culled component is hidden and gets an "occluded" property; the loader
+         * only ever shows components again that it hid itself, so ones the application hides stay hidden.
+         * Occlusion is recomputed by every applyLayout() and setSourceBounds(); call updateOcclusion()
+         * after showing, hiding or moving components from code.
+         */
+        void setOcclusionCullingEnabled (bool shouldBeEnabled);
+
+        /** @brief Recomputes which components are hidden behind opaque images for the current layout. */
+        void updateOcclusion();
+
         // X-Macro for ComponentMetadata fields - single source of truth
         // Format: FIELD_TYPE(fieldName, defaultValue)
         #define COMPONENT_METADATA_FIELDS \
@@ -53,6 +236,7 @@ namespace BogrenDigital::UILoading
             STRING_FIELD(fileNameSuffix2x, "") \
             STRING_FIELD(imageType, "") \
             STRING_FIELD(hitboxMask, "") \
+            STRING_FIELD(frameStorage, "") \
             INT_FIELD(x, 0) \
             INT_FIELD(y, 0) \
             INT_FIELD(width, 0) \
@@ -63,6 +247,14 @@ namespace BogrenDigital::UILoading
             INT_FIELD(maxX, 0) \
             INT_FIELD(maxY, 0)
 
+        /** @brief Images of an element declared for another scale than 1x, relative to its width and height. */
+        struct ScaleVariant
+        {
+            double scale = 2.0;
+            juce::String file;           // Replaces file
+            juce::String fileNameSuffix; // Replaces fileNameSuffix
+        };
+
         /**
          * @brief Metadata describing a UI component's properties.
          *
@@ -81,6 +273,10 @@ namespace BogrenDigital::UILoading
             #undef INT_FIELD
             #undef BOOL_FIELD
 
+            // Parsed from file<scale>x and fileNameSuffix<scale>x attributes, e.g. file1.5x or fileNameSuffix3x.
+            // 2x is declared by file2x and fileNameSuffix2x; getScaleVariants() includes it.
+            std::vector<ScaleVariant> scaleVariants;
+
             ComponentMetadata() = default;
             ComponentMetadata(const ComponentMetadata& other) = default;
             ComponentMetadata& operator=(const ComponentMetadata& other) = default;
@@ -98,10 +294,25 @@ namespace BogrenDigital::UILoading
             ComponentMetadata& withFile2x(const juce::String& f) { file2x = f; return *this; }
             ComponentMetadata& withFileNameSuffix2x(const juce::String& fns) { fileNameSuffix2x = fns; return *this; }
             ComponentMetadata& withNumberOfFrames(int nof) { numberOfFrames = nof; return *this; }
+            ComponentMetadata& withFrameStorage(const juce::String& fs) { frameStorage = fs; return *this; }
             ComponentMetadata& withMinX(int value) { minX = value; return *this; }
             ComponentMetadata& withMinY(int value) { minY = value; return *this; }
             ComponentMetadata& withMaxX(int value) { maxX = value; return *this; }
             ComponentMetadata& withMaxY(int value) { maxY = value; return *this; }
+            ComponentMetadata& withScaleVariant(double scale, const juce::String& f, const juce::String& fns) { scaleVariants.push_back({ scale, f, fns }); return *this; }
+
+            /** @brief Every declared variant, including the 2x one, ordered by scale. */
+            std::vector<ScaleVariant> getScaleVariants() const
+            {
+                auto variants = scaleVariants;
+                const auto declares2x = std::any_of (variants.begin(), variants.end(), [] (const ScaleVariant& v) { return v.scale == 2.0; });
+
+                if (! declares2x && (file2x.isNotEmpty() || fileNameSuffix2x.isNotEmpty()))
+                    variants.push_back({ 2.0, file2x, fileNameSuffix2x });
+
+                std::sort (variants.begin(), variants.end(), [] (const ScaleVariant& a, const ScaleVariant& b) { return a.scale < b.scale; });
+                return variants;
+            }
         };
 
         /** @brief Copies all metadata fields to a component's properties for later retrieval. */
@@ -165,8 +376,107 @@ namespace BogrenDigital::UILoading
         /** @brief Parses flat ComponentMetadata fields from an XML element's attributes. */
         static ComponentMetadata parseElement(const juce::XmlElement* element);
 
+        /** @brief True for CONTAINER elements, whose children are placed inside them in their own coordinate space. */
+        static bool isContainerElement (const juce::XmlElement& element);
+
+        /**
+         * @brief Lists the elements under parent in document order, descending into CONTAINER elements.
+         *
+         * The contents of a container follow it; containers receives, per element, the index of
+         * the container it is in, or containerIndex for the direct children of parent.
+         */
+        static void collectElements (const juce::XmlElement& parent,
+                                     std::vector<const juce::XmlElement*>& elements,
+                                     std::vector<int>& containers,
+                                     int containerIndex = -1);
+
     private:
-        void parseXML(const juce::String& xmlContent);
+        struct DeferredGroup;
+
+        /** @brief True for the GROUP and PAGE elements, whose children are only built by showGroup(). */
+        static bool isGroupElement (const juce::XmlElement& element);
+
+        /**
+         * @brief Takes the groups of a freshly parsed document over from the previous ones.
+         *
+         * Built groups whose element is unchanged and that don't use one of changedAssets are
+         * kept; the others are released, and rebuilt if they were visible.
+         */
+        void updateDeferredGroups (const juce::XmlElement& xmlDocument, const juce::StringArray& changedAssets);
+
+        /** @brief Submits the preparation of a group's components; they are created on the message thread afterwards. */
+        void startBuildingGroup (const std::shared_ptr<DeferredGroup>& group);
+
+        /** @brief Creates the components of a group whose blueprints are prepared. */
+        void finishBuildingGroup (DeferredGroup& group);
+
+        /**
+         * @brief Moves the top-level components of a built group to where its element is in the document.
+         *
+         * They are drawn in front of the elements before the GROUP and behind the ones after it.
+         */
+        void stackGroupComponents (DeferredGroup& group);
+
+        /** @brief The first top-level component of the elements after a group, or nullptr if the group goes on top. */
+        juce::Component* getComponentAfterGroup (const DeferredGroup& group) const;
+
+        /** @brief Shows or hides the top-level components of a built group. */
+        void setGroupComponentsVisible (DeferredGroup& group, bool shouldBeVisible);
+
+        /** @brief Cancels a pending build and destroys the components of a group. */
+        void releaseGroup (DeferredGroup& group);
+
+        /** @brief Drops a group's pending preparations; they are waited for by the destructor, since they use the factories. */
+        void abandonPreparations (DeferredGroup& group);
+
+        /** @brief Acquires the plan for the loaded XML and applies it; returns false if the XML can't be parsed. */
+        bool updateFromXML (const juce::StringArray& changedAssets);
+
+        /**
+         * @brief Creates the components of a parsed plan, placing the contents of CONTAINER elements inside them.
+         *
+         * Components of previousPlan whose element is unchanged, or differs only
+         * in x/y/width/height, and that don't use one of changedAssets are reused.
+         * Containers are reused by name.
+         */
+        void parseXML(const WarmUIPlan& plan,
+                      const WarmUIPlan* previousPlan,
+                      const juce::StringArray& changedAssets);
+
+        /** @brief Instantiates a prepared blueprint, or falls back to the factory's createComponent(). */
+        juce::Component* createComponentForElement (const juce::XmlElement& element,
+                                                    ComponentFactory* factory,
+                                                    std::future<std::unique_ptr<const ComponentBlueprint>>& blueprint,
+                                                    LoadRecorder* recorder);
+
+        /** @brief True if a component built from previousElement can stand in for one built from element. */
+        static bool canReuseComponent (const juce::XmlElement& previousElement,
+                                       const juce::XmlElement& element,
+                                       const ComponentMetadata& metadata,
+                                       const juce::StringArray& changedAssets);
+
+        /** @brief True if the component described by metadata loads the named asset. */
+        static bool usesAsset (const ComponentMetadata& metadata, const juce::String& assetName);
+
+        /** @brief Copies the user-facing control state of a replaced component to its replacement. */
+        static void transferControlState (juce::Component& source, juce::Component& destination);
+
+        /** @brief Hands the current plan back to the WarmUICache together with the images it needs. */
+        void releaseWarmPlan();
+
+        /** @brief Moves static IMAGE components that no live component sits beneath into the static layer. */
+        void updateStaticLayer();
+
+        /** @brief Returns the component's bounds in metadata (bitmap) coordinates. */
+        static juce::Rectangle<int> getSourceBounds (const juce::Component& component);
+
+        /** @brief The metadata area a component's source bounds are relative to, and the area of its parent it maps onto. */
+        struct LayoutSpace
+        {
+            juce::Rectangle<float> source, target;
+        };
+
+        LayoutSpace getLayoutSpace (const juce::Component& component) const;
 
         /** @brief Calculates transformed bounds for a component based on coordinate space mapping. */
         static juce::Rectangle<float> calculateTransformedBounds(
@@ -184,6 +494,26 @@ namespace BogrenDigital::UILoading
 
         BitmapLayout bitmapLayout;
 
+        juce::String loadedXmlFileName;
+        std::unique_ptr<AssetFileWatcher> assetFileWatcher;
+
+        std::shared_ptr<WarmUIPlan> warmPlan;
+        std::shared_ptr<DecodedImageCache> warmPlanImages;
+
+        std::unique_ptr<StaticLayerComponent> staticLayer;
+        bool staticLayerEnabled = false;
+        bool occlusionCullingEnabled = false;
+
+        std::unique_ptr<LoadReport> loadReport;
+        bool loadReportEnabled = false;
+
+        juce::File prefetchManifestFile;
+
+        std::unordered_map<juce::String, std::shared_ptr<DeferredGroup>> deferredGroups;
+        std::vector<std::future<std::unique_ptr<const ComponentBlueprint>>> abandonedPreparations;
+
+        std::unique_ptr<PaintProfilerOverlay> paintProfilerOverlay;
+
         std::unique_ptr<ComponentFactoryRegistry> componentFactoryRegistry;
     };
 }
@@ -0,0 +1,27 @@
+#include "TestHelpers.h"
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+TEST_CASE ("AssetFileWatcher reports added, modified and removed files relative to its directory")
+{
+    const TemporaryDirectory temporaryDirectory;
+    const auto& directory = temporaryDirectory.getFile();
+
+    directory.getChildFile ("metadata.xml").replaceWithText ("<UI/>");
+    directory.getChildFile ("images/knob_0.png").create();
+
+    AssetFileWatcher watcher (directory, nullptr);
+    REQUIRE (watcher.checkForChanges().isEmpty());
+
+    // Changing the size is detected even where modification times are coarse
+    directory.getChildFile ("metadata.xml").replaceWithText ("<UI width=\"100\"/>");
+    directory.getChildFile ("images/knob_0.png").deleteFile();
+    directory.getChildFile ("background.png").create();
+
+    auto changedFiles = watcher.checkForChanges();
+    changedFiles.sort (false);
+
+    REQUIRE (changedFiles == juce::StringArray ("background.png", "images/knob_0.png", "metadata.xml"));
+    REQUIRE (watcher.checkForChanges().isEmpty());
+}
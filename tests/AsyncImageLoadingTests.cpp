@@ -0,0 +1,74 @@
+#include "TestHelpers.h"
+
+#include <atomic>
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+TEST_CASE ("loadAsync loads files and sequences into one future per request")
+{
+    const TemporaryDirectory temporaryDirectory;
+    const auto& directory = temporaryDirectory.getFile();
+
+    writePng (directory.getChildFile ("background.png"), makeImage (20, 10));
+
+    for (int i = 0; i < 4; ++i)
+        writePng (directory.getChildFile ("knob_" + juce::String (i) + ".png"), makeImage (8, 8));
+
+    FileAssetImageLoader loader (directory);
+    std::atomic<int> numCallbacks { 0 };
+
+    const auto batch = loader.loadAsync ({ ImageRequest::file ("background.png"),
+                                           ImageRequest::sequence ("knob_", 4, ".png"),
+                                           ImageRequest::sequence ("knob_", juce::Array<int> { 3, 1 }, ".png"),
+                                           ImageRequest::file ("missing.png") },
+                                         [&] (int, const juce::Array<juce::Image>&) { ++numCallbacks; });
+
+    REQUIRE (batch->size() == 4);
+    batch->wait();
+    REQUIRE (batch->isFinished());
+    REQUIRE (numCallbacks == 4);
+
+    const auto background = batch->getFuture (0).get();
+    REQUIRE (background.size() == 1);
+    REQUIRE (background.getFirst().getBounds() == juce::Rectangle<int> (20, 10));
+
+    REQUIRE (batch->getFuture (1).get().size() == 4);
+    REQUIRE (batch->getFuture (2).get().size() == 2);
+    REQUIRE (batch->getFuture (3).get().isEmpty());
+
+    // Shares the loader's cache with the blocking calls
+    REQUIRE (loader.loadImageByFilename ("background.png").getPixelData() == background.getFirst().getPixelData());
+}
+
+TEST_CASE ("A cancelled batch still finishes every future")
+{
+    const TemporaryDirectory temporaryDirectory;
+    const auto& directory = temporaryDirectory.getFile();
+
+    std::vector<ImageRequest> requests;
+
+    for (int i = 0; i < 64; ++i)
+    {
+        writePng (directory.getChildFile ("frame_" + juce::String (i) + ".png"), makeImage (32, 32));
+        requests.push_back (ImageRequest::file ("frame_" + juce::String (i) + ".png"));
+    }
+
+    FileAssetImageLoader loader (directory);
+    std::atomic<int> numCallbacks { 0 };
+
+    const auto batch = loader.loadAsync (requests, [&] (int, const juce::Array<juce::Image>&) { ++numCallbacks; });
+    batch->cancel();
+    batch->wait();
+
+    REQUIRE (batch->isCancelled());
+    REQUIRE (batch->isFinished());
+
+    // Requests that started before the cancel still deliver their image
+    int numLoaded = 0;
+
+    for (int i = 0; i < batch->size(); ++i)
+        numLoaded += batch->getFuture (i).get().size();
+
+    REQUIRE (numLoaded == numCallbacks);
+}
@@ -0,0 +1,116 @@
+#include "TestHelpers.h"
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+namespace
+{
+    /** Adjusts the built-in image components through createComponent(), counting the preparations. */
+    class TaggingImageFactory : public ImageComponentFactory
+    {
+    public:
+        TaggingImageFactory (ImageLoader& imageLoader, std::atomic<int>* numPreparedToUse)
+            : ImageComponentFactory (imageLoader), numPrepared (*numPreparedToUse)
+        {
+        }
+
+        using ImageComponentFactory::createComponent;
+
+        std::unique_ptr<const ComponentBlueprint> prepare (const UILoader::ComponentMetadata& metadata) const override
+        {
+            ++numPrepared;
+            return ImageComponentFactory::prepare (metadata);
+        }
+
+        juce::Component* createComponent (const UILoader::ComponentMetadata& metadata) override
+        {
+            auto* component = ImageComponentFactory::createComponent (metadata);
+            component->getProperties().set ("tagged", true);
+            return component;
+        }
+
+    private:
+        std::atomic<int>& numPrepared;
+    };
+
+    /** Prepares slowly, and throws from instantiate() for elements named "throws". */
+    class ThrowingFactory : public ComponentFactory
+    {
+    public:
+        ThrowingFactory (ImageLoader& imageLoader, std::atomic<int>* numPreparedToUse)
+            : ComponentFactory (imageLoader), numPrepared (*numPreparedToUse)
+        {
+        }
+
+        std::unique_ptr<const ComponentBlueprint> prepare (const UILoader::ComponentMetadata& metadata) const override
+        {
+            if (metadata.name != "throws")
+                juce::Thread::sleep (50);
+
+            auto blueprint = std::make_unique<ComponentBlueprint>();
+            blueprint->metadata = metadata;
+            ++numPrepared;
+            return blueprint;
+        }
+
+        juce::Component* instantiate (const ComponentBlueprint& blueprint) override
+        {
+            if (blueprint.metadata.name == "throws")
+                throw std::runtime_error ("instantiate failed");
+
+            return new juce::Component();
+        }
+
+    private:
+        std::atomic<int>& numPrepared;
+    };
+
+    struct FactoryFixture
+    {
+        explicit FactoryFixture (const juce::String& xml)
+        {
+            writePng (directory.getChildFile ("background.png"), makeImage (16, 16, juce::Colours::blue));
+            REQUIRE (directory.getChildFile ("metadata.xml").replaceWithText (xml));
+        }
+
+        const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+        std::atomic<int> numPrepared { 0 };
+        const TemporaryDirectory temporaryDirectory;
+        const juce::File directory = temporaryDirectory.getFile();
+        juce::Component parent;
+        UILoader uiLoader { parent, directory };
+    };
+}
+
+TEST_CASE ("A factory overriding createComponent() builds prepared components without preparing them again")
+{
+    FactoryFixture ui (R"(<UI width="100" height="100">
+                              <IMAGE name="background" file="background.png" x="0" y="0" width="100" height="100" imageType="raster"/>
+                          </UI>)");
+
+    ui.uiLoader.getComponentFactoryRegistry().registerFactory<TaggingImageFactory> ("IMAGE", "raster", &ui.numPrepared);
+    ui.uiLoader.loadUI ("metadata.xml");
+
+    auto* component = ui.uiLoader.getComponentByName ("background");
+    REQUIRE (dynamic_cast<ImageComponent*> (component) != nullptr);
+    REQUIRE (static_cast<bool> (component->getProperties()["tagged"]));
+    REQUIRE (ui.numPrepared == 1);
+}
+
+TEST_CASE ("A factory throwing from instantiate() leaves no preparation running")
+{
+    FactoryFixture ui (R"(<UI width="100" height="100">
+                              <THROWING name="throws" x="0" y="0" width="10" height="10"/>
+                              <THROWING name="slow1" x="10" y="0" width="10" height="10"/>
+                              <THROWING name="slow2" x="20" y="0" width="10" height="10"/>
+                          </UI>)");
+
+    ui.uiLoader.getComponentFactoryRegistry().registerFactory<ThrowingFactory> ("THROWING", "", &ui.numPrepared);
+
+    // The first element throws while the others are still being prepared
+    REQUIRE_THROWS_AS (ui.uiLoader.loadUI ("metadata.xml"), std::runtime_error);
+    REQUIRE (ui.numPrepared == 3);
+}
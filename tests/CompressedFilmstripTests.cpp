@@ -0,0 +1,107 @@
+#include "TestHelpers.h"
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+namespace
+{
+    // A knob-like filmstrip: a disc on a transparent background with a pointer that moves per frame
+    juce::Array<juce::Image> makeFrames (int numFrames, int size)
+    {
+        juce::Array<juce::Image> frames;
+
+        for (int frame = 0; frame < numFrames; ++frame)
+        {
+            juce::Image image (juce::Image::ARGB, size, size, true);
+            juce::Graphics g (image);
+            g.setColour (juce::Colours::darkgrey);
+            g.fillEllipse (2.0f, 2.0f, (float) size - 4.0f, (float) size - 4.0f);
+
+            const auto angle = juce::MathConstants<float>::twoPi * (float) frame / (float) numFrames;
+            const auto centre = (float) size / 2.0f;
+            g.setColour (juce::Colours::white.withAlpha (0.8f));
+            g.drawLine (centre, centre, centre + std::sin (angle) * centre * 0.8f, centre - std::cos (angle) * centre * 0.8f, 3.0f);
+
+            frames.add (image);
+        }
+
+        return frames;
+    }
+
+    void writeFrames (const juce::File& directory, const juce::String& prefix, const juce::Array<juce::Image>& frames)
+    {
+        for (int i = 0; i < frames.size(); ++i)
+            writePng (directory.getChildFile (prefix + juce::String (i) + ".png"), frames[i]);
+    }
+}
+
+TEST_CASE ("CompressedFilmstrip decodes every frame exactly, in any order")
+{
+    const auto frames = makeFrames (40, 48);
+    const auto filmstrip = CompressedFilmstrip::create (frames);
+
+    REQUIRE (filmstrip != nullptr);
+    REQUIRE (filmstrip->size() == frames.size());
+    REQUIRE (filmstrip->getCompressedBytes() < filmstrip->getDecodedBytes() / 2);
+
+    CompressedFilmstrip::FrameCache cache (filmstrip);
+
+    for (int i = 0; i < frames.size(); ++i)
+        REQUIRE (imagesMatch (frames[i], cache.getFrame (i)));
+
+    for (const auto i : { 39, 3, 17, 16, 15, 31, 0, 39, 38 })
+        REQUIRE (imagesMatch (frames[i], cache.getFrame (i)));
+
+    REQUIRE_FALSE (cache.getFrame (frames.size()).isValid());
+}
+
+TEST_CASE ("CompressedFilmstrip rejects frames of different sizes")
+{
+    auto frames = makeFrames (3, 16);
+    frames.add (juce::Image (juce::Image::ARGB, 17, 16, true));
+
+    REQUIRE (CompressedFilmstrip::create (frames) == nullptr);
+    REQUIRE (CompressedFilmstrip::create ({}) == nullptr);
+}
+
+TEST_CASE ("The memory report counts compressed frames and the decoded cache")
+{
+    const auto filmstrip = CompressedFilmstrip::create (makeFrames (8, 32));
+    CompressedFilmstrip::FrameCache cache (filmstrip, 2);
+    cache.getFrame (0);
+    cache.getFrame (5);
+    cache.getFrame (7);
+
+    MemoryReport::Entry entry { "knob", "KNOB", {} };
+    cache.getImagesForMemoryReport (entry.images);
+    REQUIRE (entry.images.caches.size() == 2);
+
+    const auto report = MemoryReport::create ({ entry });
+    REQUIRE (report.components.front().compressedBytes == filmstrip->getCompressedBytes());
+    REQUIRE (report.totalBytes == filmstrip->getCompressedBytes() + 2 * 32 * 32 * 4);
+}
+
+TEST_CASE ("Compressed knobs release their decoded frames from the loader's cache and the SharedImagePool")
+{
+    const TemporaryDirectory temporaryDirectory;
+    const auto& directory = temporaryDirectory.getFile();
+    writeFrames (directory, "knob_", makeFrames (8, 24));
+
+    const juce::SharedResourcePointer<SharedImagePool> sharedImagePool;
+    sharedImagePool->releaseUnusedImages();
+    const auto numPooledImages = sharedImagePool->getNumImages();
+
+    FileAssetImageLoader loader (directory);
+    const KnobComponentFactory factory (loader);
+    const auto blueprint = factory.prepare (UILoader::ComponentMetadata().withType ("KNOB").withName ("knob").withFileNamePrefix ("knob_")
+                                                .withFileNameSuffix (".png").withNumberOfFrames (8).withFrameStorage ("compressed"));
+
+    REQUIRE (blueprint->compressedImages != nullptr);
+    REQUIRE (blueprint->images.isEmpty());
+
+    for (int i = 0; i < 8; ++i)
+        REQUIRE_FALSE (loader.getDecodedImageCache().contains (loader.getCacheKey ("knob_" + juce::String (i) + ".png")));
+
+    REQUIRE (loader.getDecodedImageCache().getStatistics().cachedImages == 0);
+    REQUIRE (sharedImagePool->getNumImages() == numPooledImages);
+}
@@ -0,0 +1,180 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <bd_ui_loader/bd_ui_loader.h>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+
+using namespace BogrenDigital::UILoading;
+
+namespace
+{
+    // 10x10 ARGB -> 400 bytes per image, so budgets below are easy to reason about.
+    juce::Image makeImage()
+    {
+        return juce::Image (juce::Image::ARGB, 10, 10, true);
+    }
+
+    std::function<juce::Image()> decodeInto (int& decodeCount)
+    {
+        return [&decodeCount] {
+            ++decodeCount;
+            return makeImage();
+        };
+    }
+}
+
+TEST_CASE ("LruImageCache counts hits and misses and only decodes once per key")
+{
+    LruImageCache cache;
+    int decodeCount = 0;
+
+    const auto first = cache.getOrDecode (1, decodeInto (decodeCount));
+    const auto second = cache.getOrDecode (1, decodeInto (decodeCount));
+
+    REQUIRE (first.isValid());
+    REQUIRE (decodeCount == 1);
+    REQUIRE (first.getPixelData() == second.getPixelData());
+
+    const auto statistics = cache.getStatistics();
+    REQUIRE (statistics.hits == 1);
+    REQUIRE (statistics.misses == 1);
+    REQUIRE (statistics.cachedImages == 1);
+    REQUIRE (statistics.cachedBytes == 400);
+}
+
+TEST_CASE ("LruImageCache never stores invalid images")
+{
+    LruImageCache cache;
+
+    REQUIRE_FALSE (cache.getOrDecode (7, [] { return juce::Image(); }).isValid());
+    REQUIRE (cache.getStatistics().cachedImages == 0);
+}
+
+TEST_CASE ("LruImageCache evicts least recently used unreferenced images over budget")
+{
+    LruImageCache cache (800);
+    int decodeCount = 0;
+
+    // Results are discarded, so only the cache references these images.
+    (void) cache.getOrDecode (1, decodeInto (decodeCount));
+    (void) cache.getOrDecode (2, decodeInto (decodeCount));
+    (void) cache.getOrDecode (1, decodeInto (decodeCount)); // 1 is now most recently used
+    (void) cache.getOrDecode (3, decodeInto (decodeCount)); // over budget -> 2 goes
+
+    REQUIRE (decodeCount == 3);
+    REQUIRE (cache.getStatistics().evictions == 1);
+    REQUIRE (cache.getStatistics().cachedBytes == 800);
+
+    (void) cache.getOrDecode (1, decodeInto (decodeCount));
+    REQUIRE (decodeCount == 3);
+
+    (void) cache.getOrDecode (2, decodeInto (decodeCount));
+    REQUIRE (decodeCount == 4);
+}
+
+TEST_CASE ("LruImageCache keeps images that are still referenced")
+{
+    LruImageCache cache (400);
+    int decodeCount = 0;
+
+    const auto held1 = cache.getOrDecode (1, decodeInto (decodeCount));
+    const auto held2 = cache.getOrDecode (2, decodeInto (decodeCount));
+
+    // Both are in use, so the cache may exceed its budget rather than drop them.
+    REQUIRE (cache.getStatistics().cachedImages == 2);
+    REQUIRE (cache.getStatistics().evictions == 0);
+
+    cache.purge();
+    REQUIRE (cache.getStatistics().cachedImages == 0);
+    REQUIRE (held1.isValid());
+    REQUIRE (held2.isValid());
+}
+
+TEST_CASE ("LruImageCache decodes again after an entry is removed")
+{
+    LruImageCache cache;
+    int decodeCount = 0;
+
+    (void) cache.getOrDecode (1, decodeInto (decodeCount));
+    cache.remove (1);
+    cache.remove (2); // Unknown keys are ignored
+
+    REQUIRE (cache.getStatistics().cachedImages == 0);
+    REQUIRE (cache.getStatistics().cachedBytes == 0);
+
+    (void) cache.getOrDecode (1, decodeInto (decodeCount));
+    REQUIRE (decodeCount == 2);
+}
+
+TEST_CASE ("DecodedImageCache::contains neither counts nor decodes")
+{
+    LruImageCache cache;
+    int decodeCount = 0;
+
+    REQUIRE_FALSE (cache.contains (4));
+    (void) cache.getOrDecode (4, decodeInto (decodeCount));
+    REQUIRE (cache.contains (4));
+
+    const auto statistics = cache.getStatistics();
+    REQUIRE (statistics.hits == 0);
+    REQUIRE (statistics.misses == 1);
+}
+
+TEST_CASE ("Concurrent misses on the same key decode once")
+{
+    LruImageCache cache;
+    std::atomic<int> decodeCount { 0 };
+    juce::WaitableEvent decodeStarted, finishDecode;
+
+    auto first = std::async (std::launch::async, [&] {
+        return cache.getOrDecode (5, [&] {
+            ++decodeCount;
+            decodeStarted.signal();
+            finishDecode.wait();
+            return makeImage();
+        });
+    });
+
+    REQUIRE (decodeStarted.wait (5000));
+
+    auto second = std::async (std::launch::async, [&] {
+        return cache.getOrDecode (5, [&] {
+            ++decodeCount;
+            return makeImage();
+        });
+    });
+
+    // Give the second call time to find the decode in flight before it finishes
+    juce::Thread::sleep (50);
+    finishDecode.signal();
+
+    REQUIRE (first.get().getPixelData() == second.get().getPixelData());
+    REQUIRE (decodeCount == 1);
+    REQUIRE (cache.getStatistics().misses == 1);
+    REQUIRE (cache.getStatistics().hits == 1);
+}
+
+TEST_CASE ("A throwing decode leaves nothing in flight")
+{
+    LruImageCache cache;
+    int decodeCount = 0;
+
+    REQUIRE_THROWS_AS (cache.getOrDecode (9, [] () -> juce::Image { throw std::runtime_error ("corrupt asset"); }),
+                       std::runtime_error);
+
+    // The next request decodes again instead of waiting for the failed one
+    REQUIRE (cache.getOrDecode (9, decodeInto (decodeCount)).isValid());
+    REQUIRE (decodeCount == 1);
+    REQUIRE (cache.getStatistics().misses == 2);
+}
+
+TEST_CASE ("Loaders start with a budgeted LruImageCache")
+{
+    const FileAssetImageLoader loader (juce::File::getSpecialLocation (juce::File::tempDirectory));
+    const auto* cache = dynamic_cast<const LruImageCache*> (&loader.getDecodedImageCache());
+
+    REQUIRE (cache != nullptr);
+    REQUIRE (cache->getByteBudget() == LruImageCache::defaultByteBudget);
+}
@@ -0,0 +1,193 @@
+#include "TestHelpers.h"
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+namespace
+{
+    juce::Image makeTestImage (juce::Image::PixelFormat format, int width, int height)
+    {
+        juce::Image image (format, width, height, true);
+        juce::Random random (7);
+
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                // Gradients, flat areas and noise, so the encoder picks a mix of row filters
+                const auto alpha = format == juce::Image::RGB ? 255 : (y % 4 == 0 ? 255 : (x * 13 + y * 7) % 256);
+                const auto colour = y % 5 == 0 ? juce::Colour ((juce::uint8) 30, (juce::uint8) 120, (juce::uint8) 220, (juce::uint8) alpha)
+                                               : juce::Colour ((juce::uint8) (x * 3), (juce::uint8) random.nextInt (256), (juce::uint8) (x + y), (juce::uint8) alpha);
+                image.setPixelAt (x, y, colour);
+            }
+        }
+
+        return image;
+    }
+
+    juce::uint32 updateCrc (juce::uint32 crc, const void* data, size_t numBytes)
+    {
+        for (size_t i = 0; i < numBytes; ++i)
+        {
+            crc ^= static_cast<const juce::uint8*> (data)[i];
+
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc >> 1) ^ (0xedb88320u & (0u - (crc & 1u)));
+        }
+
+        return crc;
+    }
+
+    void writeChunk (juce::MemoryOutputStream& png, const char* type, const juce::MemoryBlock& data)
+    {
+        png.writeIntBigEndian ((int) data.getSize());
+        png.write (type, 4);
+        png.write (data.getData(), data.getSize());
+        png.writeIntBigEndian ((int) ~updateCrc (updateCrc (0xffffffffu, type, 4), data.getData(), data.getSize()));
+    }
+
+    /**
+     * Encodes 8-bit samples of a colour type juce::PNGImageFormat doesn't write (greyscale,
+     * greyscale-alpha or palette), cycling through the five row filters.
+     */
+    juce::MemoryBlock encodeRawPng (int colourType, int width, int height, const std::vector<juce::uint8>& samples,
+                                    const juce::MemoryBlock& palette = {}, const juce::MemoryBlock& transparency = {})
+    {
+        juce::MemoryOutputStream png;
+        const juce::uint8 signature[] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+        png.write (signature, sizeof (signature));
+
+        juce::MemoryOutputStream header;
+        header.writeIntBigEndian (width);
+        header.writeIntBigEndian (height);
+
+        for (const auto byte : { 8, colourType, 0, 0, 0 })
+            header.writeByte ((char) byte);
+
+        writeChunk (png, "IHDR", header.getMemoryBlock());
+
+        if (! palette.isEmpty())
+            writeChunk (png, "PLTE", palette);
+
+        if (! transparency.isEmpty())
+            writeChunk (png, "tRNS", transparency);
+
+        const auto rowBytes = samples.size() / (size_t) height;
+        const auto bytesPerPixel = rowBytes / (size_t) width;
+        juce::MemoryOutputStream compressed;
+
+        {
+            juce::GZIPCompressorOutputStream zlib (compressed);
+
+            for (size_t y = 0; y < (size_t) height; ++y)
+            {
+                const auto* row = samples.data() + y * rowBytes;
+                const auto* prior = y > 0 ? row - rowBytes : nullptr;
+                const auto filter = (int) (y % 5);
+                zlib.writeByte ((char) filter);
+
+                for (size_t i = 0; i < rowBytes; ++i)
+                {
+                    const int a = i >= bytesPerPixel ? row[i - bytesPerPixel] : 0;
+                    const int b = prior != nullptr ? prior[i] : 0;
+                    const int c = prior != nullptr && i >= bytesPerPixel ? prior[i - bytesPerPixel] : 0;
+                    const int p = a + b - c;
+                    const int paeth = std::abs (p - a) <= std::abs (p - b) && std::abs (p - a) <= std::abs (p - c) ? a
+                                                                                                                   : (std::abs (p - b) <= std::abs (p - c) ? b : c);
+                    const int predictions[] = { 0, a, b, (a + b) / 2, paeth };
+                    zlib.writeByte ((char) (juce::uint8) (row[i] - predictions[filter]));
+                }
+            }
+        }
+
+        writeChunk (png, "IDAT", compressed.getMemoryBlock());
+        writeChunk (png, "IEND", {});
+        return png.getMemoryBlock();
+    }
+
+    std::vector<juce::uint8> makeSamples (int width, int height, int samplesPerPixel, int numValues)
+    {
+        std::vector<juce::uint8> samples;
+        juce::Random random (11);
+
+        for (int y = 0; y < height; ++y)
+            for (int x = 0; x < width * samplesPerPixel; ++x)
+                samples.push_back ((juce::uint8) (y % 3 == 0 ? (x * 7) % numValues : random.nextInt (numValues)));
+
+        return samples;
+    }
+
+    bool imagesAreIdentical (const juce::Image& a, const juce::Image& b)
+    {
+        return a.getFormat() == b.getFormat() && imagesMatch (a, b);
+    }
+}
+
+TEST_CASE ("FastPngDecoder matches juce::PNGImageFormat")
+{
+    for (const auto format : { juce::Image::ARGB, juce::Image::RGB })
+    {
+        const auto png = encodePng (makeTestImage (format, 53, 31));
+
+        REQUIRE (FastPngDecoder::isPng (png.getData(), png.getSize()));
+
+        const auto decoded = FastPngDecoder::decode (png.getData(), png.getSize());
+        REQUIRE (decoded.isValid());
+        REQUIRE (imagesAreIdentical (juce::ImageFileFormat::loadFrom (png.getData(), png.getSize()), decoded));
+    }
+}
+
+TEST_CASE ("FastPngDecoder matches juce::PNGImageFormat for greyscale and palette PNGs")
+{
+    const juce::uint8 palette[] = { 255, 0, 0, 0, 255, 0, 0, 0, 255, 200, 200, 40 };
+    const juce::uint8 transparency[] = { 0, 128, 255 }; // The last entry is implicitly opaque
+
+    const juce::MemoryBlock fixtures[] = {
+        encodeRawPng (0, 13, 7, makeSamples (13, 7, 1, 256)),
+        encodeRawPng (4, 13, 7, makeSamples (13, 7, 2, 256)),
+        encodeRawPng (3, 13, 7, makeSamples (13, 7, 1, 4), { palette, sizeof (palette) }, { transparency, sizeof (transparency) }),
+    };
+
+    for (const auto& png : fixtures)
+    {
+        const auto expected = juce::ImageFileFormat::loadFrom (png.getData(), png.getSize());
+        REQUIRE (expected.isValid());
+
+        const auto decoded = FastPngDecoder::decode (png.getData(), png.getSize());
+        REQUIRE (decoded.isValid());
+        REQUIRE (imagesAreIdentical (expected, decoded));
+    }
+}
+
+TEST_CASE ("FastPngDecoder rejects truncated and foreign data")
+{
+    const auto png = encodePng (makeTestImage (juce::Image::ARGB, 8, 8));
+
+    REQUIRE_FALSE (FastPngDecoder::decode (png.getData(), png.getSize() / 2).isValid());
+
+    const juce::String text ("not an image");
+    REQUIRE_FALSE (FastPngDecoder::isPng (text.toRawUTF8(), text.getNumBytesAsUTF8()));
+    REQUIRE_FALSE (FastPngDecoder::decode (text.toRawUTF8(), text.getNumBytesAsUTF8()).isValid());
+}
+
+TEST_CASE ("Loaders decode PNGs identically with either decoder")
+{
+    const TemporaryDirectory temporaryDirectory;
+    const auto& directory = temporaryDirectory.getFile();
+
+    // The SharedImagePool shares decodes of identical bytes, so each loader gets a file of its own
+    const auto fastPng = encodePng (makeTestImage (juce::Image::ARGB, 19, 11));
+    const auto jucePng = encodePng (makeTestImage (juce::Image::ARGB, 17, 13));
+    REQUIRE (directory.getChildFile ("fast.png").replaceWithData (fastPng.getData(), fastPng.getSize()));
+    REQUIRE (directory.getChildFile ("juce.png").replaceWithData (jucePng.getData(), jucePng.getSize()));
+    REQUIRE (directory.getChildFile ("notes.png").replaceWithText ("not an image"));
+
+    FileAssetImageLoader fastLoader (directory);
+    FileAssetImageLoader juceLoader (directory);
+    juceLoader.setPngDecoder (ImageLoader::PngDecoder::juce);
+
+    REQUIRE (fastLoader.getPngDecoder() == ImageLoader::PngDecoder::fast);
+    REQUIRE (imagesAreIdentical (juce::ImageFileFormat::loadFrom (fastPng.getData(), fastPng.getSize()), fastLoader.loadImageByFilename ("fast.png")));
+    REQUIRE (imagesAreIdentical (juce::ImageFileFormat::loadFrom (jucePng.getData(), jucePng.getSize()), juceLoader.loadImageByFilename ("juce.png")));
+    REQUIRE_FALSE (fastLoader.loadImageByFilename ("notes.png").isValid());
+}
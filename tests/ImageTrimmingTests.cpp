@@ -0,0 +1,80 @@
+#include "TestHelpers.h"
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+namespace
+{
+    void writeFrame (const juce::File& directory, const juce::String& name, juce::Rectangle<int> visibleArea)
+    {
+        auto frame = makeImage (16, 16);
+        frame.clear (visibleArea, juce::Colours::red);
+        writePng (directory.getChildFile (name), frame);
+    }
+}
+
+TEST_CASE ("ImageTrimming crops transparent borders and places the frame back")
+{
+    juce::Image frame (juce::Image::ARGB, 20, 20, true);
+    frame.clear ({ 5, 6, 4, 3 }, juce::Colours::red);
+    frame.setPixelAt (8, 8, juce::Colours::blue);
+
+    const auto trimmed = ImageTrimming::trim (frame);
+
+    REQUIRE (ImageTrimming::isTrimmed (trimmed));
+    REQUIRE (trimmed.getBounds() == juce::Rectangle<int> (0, 0, 4, 3));
+    REQUIRE (trimmed.getPixelAt (0, 0) == juce::Colours::red);
+    REQUIRE (trimmed.getPixelAt (3, 2) == juce::Colours::blue);
+
+    // Drawn at twice the frame's size, the pixels land where they were, scaled
+    REQUIRE (ImageTrimming::getDrawArea (trimmed, { 100.0f, 0.0f, 40.0f, 40.0f }) == juce::Rectangle<float> (110.0f, 12.0f, 8.0f, 6.0f));
+}
+
+TEST_CASE ("ImageTrimming leaves images without transparent borders alone")
+{
+    const auto opaque = makeImage (8, 8, juce::Colours::green);
+
+    const auto result = ImageTrimming::trim (opaque);
+
+    REQUIRE (result.getPixelData() == opaque.getPixelData());
+    REQUIRE_FALSE (ImageTrimming::isTrimmed (result));
+    REQUIRE (ImageTrimming::getDrawArea (result, { 1.0f, 2.0f, 3.0f, 4.0f }) == juce::Rectangle<float> (1.0f, 2.0f, 3.0f, 4.0f));
+}
+
+TEST_CASE ("ImageTrimming reduces a fully transparent frame to one pixel")
+{
+    const juce::Image transparent (juce::Image::ARGB, 30, 10, true);
+    const auto trimmed = ImageTrimming::trim (transparent);
+
+    REQUIRE (trimmed.getBounds() == juce::Rectangle<int> (0, 0, 1, 1));
+    REQUIRE (trimmed.getPixelAt (0, 0).getAlpha() == 0);
+}
+
+TEST_CASE ("Trimmed filmstrips cache only their cropped frames, shared by the elements using them")
+{
+    const TemporaryDirectory temporaryDirectory;
+    const auto& directory = temporaryDirectory.getFile();
+    writeFrame (directory, "led_0.png", { 2, 3, 4, 5 });
+    writeFrame (directory, "led_1.png", { 9, 1, 6, 2 });
+
+    FileAssetImageLoader loader (directory);
+    const KnobComponentFactory factory (loader);
+    const auto metadata = UILoader::ComponentMetadata().withType ("KNOB").withName ("led").withFileNamePrefix ("led_")
+                              .withFileNameSuffix (".png").withNumberOfFrames (2).withFrameStorage ("trimmed");
+
+    const auto first = factory.prepare (metadata);
+    const auto second = factory.prepare (UILoader::ComponentMetadata (metadata).withName ("other_led"));
+
+    REQUIRE (first->images.size() == 2);
+    REQUIRE (first->images[0].getBounds() == juce::Rectangle<int> (0, 0, 4, 5));
+    REQUIRE (first->images[1].getBounds() == juce::Rectangle<int> (0, 0, 6, 2));
+    REQUIRE (ImageTrimming::isTrimmed (first->images[0]));
+
+    for (int i = 0; i < 2; ++i)
+    {
+        REQUIRE (second->images[i].getPixelData() == first->images[i].getPixelData());
+        REQUIRE_FALSE (loader.getDecodedImageCache().contains (loader.getCacheKey ("led_" + juce::String (i) + ".png")));
+    }
+
+    REQUIRE (loader.getDecodedImageCache().getStatistics().cachedImages == 2);
+}
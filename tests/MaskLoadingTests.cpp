@@ -0,0 +1,81 @@
+#include "TestHelpers.h"
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+namespace
+{
+    juce::Image makeMask()
+    {
+        juce::Image image (juce::Image::ARGB, 16, 16, true);
+
+        for (int y = 0; y < 16; ++y)
+            for (int x = 0; x < 16; ++x)
+                image.setPixelAt (x, y, juce::Colours::white.withAlpha ((juce::uint8) (x * 16 + y)));
+
+        return image;
+    }
+}
+
+TEST_CASE ("Masks are loaded as single-channel images holding the alpha channel")
+{
+    const TemporaryDirectory temporaryDirectory;
+    const auto& directory = temporaryDirectory.getFile();
+
+    writePng (directory.getChildFile ("knob_mask.png"), makeMask());
+
+    FileAssetImageLoader loader (directory);
+    const auto image = loader.loadImageByFilename ("knob_mask.png");
+    const auto mask = loader.loadMaskByFilename ("knob_mask.png");
+
+    REQUIRE (image.getFormat() == juce::Image::ARGB);
+    REQUIRE (mask.getFormat() == juce::Image::SingleChannel);
+    REQUIRE (mask.getBounds() == image.getBounds());
+
+    for (int y = 0; y < 16; ++y)
+        for (int x = 0; x < 16; ++x)
+            REQUIRE (mask.getPixelAt (x, y).getAlpha() == image.getPixelAt (x, y).getAlpha());
+
+    // Cached apart from the image, so loading it again is a hit
+    REQUIRE (loader.loadMaskByFilename ("knob_mask.png").getPixelData() == mask.getPixelData());
+    REQUIRE (DecodedImageCache::getImageSizeInBytes (mask) * 4 == DecodedImageCache::getImageSizeInBytes (image));
+}
+
+TEST_CASE ("Single-channel masks can be turned off per loader")
+{
+    const TemporaryDirectory temporaryDirectory;
+    const auto& directory = temporaryDirectory.getFile();
+
+    writePng (directory.getChildFile ("hitbox.png"), makeMask());
+
+    FileAssetImageLoader loader (directory);
+    loader.setSingleChannelMasks (false);
+
+    REQUIRE (loader.loadMaskByFilename ("hitbox.png").getFormat() == juce::Image::ARGB);
+    REQUIRE_FALSE (loader.loadMaskByFilename ("missing.png").isValid());
+}
+
+TEST_CASE ("A component masked with a single-channel mask paints through DeferredImageResampler")
+{
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    const TemporaryDirectory temporaryDirectory;
+
+    // Hides the left half
+    auto halfMask = makeImage (16, 16, juce::Colours::white);
+    halfMask.clear ({ 0, 0, 8, 16 });
+    writePng (temporaryDirectory.getChildFile ("panel_mask.png"), halfMask);
+
+    FileAssetImageLoader loader (temporaryDirectory.getFile());
+    const auto mask = loader.loadMaskByFilename ("panel_mask.png");
+    REQUIRE (mask.getFormat() == juce::Image::SingleChannel);
+
+    ImageComponent component ("panel", makeImage (16, 16, juce::Colours::red), {}, mask);
+    component.setBounds (0, 0, 16, 16);
+
+    const auto snapshot = component.createComponentSnapshot (component.getLocalBounds());
+
+    // Away from the mask's edge, so resampling can't blur either side
+    REQUIRE (snapshot.getPixelAt (3, 8).getAlpha() == 0);
+    REQUIRE (snapshot.getPixelAt (12, 8).getAlpha() == 255);
+    REQUIRE (snapshot.getPixelAt (12, 8).getRed() == 255);
+}
@@ -0,0 +1,79 @@
+#include "TestHelpers.h"
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+TEST_CASE ("MemoryReport counts each pixel buffer once and separates shared from exclusive bytes")
+{
+    const auto background = makeImage (16, 16, juce::Colours::black);
+    const auto frame = makeImage (8, 8, juce::Colours::red);
+    const auto imageBytes = DecodedImageCache::getImageSizeInBytes (background);
+    const auto frameBytes = DecodedImageCache::getImageSizeInBytes (frame);
+
+    std::vector<MemoryReport::Entry> entries (2);
+    entries[0].name = "Background";
+    entries[0].type = "IMAGE";
+    entries[0].images.images.add (background);
+    entries[0].images.images.add (frame);
+
+    // The same handle again, as a ScaledImageSet would add it
+    entries[1].name = "Knob";
+    entries[1].type = "KNOB";
+    entries[1].images.images.add (frame);
+    entries[1].images.images.add (frame);
+
+    const auto report = MemoryReport::create (entries);
+
+    REQUIRE (report.totalBytes == imageBytes + frameBytes);
+    REQUIRE (report.exclusiveBytes == imageBytes);
+    REQUIRE (report.sharedBytes == frameBytes);
+
+    REQUIRE (report.components[0].name == "Background");
+    REQUIRE (report.components[0].exclusiveBytes == imageBytes);
+    REQUIRE (report.components[0].sharedBytes == frameBytes);
+    REQUIRE (report.components[1].numImages == 1);
+    REQUIRE (report.types.size() == 2);
+    REQUIRE (report.waste.empty());
+}
+
+TEST_CASE ("MemoryReport flags duplicate pixels and each scale that was never drawn")
+{
+    const auto frame = makeImage (8, 8, juce::Colours::red);
+    const auto frameBytes = DecodedImageCache::getImageSizeInBytes (frame);
+    const auto frame2x = makeImage (16, 16, juce::Colours::blue);
+    const auto frame1_5x = makeImage (12, 12, juce::Colours::green);
+
+    std::vector<MemoryReport::Entry> entries (1);
+    entries[0].name = "Knob";
+    entries[0].type = "KNOB";
+    entries[0].images.images.add (frame);
+    entries[0].images.images.add (makeImage (8, 8, juce::Colours::red));
+    entries[0].images.scaledImages.push_back ({ 1.5, { frame1_5x }, 0, false });
+    entries[0].images.scaledImages.push_back ({ 2.0, { frame2x }, 0, true });
+
+    auto report = MemoryReport::create (entries);
+
+    REQUIRE (report.components[0].scaledImageBytes == DecodedImageCache::getImageSizeInBytes (frame1_5x) + DecodedImageCache::getImageSizeInBytes (frame2x));
+    REQUIRE (report.waste.size() == 2);
+    REQUIRE (report.waste[0].kind == MemoryReport::Waste::Kind::undrawnScale);
+    REQUIRE (report.waste[0].scale == 1.5);
+    REQUIRE (report.waste[0].bytes == DecodedImageCache::getImageSizeInBytes (frame1_5x));
+    REQUIRE (report.waste[1].kind == MemoryReport::Waste::Kind::duplicatePixels);
+    REQUIRE (report.waste[1].bytes == frameBytes);
+    REQUIRE (report.toString().contains ("1.5x images never drawn in Knob"));
+
+    // A compressed scale counts with its encoded size
+    entries[0].images.scaledImages[0] = { 1.5, {}, 100, false };
+    report = MemoryReport::create (entries);
+
+    REQUIRE (report.waste.size() == 2);
+    REQUIRE (report.waste[0].kind == MemoryReport::Waste::Kind::duplicatePixels);
+    REQUIRE (report.waste[1].kind == MemoryReport::Waste::Kind::undrawnScale);
+    REQUIRE (report.waste[1].bytes == 100);
+
+    entries[0].images.scaledImages[0].drawn = true;
+    report = MemoryReport::create (entries);
+
+    REQUIRE (report.waste.size() == 1);
+    REQUIRE (report.waste[0].kind == MemoryReport::Waste::Kind::duplicatePixels);
+}
@@ -136,10 +136,9 @@ TEST_CASE ("PackedAssetImageLoader loadImageSequence drops missing frames")
     // requested count. Consumers (e.g. KnobComponentFactory) rely on .size()
     // to decide frame count / @2x fallback.
     //
-    // Use a prefix unique to this case: the loader memoizes into the global
-    // juce::ImageCache, so reusing another case's frame name (e.g. "Knob_1.png")
-    // would let the absent frame resolve from that cache and defeat the test.
-    // In production each knob filmstrip has a unique prefix and a genuinely
+    // Use a prefix unique to this case anyway: with a shared DecodedImageCache
+    // (e.g. GlobalImageCache) reusing another case's frame name would let the
+    // absent frame resolve from that cache and defeat the test. A genuinely
     // missing frame is never cached, so drop semantics hold.
     const int w = 8, h = 4;
     std::vector<pt::packedassets::InputEntry> entries {
@@ -180,10 +179,9 @@ TEST_CASE ("PackedAssetImageLoader tolerates a null source")
     REQUIRE (loader.getStringFromAsset ("x.xml").isEmpty());
 }
 
-TEST_CASE ("PackedAssetImageLoader memoizes decoded images in ImageCache")
+TEST_CASE ("PackedAssetImageLoader memoizes decoded images in its DecodedImageCache")
 {
-    // Unique filename so the process-global juce::ImageCache can't collide with
-    // another case. getBytes re-decrypts each call, so the cache is what makes
+    // getBytes re-decrypts each call, so the loader's cache is what makes
     // repeated loads of the same frame cheap.
     const char* const name = "cachehit_unique.png";
     const int w = 6, h = 6;
@@ -193,14 +191,41 @@ TEST_CASE ("PackedAssetImageLoader memoizes decoded images in ImageCache")
 
     const auto first = loader.loadImageByFilename (name);
     REQUIRE (first.isValid());
-
-    // The decoded image is now in the cache, keyed on the ORIGINAL filename.
-    REQUIRE (juce::ImageCache::getFromHashCode (juce::String (name).hashCode64()).isValid());
+    REQUIRE (loader.getDecodedImageCache().getStatistics().misses == 1);
 
     const auto second = loader.loadImageByFilename (name);
     REQUIRE (second.isValid());
     REQUIRE (second.getWidth() == w);
     REQUIRE (second.getHeight() == h);
+    REQUIRE (loader.getDecodedImageCache().getStatistics().hits == 1);
+
+    // The cache is per loader now, not the process-global juce::ImageCache,
+    // so unrelated products can't collide on a shared filename key.
+    REQUIRE_FALSE (juce::ImageCache::getFromHashCode (juce::String (name).hashCode64()).isValid());
+}
+
+TEST_CASE ("PackedAssetImageLoader shares decoded pixels for identical bytes across loaders")
+{
+    // Same encoded bytes under different names in two independent paks (e.g.
+    // the same knob shipped by two plugins) must resolve to one decoded copy.
+    const auto png = encodePng (9, 3);
+    std::vector<pt::packedassets::InputEntry> entriesA { { "shared_a.png", png } };
+    std::vector<pt::packedassets::InputEntry> entriesB { { "shared_b.png", png } };
+
+    PackedAssetImageLoader loaderA (buildSource (entriesA));
+    PackedAssetImageLoader loaderB (buildSource (entriesB));
+
+    const auto a = loaderA.loadImageByFilename ("shared_a.png");
+    const auto b = loaderB.loadImageByFilename ("shared_b.png");
+
+    REQUIRE (a.isValid());
+    REQUIRE (b.isValid());
+    REQUIRE (a.getPixelData() == b.getPixelData());
+
+    // Different bytes must never be merged.
+    std::vector<pt::packedassets::InputEntry> entriesC { { "shared_a.png", encodePng (3, 9) } };
+    PackedAssetImageLoader loaderC (buildSource (entriesC));
+    REQUIRE (loaderC.loadImageByFilename ("shared_a.png").getPixelData() != a.getPixelData());
 }
 
 TEST_CASE ("PackedAssetImageLoader returns an invalid image for non-image bytes")
@@ -214,8 +239,51 @@ TEST_CASE ("PackedAssetImageLoader returns an invalid image for non-image bytes"
     // Bytes exist but aren't a decodable image -> invalid juce::Image,
     REQUIRE_FALSE (loader.loadImageByFilename (name).isValid());
     // and an undecodable blob must NOT be cached.
-    REQUIRE_FALSE (juce::ImageCache::getFromHashCode (juce::String (name).hashCode64()).isValid());
+    REQUIRE (loader.getDecodedImageCache().getStatistics().cachedImages == 0);
 
     // The same bytes are still retrievable verbatim as a string.
     REQUIRE (loader.getStringFromAsset (name) == juce::String ("not a png"));
 }
+
+TEST_CASE ("PackedAssetImageLoader loadImageBatch keeps order and reuses cached images")
+{
+    std::vector<pt::packedassets::InputEntry> entries;
+    std::vector<juce::String> names;
+
+    for (int i = 0; i < 24; ++i)
+    {
+        entries.push_back ({ ("batch_unique_" + juce::String (i) + ".png").toStdString(), encodePng (i + 1, 2) });
+        names.push_back ("batch_unique_" + juce::String (i) + ".png");
+    }
+
+    names.insert (names.begin() + 5, "batch_missing.png");
+
+    PackedAssetImageLoader loader (buildSource (entries));
+    const auto cached = loader.loadImageByFilename ("batch_unique_3.png");
+
+    const auto images = loader.loadImageBatch (names);
+    REQUIRE (images.size() == names.size());
+    REQUIRE_FALSE (images[5].isValid());
+    REQUIRE (images[3].getPixelData() == cached.getPixelData());
+
+    for (size_t i = 0; i < images.size(); ++i)
+        if (i != 5)
+            REQUIRE (images[i].getWidth() == names[i].fromFirstOccurrenceOf ("batch_unique_", false, false).getIntValue() + 1);
+
+    // Every image was decoded once, by the earlier single load or the batch; the missing name is a miss too
+    REQUIRE (loader.getDecodedImageCache().getStatistics().misses == 25);
+    REQUIRE (loader.getDecodedImageCache().getStatistics().hits == 1);
+}
+
+TEST_CASE ("PackedAssetImageLoader memoizes strings")
+{
+    std::vector<pt::packedassets::InputEntry> entries {
+        { "layout.xml", { '<', 'u', 'i', '/', '>' } }
+    };
+
+    PackedAssetImageLoader loader (buildSource (entries));
+
+    REQUIRE (loader.getStringFromAsset ("layout.xml") == "<ui/>");
+    REQUIRE (loader.getStringFromAsset ("layout.xml") == "<ui/>");
+    REQUIRE (loader.getStringFromAsset ("missing.xml").isEmpty());
+}
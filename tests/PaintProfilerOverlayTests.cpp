@@ -0,0 +1,105 @@
+#include "TestHelpers.h"
+
+#include <future>
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+namespace
+{
+    /** Reports its paints to the overlays, taking a given time per paint. */
+    class TimedComponent : public juce::Component
+    {
+    public:
+        TimedComponent (const juce::String& name, int paintMillisecondsToUse)
+            : juce::Component (name), paintMilliseconds (paintMillisecondsToUse)
+        {
+            setBounds (0, 0, 20, 20);
+        }
+
+        void paint (juce::Graphics&) override
+        {
+            BD_UI_PROFILE_PAINT ("TimedComponent::paint", *this);
+
+            if (paintMilliseconds > 0)
+                juce::Thread::sleep (paintMilliseconds);
+        }
+
+        void paintOnce() { createComponentSnapshot (getLocalBounds()); }
+
+    private:
+        const int paintMilliseconds;
+    };
+
+    /** Calls a function every few milliseconds. */
+    struct Poll : private juce::Timer
+    {
+        explicit Poll (std::function<void()> callbackToUse) : callback (std::move (callbackToUse)) { startTimer (5); }
+        ~Poll() override { stopTimer(); }
+
+        void timerCallback() override { callback(); }
+
+        std::function<void()> callback;
+    };
+}
+
+TEST_CASE ("Overlays on different editors collect the paints of their own components only")
+{
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::Component editorA, editorB;
+    editorA.setSize (100, 100);
+    editorB.setSize (100, 100);
+
+    TimedComponent slow ("slow", 20);
+    TimedComponent fast ("fast", 0);
+    editorA.addAndMakeVisible (slow);
+    editorB.addAndMakeVisible (fast);
+
+    PaintProfilerOverlay overlayA (editorA);
+    PaintProfilerOverlay overlayB (editorB);
+    overlayA.setFrameBudget (10.0);
+    overlayA.setRefreshInterval (50);
+    overlayB.setRefreshInterval (50);
+
+    slow.paintOnce();
+    slow.paintOnce();
+    fast.paintOnce();
+
+    // Statistics are taken by the overlays' timers; the next refresh would drop them again
+    std::vector<PaintProfilerOverlay::ComponentStatistics> statisticsA, statisticsB;
+    juce::WaitableEvent stopped;
+
+    const Poll poll ([&] {
+        if (statisticsA.empty())
+            statisticsA = overlayA.getStatistics();
+
+        if (statisticsB.empty())
+            statisticsB = overlayB.getStatistics();
+
+        if (! statisticsA.empty() && ! statisticsB.empty())
+        {
+            stopped.signal();
+            juce::MessageManager::getInstance()->stopDispatchLoop();
+        }
+    });
+
+    auto timeout = std::async (std::launch::async, [&stopped] {
+        if (! stopped.wait (5000))
+            juce::MessageManager::getInstance()->stopDispatchLoop();
+    });
+
+    juce::MessageManager::getInstance()->runDispatchLoop();
+    stopped.signal();
+
+    REQUIRE (statisticsA.size() == 1);
+    REQUIRE (statisticsA.front().component == &slow);
+    REQUIRE (statisticsA.front().numPaints == 2);
+    REQUIRE (statisticsA.front().maxMilliseconds >= 20.0);
+    REQUIRE (overlayA.isOverBudget (statisticsA.front()));
+
+    REQUIRE (statisticsB.size() == 1);
+    REQUIRE (statisticsB.front().component == &fast);
+    REQUIRE (statisticsB.front().numPaints == 1);
+    REQUIRE_FALSE (overlayB.isOverBudget (statisticsB.front()));
+}
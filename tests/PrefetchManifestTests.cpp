@@ -0,0 +1,179 @@
+#include "TestHelpers.h"
+
+#include <map>
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+namespace
+{
+    /** A BinaryData-style table over in-memory PNGs, with resource names mangled the way BinaryData mangles them. */
+    struct BinaryDataTable
+    {
+        struct Resource
+        {
+            std::string originalFilename;
+            juce::MemoryBlock data;
+        };
+
+        std::map<std::string, Resource> resources;
+        std::vector<const char*> namedResourceList;
+
+        static BinaryDataTable& get()
+        {
+            static BinaryDataTable table;
+            return table;
+        }
+
+        void fill (const juce::StringArray& filenames)
+        {
+            resources.clear();
+            namedResourceList.clear();
+
+            for (const auto& filename : filenames)
+                resources[filename.replaceCharacters (".-/ ", "____").toStdString()] = { filename.toStdString(), encodePng (makeImage (8, 8)) };
+
+            for (const auto& [resourceName, resource] : resources)
+                namedResourceList.push_back (resourceName.c_str());
+        }
+
+        std::unique_ptr<BinaryAssetImageLoader> createLoader() const
+        {
+            return std::make_unique<BinaryAssetImageLoader> (namedResourceList.data(), static_cast<int> (namedResourceList.size()),
+                                                             &getNamedResource, &getNamedResourceOriginalFilename);
+        }
+
+        static const char* getNamedResource (const char* resourceName, int& dataSize)
+        {
+            if (const auto it = get().resources.find (resourceName); it != get().resources.end())
+            {
+                dataSize = static_cast<int> (it->second.data.getSize());
+                return static_cast<const char*> (it->second.data.getData());
+            }
+
+            dataSize = 0;
+            return nullptr;
+        }
+
+        static const char* getNamedResourceOriginalFilename (const char* resourceName)
+        {
+            const auto it = get().resources.find (resourceName);
+            return it != get().resources.end() ? it->second.originalFilename.c_str() : nullptr;
+        }
+    };
+}
+
+TEST_CASE ("PrefetchManifest keeps the first access to every image and mask in order")
+{
+    PrefetchManifest::Recorder recorder;
+    recorder.recordAccess ("background.png", false);
+    recorder.recordAccess ("knob_0.png", false);
+    recorder.recordAccess ("background.png", false);
+    recorder.recordAccess ("knob_0.png", true);
+
+    const auto manifest = recorder.getManifest();
+    const std::vector<PrefetchManifest::Entry> expected { { "background.png", false }, { "knob_0.png", false }, { "knob_0.png", true } };
+    REQUIRE (manifest.getEntries() == expected);
+
+    // Round-trips through its text form
+    REQUIRE (PrefetchManifest::fromString (manifest.toString()).getEntries() == expected);
+
+    const auto requests = manifest.getRequests();
+    REQUIRE (requests.size() == 3);
+    REQUIRE (requests[0].kind == ImageRequest::Kind::file);
+    REQUIRE (requests[2].kind == ImageRequest::Kind::mask);
+}
+
+TEST_CASE ("A recorded manifest replays into the loader's cache")
+{
+    const TemporaryDirectory temporaryDirectory;
+    const auto& directory = temporaryDirectory.getFile();
+
+    for (const auto* name : { "background.png", "knob_mask.png", "prefetched.png" })
+        writePng (directory.getChildFile (name), makeImage (8, 8));
+
+    const auto manifestFile = directory.getChildFile ("prefetch.txt");
+
+    {
+        FileAssetImageLoader loader (directory);
+        PrefetchManifest::Recorder recorder;
+
+        {
+            const PrefetchManifest::Recorder::ScopedActivation activation (&recorder);
+            (void) loader.loadImageByFilename ("background.png");
+            (void) loader.loadMaskByFilename ("knob_mask.png");
+            (void) loader.loadImageByFilename ("missing.png");
+
+            // Prefetches run on the loader's pool, outside the recorded scope
+            loader.loadAsync ({ ImageRequest::file ("prefetched.png") })->wait();
+        }
+
+        (void) loader.loadImageByFilename ("prefetched.png");
+
+        REQUIRE (recorder.getManifest().saveTo (manifestFile));
+    }
+
+    // Missing files never reach the cache, so they aren't recorded either
+    const auto manifest = PrefetchManifest::loadFrom (manifestFile);
+    REQUIRE (manifest.getEntries().size() == 2);
+
+    FileAssetImageLoader loader (directory);
+    loader.loadAsync (manifest.getRequests())->wait();
+
+    const auto misses = loader.getDecodedImageCache().getStatistics().misses;
+    (void) loader.loadImageByFilename ("background.png");
+    (void) loader.loadMaskByFilename ("knob_mask.png");
+    REQUIRE (loader.getDecodedImageCache().getStatistics().misses == misses);
+
+    REQUIRE (PrefetchManifest::loadFrom (directory.getChildFile ("absent.txt")).isEmpty());
+}
+
+TEST_CASE ("Merged recorders keep their order and sort what each one recorded")
+{
+    PrefetchManifest::Recorder first, second, merged;
+    first.recordAccess ("knob_10.png", false);
+    first.recordAccess ("knob_2.png", false);
+    second.recordAccess ("background.png", true);
+    second.recordAccess ("knob_2.png", false);
+    second.recordAccess ("background.png", false);
+
+    merged.merge (first);
+    merged.merge (second);
+
+    const std::vector<PrefetchManifest::Entry> expected { { "knob_2.png", false },
+                                                          { "knob_10.png", false },
+                                                          { "background.png", false },
+                                                          { "background.png", true } };
+    REQUIRE (merged.getManifest().getEntries() == expected);
+}
+
+TEST_CASE ("A manifest recorded through BinaryData lists original filenames and replays")
+{
+    auto& table = BinaryDataTable::get();
+    table.fill ({ "background.png", "knob-mask.png" });
+
+    PrefetchManifest::Recorder recorder;
+
+    {
+        const auto loader = table.createLoader();
+        const PrefetchManifest::Recorder::ScopedActivation activation (&recorder);
+        REQUIRE (loader->loadImageByFilename ("background.png").isValid());
+        REQUIRE (loader->loadMaskByFilename ("knob-mask.png").isValid());
+    }
+
+    const auto manifest = PrefetchManifest::fromString (recorder.getManifest().toString());
+    const std::vector<PrefetchManifest::Entry> expected { { "background.png", false }, { "knob-mask.png", true } };
+    REQUIRE (manifest.getEntries() == expected);
+
+    const auto loader = table.createLoader();
+    const auto batch = loader->loadAsync (manifest.getRequests());
+    batch->wait();
+
+    for (int i = 0; i < batch->size(); ++i)
+        REQUIRE (batch->getFuture (i).get().size() == 1);
+
+    const auto misses = loader->getDecodedImageCache().getStatistics().misses;
+    (void) loader->loadImageByFilename ("background.png");
+    (void) loader->loadMaskByFilename ("knob-mask.png");
+    REQUIRE (loader->getDecodedImageCache().getStatistics().misses == misses);
+}
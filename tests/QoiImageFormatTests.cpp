@@ -0,0 +1,70 @@
+#include "TestHelpers.h"
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+namespace
+{
+    juce::Image makeTestImage (juce::Image::PixelFormat format, int width, int height)
+    {
+        juce::Image image (format, width, height, true);
+        juce::Random random (42);
+
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                // Runs, small differences and arbitrary colours, so every chunk type is used
+                const auto alpha = format == juce::Image::RGB ? 255 : (x < width / 2 ? 255 : (x * 37 + y) % 256);
+                const auto colour = y % 3 == 0 ? juce::Colour ((juce::uint8) 200, (juce::uint8) 10, (juce::uint8) 10, (juce::uint8) alpha)
+                                               : juce::Colour ((juce::uint8) (x + y), (juce::uint8) random.nextInt (256), (juce::uint8) (x * 2), (juce::uint8) alpha);
+                image.setPixelAt (x, y, colour);
+            }
+        }
+
+        return image;
+    }
+
+    // Premultiplied pixels may round differently after a trip through straight alpha
+    bool roundTripsMatch (const juce::Image& a, const juce::Image& b)
+    {
+        return a.getFormat() == b.getFormat() && imagesMatch (a, b, 1);
+    }
+}
+
+TEST_CASE ("QoiImageFormat round-trips ARGB and RGB images")
+{
+    for (const auto format : { juce::Image::ARGB, juce::Image::RGB })
+    {
+        const auto image = makeTestImage (format, 67, 23);
+        const auto encoded = QoiImageFormat::encode (image);
+
+        REQUIRE (QoiImageFormat::isQoi (encoded.getData(), encoded.getSize()));
+
+        const auto decoded = QoiImageFormat::decode (encoded.getData(), encoded.getSize());
+        REQUIRE (roundTripsMatch (image, decoded));
+    }
+}
+
+TEST_CASE ("QoiImageFormat rejects truncated and foreign data")
+{
+    const auto encoded = QoiImageFormat::encode (makeTestImage (juce::Image::ARGB, 8, 8));
+
+    REQUIRE_FALSE (QoiImageFormat::decode (encoded.getData(), 10).isValid());
+
+    const auto png = encodePng (makeTestImage (juce::Image::ARGB, 8, 8));
+    REQUIRE_FALSE (QoiImageFormat::isQoi (png.getData(), png.getSize()));
+}
+
+TEST_CASE ("Loaders decode QOI data stored under an image's original name")
+{
+    const TemporaryDirectory temporaryDirectory;
+    const auto& directory = temporaryDirectory.getFile();
+
+    const auto image = makeTestImage (juce::Image::ARGB, 12, 7);
+    const auto encoded = QoiImageFormat::encode (image);
+    REQUIRE (directory.getChildFile ("knob_0.png").replaceWithData (encoded.getData(), encoded.getSize()));
+
+    FileAssetImageLoader loader (directory);
+    REQUIRE (roundTripsMatch (image, loader.loadImageByFilename ("knob_0.png")));
+}
@@ -0,0 +1,173 @@
+#include "TestHelpers.h"
+
+#include <atomic>
+#include <tuple>
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+namespace
+{
+    juce::Colour drawAtWidth (ScaledImageSet& set, juce::Component& component, float width)
+    {
+        auto& props = component.getProperties();
+        props.set ("floatX", 0.0);
+        props.set ("floatY", 0.0);
+        props.set ("floatW", static_cast<double> (width));
+        props.set ("floatH", static_cast<double> (width));
+
+        juce::Image target (juce::Image::ARGB, 32, 32, true);
+        juce::Graphics g (target);
+        set.drawImage (g, 0, component);
+        return target.getPixelAt (static_cast<int> (width) / 2, static_cast<int> (width) / 2);
+    }
+}
+
+TEST_CASE ("Scale variants are parsed from file<scale>x and fileNameSuffix<scale>x attributes")
+{
+    const auto element = juce::parseXML (R"(<KNOB name="knob" fileNamePrefix="Knob_" fileNameSuffix=".png" fileNameSuffix2x="@2x.png"
+                                                   fileNameSuffix3x="@3x.png" fileNameSuffix1_5x="@1.5x.png" file1.5x="Knob@1.5x.png"/>)");
+    REQUIRE (element != nullptr);
+
+    const auto metadata = UILoader::parseElement (element.get());
+    const auto variants = metadata.getScaleVariants();
+
+    REQUIRE (variants.size() == 3);
+    REQUIRE (variants[0].scale == 1.5);
+    REQUIRE (variants[0].file == "Knob@1.5x.png");
+    REQUIRE (variants[0].fileNameSuffix == "@1.5x.png");
+    REQUIRE (variants[1].scale == 2.0);
+    REQUIRE (variants[1].fileNameSuffix == "@2x.png");
+    REQUIRE (variants[2].scale == 3.0);
+    REQUIRE (variants[2].fileNameSuffix == "@3x.png");
+}
+
+TEST_CASE ("ScaledImageSet draws the smallest scale covering the physical size")
+{
+    ScaledImageSet set (makeImage (8, 8, juce::Colours::red), makeImage (16, 16, juce::Colours::blue));
+    set.addScale (1.5, makeImage (12, 12, juce::Colours::green));
+    REQUIRE (set.getScales() == juce::Array<double> { 1.0, 1.5, 2.0 });
+
+    juce::Component component;
+    component.getProperties().set ("width", 8);
+
+    REQUIRE (drawAtWidth (set, component, 8.0f) == juce::Colours::red);
+    REQUIRE (drawAtWidth (set, component, 10.0f) == juce::Colours::green);
+    REQUIRE (drawAtWidth (set, component, 12.0f) == juce::Colours::green);
+    REQUIRE (drawAtWidth (set, component, 14.0f) == juce::Colours::blue);
+
+    // Beyond the largest scale, the largest is drawn
+    REQUIRE (drawAtWidth (set, component, 24.0f) == juce::Colours::blue);
+
+    MemoryReport::ComponentImages report;
+    set.getImagesForMemoryReport (report);
+    REQUIRE (report.images.size() == 1);
+    REQUIRE (report.scaledImages.size() == 2);
+    REQUIRE (report.scaledImages[0].scale == 1.5);
+    REQUIRE (report.scaledImages[0].images.size() == 1);
+    REQUIRE (report.scaledImages[0].drawn);
+    REQUIRE (report.scaledImages[1].scale == 2.0);
+    REQUIRE (report.scaledImages[1].drawn);
+}
+
+TEST_CASE ("ScaledImageSet releases the scales it didn't draw and loads them again when selected")
+{
+    std::atomic<int> loads { 0 };
+    int releases = 0;
+
+    ScaledImageSet set (makeImage (8, 8, juce::Colours::red), makeImage (16, 16, juce::Colours::blue));
+    set.addScale (1.5, makeImage (12, 12, juce::Colours::green));
+
+    for (const auto& [scale, size, colour] : { std::tuple (1.5, 12, juce::Colours::green), std::tuple (2.0, 16, juce::Colours::blue) })
+    {
+        set.setLevelSource (scale, { [&loads, size = size, colour = colour] {
+                                        ++loads;
+                                        return ScaledImageSet::LevelImages { { makeImage (size, size, colour) }, nullptr };
+                                    },
+                                     [&releases] { ++releases; } });
+    }
+
+    juce::Component component;
+    component.getProperties().set ("width", 8);
+
+    REQUIRE (drawAtWidth (set, component, 12.0f) == juce::Colours::green);
+    REQUIRE (releases == 1);
+
+    MemoryReport::ComponentImages report;
+    set.getImagesForMemoryReport (report);
+    REQUIRE (report.scaledImages.size() == 1);
+    REQUIRE (report.scaledImages[0].scale == 1.5);
+
+    // Until the 2x images are there again, the closest scale held is drawn
+    REQUIRE (drawAtWidth (set, component, 16.0f) == juce::Colours::green);
+
+    for (int attempt = 0; attempt < 500 && drawAtWidth (set, component, 16.0f) != juce::Colours::blue; ++attempt)
+        juce::Thread::sleep (10);
+
+    REQUIRE (drawAtWidth (set, component, 16.0f) == juce::Colours::blue);
+    REQUIRE (loads == 1);
+    REQUIRE (set.getScales() == juce::Array<double> { 1.0, 1.5, 2.0 });
+
+    // The scale drawn while the 2x images loaded is released once they are there
+    REQUIRE (releases == 2);
+    report = {};
+    set.getImagesForMemoryReport (report);
+    REQUIRE (report.scaledImages.size() == 1);
+    REQUIRE (report.scaledImages[0].scale == 2.0);
+
+    REQUIRE (drawAtWidth (set, component, 16.0f) == juce::Colours::blue);
+    REQUIRE (releases == 2);
+}
+
+TEST_CASE ("ScaledImageSet drops a released scale that can't be loaded again")
+{
+    ScaledImageSet set (makeImage (8, 8, juce::Colours::red), makeImage (16, 16, juce::Colours::blue));
+    set.setLevelSource (2.0, { [] { return ScaledImageSet::LevelImages(); }, {} });
+
+    juce::Component component;
+    component.getProperties().set ("width", 8);
+
+    REQUIRE (drawAtWidth (set, component, 8.0f) == juce::Colours::red);
+    REQUIRE (drawAtWidth (set, component, 16.0f) == juce::Colours::red);
+
+    for (int attempt = 0; attempt < 500 && set.getScales().size() > 1; ++attempt)
+    {
+        juce::Thread::sleep (10);
+        (void) drawAtWidth (set, component, 16.0f);
+    }
+
+    REQUIRE (set.getScales() == juce::Array<double> { 1.0 });
+    REQUIRE (drawAtWidth (set, component, 16.0f) == juce::Colours::red);
+}
+
+TEST_CASE ("ScaledImageSet resamples a frame once per size and blits it afterwards")
+{
+    ScaledImageSet set (makeImage (8, 8, juce::Colours::red), makeImage (16, 16, juce::Colours::blue));
+
+    juce::Component component;
+    component.getProperties().set ("width", 8);
+
+    const auto getResampledFrames = [&set] {
+        MemoryReport::ComponentImages report;
+        set.getImagesForMemoryReport (report);
+        return report.caches;
+    };
+
+    // Drawn at its own size, the frame is blitted as it is
+    REQUIRE (drawAtWidth (set, component, 8.0f) == juce::Colours::red);
+    REQUIRE (getResampledFrames().isEmpty());
+
+    REQUIRE (drawAtWidth (set, component, 12.0f) == juce::Colours::blue);
+    const auto resampled = getResampledFrames();
+    REQUIRE (resampled.size() == 1);
+    REQUIRE (resampled.getFirst().getBounds() == juce::Rectangle<int> (0, 0, 12, 12));
+
+    REQUIRE (drawAtWidth (set, component, 12.0f) == juce::Colours::blue);
+    REQUIRE (getResampledFrames().size() == 1);
+    REQUIRE (getResampledFrames().getFirst().getPixelData() == resampled.getFirst().getPixelData());
+
+    // Another size replaces it
+    REQUIRE (drawAtWidth (set, component, 10.0f) == juce::Colours::blue);
+    REQUIRE (getResampledFrames().size() == 1);
+    REQUIRE (getResampledFrames().getFirst().getBounds() == juce::Rectangle<int> (0, 0, 10, 10));
+}
@@ -0,0 +1,93 @@
+#include "TestHelpers.h"
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+namespace
+{
+    // Stands in for encoded bytes: the pool only hashes them
+    juce::MemoryBlock makeBytes (const char* text)
+    {
+        return { text, std::strlen (text) };
+    }
+}
+
+TEST_CASE ("SharedImagePool shares images with identical pixels decoded from different bytes")
+{
+    SharedImagePool pool;
+    const auto off = makeBytes ("off.png");
+    const auto offAgain = makeBytes ("off-reexported.png");
+    const auto on = makeBytes ("on.png");
+
+    const auto first = pool.getOrDecode (off.getData(), off.getSize(), [] { return makeImage (16, 8, juce::Colours::black); });
+    const auto duplicate = pool.getOrDecode (offAgain.getData(), offAgain.getSize(), [] { return makeImage (16, 8, juce::Colours::black); });
+    const auto different = pool.getOrDecode (on.getData(), on.getSize(), [] { return makeImage (16, 8, juce::Colours::red); });
+
+    REQUIRE (first.getPixelData() == duplicate.getPixelData());
+    REQUIRE (first.getPixelData() != different.getPixelData());
+    REQUIRE (pool.getNumPixelDuplicates() == 1);
+    REQUIRE (pool.getNumImages() == 3);
+}
+
+TEST_CASE ("SharedImagePool releases pixel duplicates once nothing else holds them")
+{
+    SharedImagePool pool;
+    const auto a = makeBytes ("a");
+    const auto b = makeBytes ("b");
+
+    {
+        const auto first = pool.getOrDecode (a.getData(), a.getSize(), [] { return makeImage (16, 8, juce::Colours::blue); });
+        const auto second = pool.getOrDecode (b.getData(), b.getSize(), [] { return makeImage (16, 8, juce::Colours::blue); });
+
+        pool.releaseUnusedImages();
+        REQUIRE (pool.getNumImages() == 2);
+    }
+
+    pool.releaseUnusedImages();
+    REQUIRE (pool.getNumImages() == 0);
+}
+
+TEST_CASE ("Image sequences share repeated frames")
+{
+    const TemporaryDirectory temporaryDirectory;
+    const auto& directory = temporaryDirectory.getFile();
+
+    // The same opaque pixels as PNG and as QOI, plus a different frame
+    const auto off = makeImage (16, 8, juce::Colours::darkgrey);
+    const auto qoi = QoiImageFormat::encode (off);
+
+    writePng (directory.getChildFile ("led_0.png"), off);
+    REQUIRE (directory.getChildFile ("led_1.png").replaceWithData (qoi.getData(), qoi.getSize()));
+    writePng (directory.getChildFile ("led_2.png"), off);
+    writePng (directory.getChildFile ("led_3.png"), makeImage (16, 8, juce::Colours::orange));
+
+    FileAssetImageLoader loader (directory);
+    const auto frames = loader.loadImageSequence ("led_", 4, ".png");
+
+    REQUIRE (frames.size() == 4);
+    REQUIRE (frames[0]->getPixelData() == frames[1]->getPixelData());
+    REQUIRE (frames[0]->getPixelData() == frames[2]->getPixelData());
+    REQUIRE (frames[0]->getPixelData() != frames[3]->getPixelData());
+}
+
+TEST_CASE ("SharedImagePool shares images by the content of the encoded bytes")
+{
+    SharedImagePool pool;
+    const auto bytes = makeBytes ("knob.png");
+    const auto sameBytes = makeBytes ("knob.png");
+    const auto otherBytes = makeBytes ("knob.pnh");
+    int numDecodes = 0;
+
+    const auto decode = [&numDecodes] {
+        ++numDecodes;
+        return makeImage (16, 8, juce::Colour (static_cast<juce::uint32> (0xff000000 + numDecodes)));
+    };
+
+    const auto first = pool.getOrDecode (bytes.getData(), bytes.getSize(), decode);
+    const auto second = pool.getOrDecode (sameBytes.getData(), sameBytes.getSize(), decode);
+    const auto third = pool.getOrDecode (otherBytes.getData(), otherBytes.getSize(), decode);
+
+    REQUIRE (numDecodes == 2);
+    REQUIRE (first.getPixelData() == second.getPixelData());
+    REQUIRE (first.getPixelData() != third.getPixelData());
+}
@@ -0,0 +1,116 @@
+#include "TestHelpers.h"
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+namespace
+{
+    // label is drawn over the live dial, so baking it behind the dial would change the picture
+    constexpr auto xml = R"(<UI width="200" height="100">
+                                <IMAGE name="background" file="background.png" x="0" y="0" width="200" height="100" imageType="raster"/>
+                                <IMAGE name="badge" file="badge.png" x="150" y="60" width="20" height="20" imageType="raster"/>
+                                <IMAGE name="button" file="badge.png" x="120" y="60" width="20" height="20" hitboxMask="badge.png" imageType="raster"/>
+                                <TWEENABLE name="handle" file="badge.png" minX="10" minY="60" maxX="50" maxY="60" width="20" height="20"/>
+                                <KNOB name="dial" fileNamePrefix="dial_" fileNameSuffix=".png" numberOfFrames="2" x="60" y="10" width="20" height="20" imageType="raster"/>
+                                <IMAGE name="label" file="badge.png" x="70" y="20" width="20" height="20" imageType="raster"/>
+                            </UI>)";
+
+    struct StaticLayerFixture
+    {
+        StaticLayerFixture()
+        {
+            writePng (directory.getChildFile ("background.png"), makeImage (20, 10, juce::Colours::blue));
+
+            for (const auto* name : { "badge.png", "dial_0.png", "dial_1.png" })
+                writePng (directory.getChildFile (name), makeImage (16, 16, juce::Colours::red));
+
+            REQUIRE (directory.getChildFile ("metadata.xml").replaceWithText (xml));
+
+            parent.setSize (200, 100);
+            uiLoader.setStaticLayerEnabled (true);
+            uiLoader.loadUI ("metadata.xml");
+        }
+
+        StaticLayerComponent* getStaticLayer() const
+        {
+            for (auto* child : parent.getChildren())
+                if (auto* staticLayer = dynamic_cast<StaticLayerComponent*> (child))
+                    return staticLayer;
+
+            return nullptr;
+        }
+
+        juce::Image getCachedLayer() const
+        {
+            MemoryReport::ComponentImages images;
+            getStaticLayer()->getImagesForMemoryReport (images);
+            return images.caches.getFirst();
+        }
+
+        bool isFlattened (const juce::String& name) const
+        {
+            auto* component = uiLoader.getComponentByName (name);
+            REQUIRE (component != nullptr);
+            return static_cast<bool> (component->getProperties()["flattened"]) && ! component->isVisible();
+        }
+
+        const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+        const TemporaryDirectory temporaryDirectory;
+        const juce::File directory = temporaryDirectory.getFile();
+        juce::Component parent;
+        UILoader uiLoader { parent, directory };
+    };
+}
+
+TEST_CASE ("Static images are flattened, while interactive, animated and overlapping ones stay live")
+{
+    StaticLayerFixture ui;
+
+    auto* staticLayer = ui.getStaticLayer();
+    REQUIRE (staticLayer != nullptr);
+    REQUIRE (ui.parent.getIndexOfChildComponent (staticLayer) == 0);
+    REQUIRE (staticLayer->getBounds() == ui.parent.getLocalBounds());
+
+    REQUIRE (ui.isFlattened ("background"));
+    REQUIRE (ui.isFlattened ("badge"));
+    REQUIRE (staticLayer->getLayerComponents() == juce::Array<juce::Component*> { ui.uiLoader.getComponentByName ("background"), ui.uiLoader.getComponentByName ("badge") });
+
+    for (const auto* name : { "button", "handle", "dial", "label" })
+    {
+        INFO (name);
+        REQUIRE_FALSE (ui.isFlattened (name));
+        REQUIRE (ui.uiLoader.getComponentByName (name)->isVisible());
+    }
+
+    // Disabling it shows the flattened components again
+    ui.uiLoader.setStaticLayerEnabled (false);
+    ui.uiLoader.reloadUI();
+    REQUIRE_FALSE (ui.isFlattened ("background"));
+    REQUIRE (ui.uiLoader.getComponentByName ("background")->isVisible());
+    REQUIRE (ui.getStaticLayer() == nullptr);
+}
+
+TEST_CASE ("The static layer is composited once per size")
+{
+    StaticLayerFixture ui;
+    REQUIRE_FALSE (ui.getCachedLayer().isValid());
+
+    auto snapshot = ui.parent.createComponentSnapshot (ui.parent.getLocalBounds());
+    const auto cachedLayer = ui.getCachedLayer();
+    REQUIRE (cachedLayer.getBounds() == juce::Rectangle<int> (0, 0, 200, 100));
+    REQUIRE (snapshot.getPixelAt (5, 5) == juce::Colours::blue);
+    REQUIRE (snapshot.getPixelAt (160, 70) == juce::Colours::red);
+
+    // Painting again blits the same bitmap
+    snapshot = ui.parent.createComponentSnapshot (ui.parent.getLocalBounds());
+    REQUIRE (ui.getCachedLayer().getPixelData() == cachedLayer.getPixelData());
+
+    ui.parent.setSize (400, 200);
+    ui.uiLoader.applyLayout();
+    REQUIRE_FALSE (ui.getCachedLayer().isValid());
+
+    snapshot = ui.parent.createComponentSnapshot (ui.parent.getLocalBounds());
+    REQUIRE (ui.getCachedLayer().getBounds() == juce::Rectangle<int> (0, 0, 400, 200));
+    REQUIRE (snapshot.getPixelAt (10, 10) == juce::Colours::blue);
+    REQUIRE (snapshot.getPixelAt (320, 140) == juce::Colours::red);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <bd_ui_loader/bd_ui_loader.h>
+
+#include <cstdlib>
+
+namespace BogrenDigital::UILoading::TestHelpers
+{
+    /** An empty directory that is deleted with everything in it when this goes out of scope, even when a REQUIRE fails. */
+    class TemporaryDirectory
+    {
+    public:
+        TemporaryDirectory() { REQUIRE (directory.createDirectory()); }
+        ~TemporaryDirectory() { directory.deleteRecursively(); }
+
+        const juce::File& getFile() const { return directory; }
+        juce::File getChildFile (const juce::String& relativePath) const { return directory.getChildFile (relativePath); }
+
+    private:
+        const juce::TemporaryFile temporaryFile;
+        const juce::File directory = temporaryFile.getFile();
+
+        JUCE_DECLARE_NON_COPYABLE (TemporaryDirectory)
+    };
+
+    inline juce::MemoryBlock encodePng (const juce::Image& image)
+    {
+        juce::MemoryOutputStream png;
+        juce::PNGImageFormat().writeImageToStream (image, png);
+        return png.getMemoryBlock();
+    }
+
+    inline void writePng (const juce::File& file, const juce::Image& image)
+    {
+        const auto png = encodePng (image);
+        REQUIRE (file.replaceWithData (png.getData(), png.getSize()));
+    }
+
+    /** A width x height ARGB image filled with one colour; transparent by default. */
+    inline juce::Image makeImage (int width, int height, juce::Colour colour = juce::Colours::transparentBlack)
+    {
+        juce::Image image (juce::Image::ARGB, width, height, true);
+        image.clear (image.getBounds(), colour);
+        return image;
+    }
+
+    /**
+     * True if both images have the same size and their pixels differ by at most colourTolerance per colour channel.
+     * Alpha always has to match exactly. The pixel formats aren't compared.
+     */
+    inline bool imagesMatch (const juce::Image& a, const juce::Image& b, int colourTolerance = 0)
+    {
+        if (a.getBounds() != b.getBounds())
+            return false;
+
+        for (int y = 0; y < a.getHeight(); ++y)
+        {
+            for (int x = 0; x < a.getWidth(); ++x)
+            {
+                const auto pixelA = a.getPixelAt (x, y).getPixelARGB();
+                const auto pixelB = b.getPixelAt (x, y).getPixelARGB();
+
+                if (pixelA.getAlpha() != pixelB.getAlpha() || std::abs (pixelA.getRed() - pixelB.getRed()) > colourTolerance
+                    || std::abs (pixelA.getGreen() - pixelB.getGreen()) > colourTolerance || std::abs (pixelA.getBlue() - pixelB.getBlue()) > colourTolerance)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,70 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <bd_ui_loader/bd_ui_loader.h>
+
+using namespace BogrenDigital::UILoading;
+
+namespace
+{
+    juce::Array<juce::var> getCompleteEvents (const juce::String& json)
+    {
+        juce::Array<juce::var> completeEvents;
+
+        if (const auto* traceEvents = juce::JSON::parse (json)["traceEvents"].getArray())
+        {
+            for (const auto& event : *traceEvents)
+            {
+                if (event["ph"] == juce::var ("X"))
+                    completeEvents.add (event);
+            }
+        }
+
+        return completeEvents;
+    }
+}
+
+TEST_CASE ("TraceRecorder exports scopes as Chrome trace events only while enabled")
+{
+    TraceRecorder::setEnabled (true, 8);
+    TraceRecorder::clear();
+
+    {
+        BD_UI_TRACE_SCOPE_DETAILED ("outer", "metadata.xml");
+        BD_UI_TRACE_SCOPE ("inner");
+    }
+
+    TraceRecorder::setEnabled (false);
+
+    {
+        BD_UI_TRACE_SCOPE ("ignored");
+    }
+
+    const auto events = getCompleteEvents (TraceRecorder::getChromeTraceJson());
+
+    REQUIRE (events.size() == 2);
+    REQUIRE (events[0]["name"] == juce::var ("inner"));
+    REQUIRE (events[1]["name"] == juce::var ("outer"));
+    REQUIRE (events[1]["args"]["detail"] == juce::var ("metadata.xml"));
+    REQUIRE ((double) events[1]["dur"] >= (double) events[0]["dur"]);
+}
+
+TEST_CASE ("TraceRecorder keeps the newest events once its ring buffer wraps")
+{
+    // Another size than the previous test case's starts a new buffer
+    TraceRecorder::setEnabled (true, 4);
+    TraceRecorder::clear();
+
+    for (int i = 0; i < 10; ++i)
+        BD_UI_TRACE_SCOPE_DETAILED ("event", i);
+
+    TraceRecorder::setEnabled (false);
+
+    const auto events = getCompleteEvents (TraceRecorder::getChromeTraceJson());
+
+    REQUIRE (events.size() == 4);
+
+    for (int i = 0; i < 4; ++i)
+        REQUIRE (events[i]["args"]["detail"] == juce::var (juce::String (6 + i)));
+
+    TraceRecorder::clear();
+}
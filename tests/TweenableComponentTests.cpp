@@ -0,0 +1,74 @@
+#include "TestHelpers.h"
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+namespace
+{
+    struct TweenableFixture
+    {
+        TweenableFixture()
+        {
+            writePng (directory.getChildFile ("handle.png"), makeImage (16, 8, juce::Colours::red));
+            REQUIRE (directory.getChildFile ("metadata.xml").replaceWithText (R"(<UI width="200" height="100">
+                                                                                     <TWEENABLE name="handle" file="handle.png" minX="10" minY="20" maxX="110" maxY="40" width="20" height="10"/>
+                                                                                 </UI>)"));
+
+            parent.setSize (200, 100);
+            uiLoader.loadUI ("metadata.xml");
+
+            handle = dynamic_cast<TweenableComponent*> (uiLoader.getComponentByName ("handle"));
+            REQUIRE (handle != nullptr);
+        }
+
+        const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+        const TemporaryDirectory temporaryDirectory;
+        const juce::File directory = temporaryDirectory.getFile();
+        juce::Component parent;
+        UILoader uiLoader { parent, directory };
+        TweenableComponent* handle = nullptr;
+    };
+}
+
+TEST_CASE ("Moving a tweenable changes only its transform")
+{
+    TweenableFixture ui;
+    REQUIRE (ui.handle->getBounds() == juce::Rectangle<int> (10, 20, 20, 10));
+    REQUIRE (ui.handle->getTransform().isIdentity());
+
+    int numPositionUpdates = 0;
+    ui.handle->onNewPositionNeeded = [&numPositionUpdates, previous = ui.handle->onNewPositionNeeded] (float value) {
+        ++numPositionUpdates;
+        previous (value);
+    };
+
+    ui.handle->setNormalizedValue (0.5f);
+    REQUIRE (ui.handle->getBounds() == juce::Rectangle<int> (10, 20, 20, 10));
+    REQUIRE (ui.handle->getTransform() == juce::AffineTransform::translation (50.0f, 10.0f));
+    REQUIRE (ui.parent.getLocalArea (ui.handle, ui.handle->getLocalBounds()) == juce::Rectangle<int> (60, 30, 20, 10));
+
+    // Values are clamped, and setting the current one again does nothing
+    ui.handle->setNormalizedValue (2.0f);
+    REQUIRE (ui.handle->getNormalizedValue() == 1.0f);
+    REQUIRE (ui.handle->getTransform() == juce::AffineTransform::translation (100.0f, 20.0f));
+
+    ui.handle->setNormalizedValue (1.0f);
+    REQUIRE (numPositionUpdates == 2);
+}
+
+TEST_CASE ("A tweenable keeps its position when the layout is rescaled")
+{
+    TweenableFixture ui;
+    ui.handle->setNormalizedValue (0.5f);
+
+    ui.parent.setSize (400, 200);
+    ui.uiLoader.applyLayout();
+
+    // Laid out at its min position at 2x, with the offset recomputed at the new scale
+    REQUIRE (ui.handle->getBounds() == juce::Rectangle<int> (20, 40, 40, 20));
+    REQUIRE (ui.handle->getTransform() == juce::AffineTransform::translation (100.0f, 20.0f));
+    REQUIRE (ui.handle->getNormalizedValue() == 0.5f);
+
+    ui.handle->setNormalizedValue (0.0f);
+    REQUIRE (ui.handle->getTransform().isIdentity());
+}
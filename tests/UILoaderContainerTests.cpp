@@ -0,0 +1,172 @@
+#include "TestHelpers.h"
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+namespace
+{
+    juce::String makeImageElement (const juce::String& name, const juce::String& bounds)
+    {
+        return "<IMAGE name=\"" + name + "\" file=\"image.png\" " + bounds + " imageType=\"raster\"/>";
+    }
+
+    // panel holds child and the nested container inner, which holds deep
+    juce::String makeXml (const juce::String& childParent = "panel")
+    {
+        const auto child = makeImageElement ("child", R"(x="10" y="5" width="20" height="10")");
+
+        return R"(<UI width="200" height="100">)"
+               + makeImageElement ("sibling", R"(x="0" y="0" width="20" height="20")")
+               + R"(<CONTAINER name="panel" x="50" y="25" width="100" height="50">)"
+               + (childParent == "panel" ? child : juce::String())
+               + R"(<CONTAINER name="inner" x="40" y="20" width="40" height="20">)"
+               + makeImageElement ("deep", R"(x="5" y="5" width="10" height="10")")
+               + R"(</CONTAINER></CONTAINER><CONTAINER name="other" x="0" y="80" width="100" height="20">)"
+               + (childParent == "other" ? child : juce::String())
+               + "</CONTAINER></UI>";
+    }
+
+    struct ContainerFixture
+    {
+        explicit ContainerFixture (const juce::String& xml = makeXml())
+        {
+            writePng (directory.getChildFile ("image.png"), makeImage (16, 16, juce::Colours::red));
+            writeXml (xml);
+            uiLoader.loadUI ("metadata.xml");
+        }
+
+        void writeXml (const juce::String& xml)
+        {
+            REQUIRE (directory.getChildFile ("metadata.xml").replaceWithText (xml));
+        }
+
+        /** Where a component's images are drawn, in the coordinate space of the UI's parent. */
+        juce::Rectangle<float> getDrawnBounds (const juce::String& name) const
+        {
+            auto* component = uiLoader.getComponentByName (name);
+            REQUIRE (component != nullptr);
+
+            const auto area = ScaledImageSet::getFloatRect (*component);
+            return area.withPosition (parent.getLocalPoint (component, area.getPosition()));
+        }
+
+        juce::Component* operator[] (const juce::String& name) const { return uiLoader.getComponentByName (name); }
+
+        const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+        const TemporaryDirectory temporaryDirectory;
+        const juce::File directory = temporaryDirectory.getFile();
+        juce::Component parent;
+        UILoader uiLoader { parent, directory };
+    };
+}
+
+TEST_CASE ("Container contents are placed in their container's scaled coordinate space")
+{
+    ContainerFixture ui;
+    REQUIRE (ui["child"]->getParentComponent() == ui["panel"]);
+    REQUIRE (ui["deep"]->getParentComponent() == ui["inner"]);
+    REQUIRE (ui["inner"]->getParentComponent() == ui["panel"]);
+    REQUIRE (ui["deep"]->getBounds() == juce::Rectangle<int> (5, 5, 10, 10));
+
+    // At 1.5x, the panel lands half a pixel down, which its contents inherit through their own fractions
+    ui.parent.setSize (300, 150);
+    ui.uiLoader.applyLayout();
+
+    REQUIRE (ui["panel"]->getBounds() == juce::Rectangle<int> (75, 37, 150, 76));
+    REQUIRE (ui["panel"]->getProperties()["floatY"].operator double() == 0.5);
+    REQUIRE (ui["inner"]->getBounds() == juce::Rectangle<int> (60, 30, 60, 31));
+    REQUIRE (ui["deep"]->getBounds() == juce::Rectangle<int> (7, 8, 15, 15));
+    REQUIRE (ui["deep"]->getProperties()["floatX"].operator double() == 0.5);
+
+    REQUIRE (ui.getDrawnBounds ("panel") == juce::Rectangle<float> (75.0f, 37.5f, 150.0f, 75.0f));
+    REQUIRE (ui.getDrawnBounds ("child") == juce::Rectangle<float> (90.0f, 45.0f, 30.0f, 15.0f));
+    REQUIRE (ui.getDrawnBounds ("inner") == juce::Rectangle<float> (135.0f, 67.5f, 60.0f, 30.0f));
+    REQUIRE (ui.getDrawnBounds ("deep") == juce::Rectangle<float> (142.5f, 75.0f, 15.0f, 15.0f));
+}
+
+TEST_CASE ("A tweenable inside a container travels in the container's coordinate space")
+{
+    ContainerFixture ui (R"(<UI width="200" height="100">
+                                <CONTAINER name="panel" x="50" y="25" width="100" height="50">
+                                    <CONTAINER name="inner" x="10" y="10" width="80" height="30">
+                                        <TWEENABLE name="slider" file="image.png" minX="10" minY="5" maxX="50" maxY="15" width="20" height="10"/>
+                                    </CONTAINER>
+                                </CONTAINER>
+                            </UI>)");
+
+    ui.parent.setSize (300, 150);
+    ui.uiLoader.applyLayout();
+
+    auto* slider = dynamic_cast<TweenableComponent*> (ui["slider"]);
+    REQUIRE (slider != nullptr);
+    REQUIRE (slider->getParentComponent() == ui["inner"]);
+
+    const auto bounds = slider->getBounds();
+    REQUIRE (ui.getDrawnBounds ("slider") == juce::Rectangle<float> (105.0f, 60.0f, 30.0f, 15.0f));
+
+    // 40 by 10 metadata units at 1.5x, without moving the laid out bounds
+    slider->setNormalizedValue (1.0f);
+    REQUIRE (slider->getTransform() == juce::AffineTransform::translation (60.0f, 15.0f));
+    REQUIRE (slider->getBounds() == bounds);
+
+    slider->setNormalizedValue (0.5f);
+    REQUIRE (slider->getTransform() == juce::AffineTransform::translation (30.0f, 7.5f));
+}
+
+TEST_CASE ("A reused component follows its element into another container")
+{
+    ContainerFixture ui;
+    auto* child = ui["child"];
+    auto* deep = ui["deep"];
+
+    // Hiding is up to the application, even for the contents of a container
+    deep->setVisible (false);
+
+    ui.writeXml (makeXml ("other"));
+    ui.uiLoader.reloadUI();
+
+    REQUIRE (ui["child"] == child);
+    REQUIRE (child->getParentComponent() == ui["other"]);
+    REQUIRE (child->isVisible());
+    REQUIRE (ui["panel"]->getIndexOfChildComponent (child) < 0);
+    REQUIRE (ui.getDrawnBounds ("child") == juce::Rectangle<float> (10.0f, 85.0f, 20.0f, 10.0f));
+
+    REQUIRE (ui["deep"] == deep);
+    REQUIRE_FALSE (deep->isVisible());
+}
+
+TEST_CASE ("The contents of a skipped container are skipped too")
+{
+    // The container shares its name with the image before it, so it is skipped
+    ContainerFixture ui (R"(<UI width="200" height="100">)"
+                         + makeImageElement ("panel", R"(x="0" y="0" width="20" height="20")")
+                         + R"(<CONTAINER name="panel" x="50" y="25" width="100" height="50">)"
+                         + makeImageElement ("orphan", R"(x="10" y="5" width="20" height="10")")
+                         + "</CONTAINER></UI>");
+
+    REQUIRE (dynamic_cast<ImageComponent*> (ui["panel"]) != nullptr);
+    REQUIRE (ui["orphan"] == nullptr);
+    REQUIRE (ui.uiLoader.getComponentsByName().size() == 1);
+}
+
+TEST_CASE ("Moving a container lays out only its subtree")
+{
+    ContainerFixture ui;
+    ui.parent.setSize (300, 150);
+    ui.uiLoader.applyLayout();
+
+    // Bounds no layout would produce show which components were laid out again
+    const juce::Rectangle<int> marker (1, 2, 3, 4);
+    ui["sibling"]->setBounds (marker);
+    ui["other"]->setBounds (marker);
+    ui["deep"]->setBounds (marker);
+
+    ui.uiLoader.setSourceBounds ("panel", { 60, 30, 100, 50 });
+
+    REQUIRE (ui["sibling"]->getBounds() == marker);
+    REQUIRE (ui["other"]->getBounds() == marker);
+
+    REQUIRE (ui.getDrawnBounds ("panel") == juce::Rectangle<float> (90.0f, 45.0f, 150.0f, 75.0f));
+    REQUIRE (ui.getDrawnBounds ("child") == juce::Rectangle<float> (105.0f, 52.5f, 30.0f, 15.0f));
+    REQUIRE (ui.getDrawnBounds ("deep") == juce::Rectangle<float> (157.5f, 82.5f, 15.0f, 15.0f));
+}
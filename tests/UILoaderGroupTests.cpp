@@ -0,0 +1,260 @@
+#include "TestHelpers.h"
+
+#include <atomic>
+#include <future>
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+namespace
+{
+    struct PreparationProbe
+    {
+        std::atomic<bool> blockPreparation { false };
+        std::atomic<int> prepared { 0 };
+        std::atomic<int> instantiated { 0 };
+        juce::WaitableEvent preparationStarted, resumePreparation, preparationFinished;
+    };
+
+    /** Builds plain components, reporting to a probe and optionally holding preparation until it is resumed. */
+    class ProbeFactory : public ComponentFactory
+    {
+    public:
+        ProbeFactory (ImageLoader& imageLoader, PreparationProbe* probeToUse)
+            : ComponentFactory (imageLoader), probe (*probeToUse)
+        {
+        }
+
+        std::unique_ptr<const ComponentBlueprint> prepare (const UILoader::ComponentMetadata& metadata) const override
+        {
+            probe.preparationStarted.signal();
+
+            if (probe.blockPreparation)
+                probe.resumePreparation.wait (5000);
+
+            auto blueprint = std::make_unique<ComponentBlueprint>();
+            blueprint->metadata = metadata;
+
+            ++probe.prepared;
+            probe.preparationFinished.signal();
+            return blueprint;
+        }
+
+        juce::Component* instantiate (const ComponentBlueprint&) override
+        {
+            ++probe.instantiated;
+            return new juce::Component();
+        }
+
+    private:
+        PreparationProbe& probe;
+    };
+
+    struct GroupFixture
+    {
+        GroupFixture()
+        {
+            writeXml (10);
+
+            uiLoader->getComponentFactoryRegistry().registerFactory<ProbeFactory> ("PROBE", "", &probe);
+            uiLoader->loadUI ("metadata.xml");
+        }
+
+        void writeXml (int probeX)
+        {
+            REQUIRE (directory.getChildFile ("metadata.xml").replaceWithText (R"(<UI width="200" height="100">
+                                                                                      <GROUP name="settings">
+                                                                                          <PROBE name="settings_probe" x=")"
+                                                                              + juce::String (probeX) + R"(" y="20" width="10" height="10"/>
+                                                                                      </GROUP>
+                                                                                  </UI>)"));
+        }
+
+        /**
+         * Runs the message loop, which finishes group builds, until stop() is called.
+         * JUCE only runs it once per MessageManager, so a test chains any further steps from callbacks.
+         */
+        void runMessageLoop()
+        {
+            auto timeout = std::async (std::launch::async, [this] {
+                if (! stopped.wait (5000))
+                    juce::MessageManager::getInstance()->stopDispatchLoop();
+            });
+
+            juce::MessageManager::getInstance()->runDispatchLoop();
+            stopped.signal();
+        }
+
+        void stop()
+        {
+            stopped.signal();
+            juce::MessageManager::getInstance()->stopDispatchLoop();
+        }
+
+        juce::Component* operator[] (const juce::String& name) const { return uiLoader->getComponentByName (name); }
+
+        const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+        PreparationProbe probe;
+        juce::WaitableEvent stopped;
+        const TemporaryDirectory temporaryDirectory;
+        const juce::File directory = temporaryDirectory.getFile();
+        juce::Component parent;
+        std::unique_ptr<UILoader> uiLoader = std::make_unique<UILoader> (parent, directory);
+    };
+}
+
+TEST_CASE ("A group is built when it is first shown and only released when asked to")
+{
+    GroupFixture ui;
+    REQUIRE (ui.uiLoader->getGroupNames() == juce::StringArray ("settings"));
+    REQUIRE_FALSE (ui.uiLoader->isGroupVisible ("settings"));
+    REQUIRE (ui["settings_probe"] == nullptr);
+    REQUIRE (ui.probe.prepared == 0);
+
+    int shownCount = 0;
+    juce::Component* probeComponent = nullptr;
+    bool visibleWhenShown = false;
+
+    ui.uiLoader->showGroup ("settings", [&] {
+        ++shownCount;
+        probeComponent = ui["settings_probe"];
+        visibleWhenShown = probeComponent != nullptr && probeComponent->isVisible();
+        ui.stop();
+    });
+
+    // The components are created on the message thread once the preparation is done
+    REQUIRE (ui.uiLoader->isGroupVisible ("settings"));
+    REQUIRE (shownCount == 0);
+    ui.runMessageLoop();
+
+    REQUIRE (shownCount == 1);
+    REQUIRE (probeComponent != nullptr);
+    REQUIRE (visibleWhenShown);
+    REQUIRE (probeComponent->getParentComponent() == &ui.parent);
+    REQUIRE (probeComponent->getBounds() == juce::Rectangle<int> (10, 20, 10, 10));
+    REQUIRE (ui.probe.instantiated == 1);
+
+    // Hiding keeps the components, so showing them again is immediate
+    ui.uiLoader->hideGroup ("settings");
+    REQUIRE_FALSE (ui.uiLoader->isGroupVisible ("settings"));
+    REQUIRE (ui["settings_probe"] == probeComponent);
+    REQUIRE_FALSE (probeComponent->isVisible());
+
+    ui.uiLoader->showGroup ("settings", [&] { ++shownCount; });
+    REQUIRE (shownCount == 2);
+    REQUIRE (probeComponent->isVisible());
+    REQUIRE (ui.probe.instantiated == 1);
+
+    juce::StringArray aboutToBeReleased;
+    ui.uiLoader->onComponentsAboutToBeReplaced = [&] (const juce::StringArray& names) { aboutToBeReleased = names; };
+
+    ui.uiLoader->hideGroup ("settings", true);
+    REQUIRE_FALSE (ui.uiLoader->isGroupVisible ("settings"));
+    REQUIRE (aboutToBeReleased == juce::StringArray ("settings_probe"));
+    REQUIRE (ui["settings_probe"] == nullptr);
+    REQUIRE (ui.parent.getNumChildComponents() == 0);
+}
+
+TEST_CASE ("A reload rebuilds a visible group whose element changed")
+{
+    GroupFixture ui;
+    int builtX = 0;
+    int rebuiltX = 0;
+
+    ui.uiLoader->showGroup ("settings", [&] {
+        builtX = ui["settings_probe"]->getProperties()["x"];
+
+        // Reload from a message of its own rather than from inside the build that just finished
+        juce::MessageManager::callAsync ([&] {
+            ui.writeXml (30);
+            ui.uiLoader->reloadUI();
+
+            ui.uiLoader->showGroup ("settings", [&] {
+                rebuiltX = ui["settings_probe"]->getProperties()["x"];
+                ui.stop();
+            });
+        });
+    });
+
+    ui.runMessageLoop();
+
+    REQUIRE (builtX == 10);
+    REQUIRE (rebuiltX == 30);
+    REQUIRE (ui.probe.instantiated == 2);
+    REQUIRE (ui.uiLoader->isGroupVisible ("settings"));
+    REQUIRE (ui["settings_probe"]->getBounds() == juce::Rectangle<int> (30, 20, 10, 10));
+}
+
+TEST_CASE ("A group's components are stacked where its element is, also after a reload")
+{
+    GroupFixture ui;
+    REQUIRE (ui.directory.getChildFile ("metadata.xml").replaceWithText (R"(<UI width="200" height="100">
+                                                                                <PROBE name="below" x="0" y="0" width="10" height="10"/>
+                                                                                <GROUP name="settings">
+                                                                                    <PROBE name="settings_probe" x="10" y="20" width="10" height="10"/>
+                                                                                </GROUP>
+                                                                                <PROBE name="above" x="20" y="0" width="10" height="10"/>
+                                                                            </UI>)"));
+    ui.uiLoader->reloadUI();
+
+    const auto getZIndex = [&ui] (const juce::String& name) { return ui.parent.getIndexOfChildComponent (ui[name]); };
+    juce::Array<int> builtOrder, reloadedOrder;
+
+    ui.uiLoader->showGroup ("settings", [&] {
+        builtOrder = { getZIndex ("below"), getZIndex ("settings_probe"), getZIndex ("above") };
+
+        // The unchanged group is kept and the components around it are reused
+        juce::MessageManager::callAsync ([&] {
+            ui.uiLoader->reloadUI();
+            reloadedOrder = { getZIndex ("below"), getZIndex ("settings_probe"), getZIndex ("above") };
+            ui.stop();
+        });
+    });
+
+    ui.runMessageLoop();
+
+    REQUIRE (builtOrder == juce::Array<int> { 0, 1, 2 });
+    REQUIRE (reloadedOrder == juce::Array<int> { 0, 1, 2 });
+    REQUIRE (ui.probe.instantiated == 3);
+}
+
+TEST_CASE ("Releasing a group while it builds abandons the build")
+{
+    GroupFixture ui;
+    ui.probe.blockPreparation = true;
+
+    ui.uiLoader->showGroup ("settings");
+    REQUIRE (ui.probe.preparationStarted.wait (5000));
+
+    ui.uiLoader->hideGroup ("settings", true);
+    ui.probe.resumePreparation.signal();
+    REQUIRE (ui.probe.preparationFinished.wait (5000));
+
+    // Give the finished preparation time to post its completion, then run the message loop past it
+    juce::Thread::sleep (50);
+    juce::MessageManager::callAsync ([&] { ui.stop(); });
+    ui.runMessageLoop();
+
+    REQUIRE (ui.probe.prepared == 1);
+    REQUIRE (ui.probe.instantiated == 0);
+    REQUIRE (ui["settings_probe"] == nullptr);
+}
+
+TEST_CASE ("Destroying the loader waits for the preparation of a group")
+{
+    GroupFixture ui;
+    ui.probe.blockPreparation = true;
+
+    ui.uiLoader->showGroup ("settings");
+    REQUIRE (ui.probe.preparationStarted.wait (5000));
+
+    auto resume = std::async (std::launch::async, [&] {
+        juce::Thread::sleep (50);
+        ui.probe.resumePreparation.signal();
+    });
+
+    // The preparation uses the loader's factory, so it must have finished before the loader is gone
+    ui.uiLoader = nullptr;
+    REQUIRE (ui.probe.prepared == 1);
+    REQUIRE (ui.probe.instantiated == 0);
+}
@@ -0,0 +1,100 @@
+#include "TestHelpers.h"
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+namespace
+{
+    // covered and userHidden lie below the opaque cover, which is drawn after them; free is beside it
+    constexpr auto xml = R"(<UI width="200" height="100">
+                                <IMAGE name="covered" file="opaque.png" x="10" y="10" width="20" height="20" imageType="raster"/>
+                                <IMAGE name="userHidden" file="opaque.png" x="40" y="10" width="20" height="20" imageType="raster"/>
+                                <IMAGE name="free" file="opaque.png" x="150" y="10" width="20" height="20" imageType="raster"/>
+                                <IMAGE name="cover" file="opaque.png" x="0" y="0" width="100" height="100" imageType="raster"/>
+                            </UI>)";
+
+    struct OcclusionFixture
+    {
+        OcclusionFixture()
+        {
+            writePng (directory.getChildFile ("opaque.png"), makeImage (16, 16, juce::Colours::red));
+            REQUIRE (directory.getChildFile ("metadata.xml").replaceWithText (xml));
+
+            parent.setSize (200, 100);
+            uiLoader.loadUI ("metadata.xml");
+        }
+
+        bool isOccluded (const juce::String& name) const { return static_cast<bool> ((*this)[name]->getProperties()["occluded"]); }
+
+        juce::Component* operator[] (const juce::String& name) const { return uiLoader.getComponentByName (name); }
+
+        const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+        const TemporaryDirectory temporaryDirectory;
+        const juce::File directory = temporaryDirectory.getFile();
+        juce::Component parent;
+        UILoader uiLoader { parent, directory };
+    };
+}
+
+TEST_CASE ("Occlusion culling is off by default and hides covered components once enabled")
+{
+    OcclusionFixture ui;
+    REQUIRE (ui["covered"]->isVisible());
+    REQUIRE_FALSE (ui.isOccluded ("covered"));
+
+    ui.uiLoader.setOcclusionCullingEnabled (true);
+    REQUIRE_FALSE (ui["covered"]->isVisible());
+    REQUIRE (ui.isOccluded ("covered"));
+    REQUIRE (ui["free"]->isVisible());
+    REQUIRE (ui["cover"]->isVisible());
+
+    // Every layout culls again
+    ui.parent.setSize (300, 150);
+    ui.uiLoader.applyLayout();
+    REQUIRE_FALSE (ui["covered"]->isVisible());
+
+    ui.uiLoader.setOcclusionCullingEnabled (false);
+    REQUIRE (ui["covered"]->isVisible());
+    REQUIRE_FALSE (ui.isOccluded ("covered"));
+}
+
+TEST_CASE ("A component is shown again once it is no longer covered")
+{
+    OcclusionFixture ui;
+    ui.uiLoader.setOcclusionCullingEnabled (true);
+    REQUIRE_FALSE (ui["covered"]->isVisible());
+
+    ui.uiLoader.setSourceBounds ("covered", { 120, 40, 20, 20 });
+    REQUIRE (ui["covered"]->isVisible());
+    REQUIRE_FALSE (ui.isOccluded ("covered"));
+
+    // Moving the cover over the free component hides that one instead
+    ui.uiLoader.setSourceBounds ("cover", { 100, 0, 100, 100 });
+    REQUIRE_FALSE (ui["free"]->isVisible());
+    REQUIRE_FALSE (ui["covered"]->isVisible());
+
+    ui.uiLoader.setSourceBounds ("cover", { 0, 60, 10, 10 });
+    REQUIRE (ui["free"]->isVisible());
+    REQUIRE (ui["covered"]->isVisible());
+}
+
+TEST_CASE ("Components hidden by the application stay hidden")
+{
+    OcclusionFixture ui;
+    ui["userHidden"]->setVisible (false);
+
+    ui.uiLoader.setOcclusionCullingEnabled (true);
+    REQUIRE_FALSE (ui.isOccluded ("userHidden"));
+
+    ui.uiLoader.setSourceBounds ("cover", { 0, 60, 10, 10 });
+    REQUIRE_FALSE (ui["userHidden"]->isVisible());
+    REQUIRE (ui["covered"]->isVisible());
+
+    ui.uiLoader.setOcclusionCullingEnabled (false);
+    REQUIRE_FALSE (ui["userHidden"]->isVisible());
+
+    // A reload that reuses the component leaves its visibility alone as well
+    ui.uiLoader.reloadUI();
+    REQUIRE_FALSE (ui["userHidden"]->isVisible());
+    REQUIRE (ui["covered"]->isVisible());
+}
@@ -0,0 +1,182 @@
+#include "TestHelpers.h"
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+namespace
+{
+    juce::String makeXml (const juce::String& knobAttributes)
+    {
+        return R"(<UI width="200" height="100">
+                      <IMAGE name="knob_image" file="knob.png" x="0" y="0" width="16" height="16" imageType="raster"/>
+                      <IMAGE name="knob_bg_image" file="knob_bg.png" x="20" y="0" width="16" height="16" imageType="raster"/>
+                      <IMAGE name="knob2_image" file="knob2.png" x="40" y="0" width="16" height="16" imageType="raster"/>
+                      <KNOB name="dial" fileNamePrefix="dial_" fileNameSuffix=".png" numberOfFrames="2" imageType="raster" )"
+               + knobAttributes + R"(/>
+                      <SWITCH name="power" fileNamePrefix="power_" fileNameSuffix=".png" numberOfFrames="2" x="100" y="40" width="16" height="16" imageType="raster"/>
+                  </UI>)";
+    }
+
+    struct ReloadFixture
+    {
+        ReloadFixture()
+        {
+            for (const auto* name : { "knob.png", "knob_bg.png", "knob2.png", "dial_0.png", "dial_1.png", "dial_bg.png", "power_0.png", "power_1.png" })
+                writePng (directory.getChildFile (name), makeImage (16, 16, juce::Colours::red));
+
+            writeXml (R"(x="60" y="40" width="16" height="16")");
+            parent.setSize (200, 100);
+            uiLoader.loadUI ("metadata.xml");
+        }
+
+        void writeXml (const juce::String& knobAttributes)
+        {
+            REQUIRE (directory.getChildFile ("metadata.xml").replaceWithText (makeXml (knobAttributes)));
+        }
+
+        juce::Component* operator[] (const juce::String& name) const { return uiLoader.getComponentByName (name); }
+
+        const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+        const TemporaryDirectory temporaryDirectory;
+        const juce::File directory = temporaryDirectory.getFile();
+        juce::Component parent;
+        UILoader uiLoader { parent, directory };
+    };
+}
+
+TEST_CASE ("A reload recreates only the components using a changed asset")
+{
+    ReloadFixture ui;
+    const auto* knobImage = ui["knob_image"];
+    const auto* knobBackground = ui["knob_bg_image"];
+    const auto* knob2 = ui["knob2_image"];
+    const auto* dial = ui["dial"];
+    REQUIRE (knobImage != nullptr);
+    REQUIRE (dial != nullptr);
+
+    // knob.png shares its stem with knob_bg.png and knob2.png, but only its own element uses it
+    ui.uiLoader.reloadUI ({ "knob.png" });
+    REQUIRE (ui["knob_image"] != knobImage);
+    REQUIRE (ui["knob_bg_image"] == knobBackground);
+    REQUIRE (ui["knob2_image"] == knob2);
+    REQUIRE (ui["dial"] == dial);
+
+    // A file's mask and a filmstrip's frames and mask count, other files sharing the prefix don't
+    knobImage = ui["knob_image"];
+    ui.uiLoader.reloadUI ({ "knob_mask.png" });
+    REQUIRE (ui["knob_image"] != knobImage);
+
+    ui.uiLoader.reloadUI ({ "dial_bg.png" });
+    REQUIRE (ui["dial"] == dial);
+
+    ui.uiLoader.reloadUI ({ "dial_1.png" });
+    REQUIRE (ui["dial"] != dial);
+
+    dial = ui["dial"];
+    ui.uiLoader.reloadUI ({ "dial_mask.png" });
+    REQUIRE (ui["dial"] != dial);
+}
+
+TEST_CASE ("A reload keeps moved components and recreates changed ones")
+{
+    ReloadFixture ui;
+    const auto* dial = ui["dial"];
+    const auto* power = ui["power"];
+
+    ui.writeXml (R"(x="80" y="20" width="20" height="20")");
+    ui.uiLoader.reloadUI();
+    REQUIRE (ui["dial"] == dial);
+    REQUIRE (ui["power"] == power);
+    REQUIRE (dial->getProperties()["x"].operator int() == 80);
+    REQUIRE (dial->getProperties()["width"].operator int() == 20);
+
+    ui.writeXml (R"(x="80" y="20" width="20" height="20" frameStorage="compressed")");
+    ui.uiLoader.reloadUI();
+    REQUIRE (ui["dial"] != dial);
+    REQUIRE (ui["power"] == power);
+}
+
+TEST_CASE ("Recreated components take over the state of the ones they replace")
+{
+    ReloadFixture ui;
+    auto* dial = dynamic_cast<juce::Slider*> (ui["dial"]);
+    auto* power = dynamic_cast<juce::Button*> (ui["power"]);
+    REQUIRE (dial != nullptr);
+    REQUIRE (power != nullptr);
+
+    dial->setValue (0.7, juce::dontSendNotification);
+    dial->setEnabled (false);
+    power->setToggleState (true, juce::dontSendNotification);
+
+    juce::StringArray aboutToBeReplaced, replaced;
+    ui.uiLoader.onComponentsAboutToBeReplaced = [&] (const juce::StringArray& names) { aboutToBeReplaced = names; };
+    ui.uiLoader.onComponentsReplaced = [&] (const juce::StringArray& names) { replaced = names; };
+
+    ui.uiLoader.reloadUI ({ "dial_0.png", "power_1.png" });
+
+    auto* newDial = dynamic_cast<juce::Slider*> (ui["dial"]);
+    auto* newPower = dynamic_cast<juce::Button*> (ui["power"]);
+    REQUIRE (newDial != nullptr);
+    REQUIRE (newPower != nullptr);
+    REQUIRE (newDial != dial);
+    REQUIRE (newPower != power);
+
+    REQUIRE (newDial->getValue() == 0.7);
+    REQUIRE_FALSE (newDial->isEnabled());
+    REQUIRE (newPower->getToggleState());
+
+    aboutToBeReplaced.sort (false);
+    replaced.sort (false);
+    REQUIRE (aboutToBeReplaced == juce::StringArray ("dial", "power"));
+    REQUIRE (replaced == juce::StringArray ("dial", "power"));
+}
+
+TEST_CASE ("The load report of a reload covers reused, recreated and cached components, and a failed reload clears it")
+{
+    ReloadFixture ui;
+    ui.uiLoader.setLoadReportEnabled (true);
+
+    const auto& report = ui.uiLoader.getLoadReport();
+
+    const auto findRecord = [&report] (const juce::String& name) {
+        const auto it = std::find_if (report.components.begin(), report.components.end(), [&name] (const auto& record) { return record.name == name; });
+        REQUIRE (it != report.components.end());
+        return *it;
+    };
+
+    const auto findAsset = [] (const LoadReport::ComponentRecord& record, const juce::String& filename) {
+        const auto it = std::find_if (record.assets.begin(), record.assets.end(), [&filename] (const auto& asset) { return asset.filename == filename; });
+        REQUIRE (it != record.assets.end());
+        return *it;
+    };
+
+    ui.uiLoader.reloadUI ({ "knob.png" });
+    REQUIRE (report.xmlFileName == "metadata.xml");
+    REQUIRE (report.components.size() == 5);
+
+    const auto dial = findRecord ("dial");
+    REQUIRE (dial.reused);
+    REQUIRE (dial.assets.empty());
+
+    const auto recreated = findRecord ("knob_image");
+    REQUIRE_FALSE (recreated.reused);
+    REQUIRE (recreated.type == "IMAGE");
+    REQUIRE (recreated.factory.endsWith ("ImageComponentFactory"));
+
+    const auto decoded = findAsset (recreated, "knob.png");
+    REQUIRE_FALSE (decoded.cacheHit);
+    REQUIRE (decoded.loader.endsWith ("FileAssetImageLoader"));
+    REQUIRE (decoded.source == "file:" + ui.directory.getFullPathName());
+    REQUIRE (decoded.decodedBytes == 16 * 16 * 4);
+
+    // Only the mask changed, so the image itself is still cached
+    ui.uiLoader.reloadUI ({ "knob_mask.png" });
+    const auto cached = findAsset (findRecord ("knob_image"), "knob.png");
+    REQUIRE (cached.cacheHit);
+    REQUIRE (cached.encodedBytes == 0);
+
+    REQUIRE (ui.directory.getChildFile ("metadata.xml").replaceWithText ("<UI width=\"200\""));
+    ui.uiLoader.reloadUI();
+    REQUIRE (report.components.empty());
+    REQUIRE (report.xmlFileName.isEmpty());
+}
@@ -0,0 +1,115 @@
+#include "TestHelpers.h"
+
+using namespace BogrenDigital::UILoading;
+using namespace BogrenDigital::UILoading::TestHelpers;
+
+namespace
+{
+    constexpr auto xml = R"(<UI width="100" height="100">
+                                <IMAGE name="background" file="background.png" x="0" y="0" width="100" height="100" imageType="raster"/>
+                            </UI>)";
+
+    /** Enables warm reopening for one test, and disables it again however the test ends. */
+    struct WarmCacheFixture
+    {
+        WarmCacheFixture()
+        {
+            writePng (directory.getChildFile ("background.png"), makeImage (32, 32, juce::Colours::blue));
+            REQUIRE (directory.getChildFile ("metadata.xml").replaceWithText (xml));
+
+            cache.setTimeToLive (juce::RelativeTime::seconds (30.0));
+        }
+
+        ~WarmCacheFixture()
+        {
+            cache.setTimeToLive ({});
+            cache.clear();
+        }
+
+        const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+        const TemporaryDirectory temporaryDirectory;
+        const juce::File directory = temporaryDirectory.getFile();
+        WarmUICache& cache = *WarmUICache::getInstance();
+    };
+}
+
+TEST_CASE ("A warm plan is reused for the same source and XML, and a changed XML replaces it")
+{
+    WarmCacheFixture fixture;
+    FileAssetImageLoader loader (fixture.directory);
+
+    const auto plan = fixture.cache.acquire (loader, "metadata.xml", xml);
+    REQUIRE (plan != nullptr);
+    REQUIRE (plan->elements.size() == 1);
+    fixture.cache.release (plan, nullptr);
+
+    // Another loader of the same directory hits
+    FileAssetImageLoader reopenedLoader (fixture.directory);
+    REQUIRE (fixture.cache.acquire (reopenedLoader, "metadata.xml", xml) == plan);
+
+    const juce::String changedXml = juce::String (xml).replace ("width=\"100\" height=\"100\"/>", "width=\"50\" height=\"50\"/>");
+    const auto changedPlan = fixture.cache.acquire (reopenedLoader, "metadata.xml", changedXml);
+    REQUIRE (changedPlan != plan);
+    REQUIRE (changedPlan->metadata.front().width == 50);
+    REQUIRE (fixture.cache.acquire (reopenedLoader, "metadata.xml", changedXml) == changedPlan);
+
+    // Different sources never share a plan
+    const TemporaryDirectory otherDirectory;
+    FileAssetImageLoader otherLoader (otherDirectory.getFile());
+    REQUIRE (fixture.cache.acquire (otherLoader, "metadata.xml", changedXml) != changedPlan);
+}
+
+TEST_CASE ("Released plans expire after their time to live, and a zero time disables the cache")
+{
+    WarmCacheFixture fixture;
+    FileAssetImageLoader loader (fixture.directory);
+    fixture.cache.setTimeToLive (juce::RelativeTime::milliseconds (20));
+
+    std::weak_ptr<WarmUIPlan> released;
+
+    {
+        auto plan = fixture.cache.acquire (loader, "metadata.xml", xml);
+        released = plan;
+        fixture.cache.release (std::move (plan), nullptr);
+    }
+
+    REQUIRE_FALSE (released.expired());
+
+    // Setting the time to live expires what has outlived it right away, as the cache's timer would
+    juce::Thread::sleep (50);
+    fixture.cache.setTimeToLive (juce::RelativeTime::milliseconds (20));
+    REQUIRE (released.expired());
+
+    fixture.cache.setTimeToLive ({});
+    const auto first = fixture.cache.acquire (loader, "metadata.xml", xml);
+    REQUIRE (fixture.cache.acquire (loader, "metadata.xml", xml) != first);
+}
+
+TEST_CASE ("A closed UI keeps its decoded images only while it is warm")
+{
+    WarmCacheFixture fixture;
+    const juce::SharedResourcePointer<SharedImagePool> sharedImagePool;
+
+    const auto loadAndClose = [&fixture] {
+        juce::Component parent;
+        parent.setSize (100, 100);
+        UILoader uiLoader (parent, fixture.directory);
+        uiLoader.loadUI ("metadata.xml");
+        REQUIRE (uiLoader.getComponentByName ("background") != nullptr);
+    };
+
+    sharedImagePool->releaseUnusedImages();
+    const auto numPooledImages = sharedImagePool->getNumImages();
+
+    loadAndClose();
+    sharedImagePool->releaseUnusedImages();
+    REQUIRE (sharedImagePool->getNumImages() == numPooledImages + 1);
+
+    fixture.cache.setTimeToLive ({});
+    sharedImagePool->releaseUnusedImages();
+    REQUIRE (sharedImagePool->getNumImages() == numPooledImages);
+
+    loadAndClose();
+    sharedImagePool->releaseUnusedImages();
+    REQUIRE (sharedImagePool->getNumImages() == numPooledImages);
+}
@@ -0,0 +1,140 @@
+/*
+    Converts the PNG images of an asset directory to QOI, which decodes several
+    times faster at a somewhat larger size.
+
+    Builds like the benchmarks: link against the bd_ui_loader module and its
+    dependencies.
+
+        QoiConverter <asset directory> [output directory] [--dry-run]
+
+    Converted files keep their names (and extensions), because every ImageLoader
+    recognises QOI by its content: the XML, BinaryData names and pak entries stay
+    valid. Without an output directory the files are converted in place; with one,
+    every other file is copied alongside. Convert the directory before generating
+    BinaryData from it or packing it into a pak.
+
+    Prints the size and decode time of each image in both formats, so the trade
+    can be judged per asset.
+*/
+
+#include <bd_ui_loader/bd_ui_loader.h>
+
+#include <iostream>
+
+using namespace BogrenDigital::UILoading;
+
+namespace
+{
+    double measureDecodeMilliseconds (const std::function<juce::Image()>& decode)
+    {
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        const auto image = decode();
+        juce::ignoreUnused (image);
+        return juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - startTicks) * 1000.0;
+    }
+
+    void printLine (const juce::String& text)
+    {
+        std::cout << text.toStdString() << std::endl;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray arguments;
+
+    for (int i = 1; i < argc; ++i)
+        arguments.add (argv[i]);
+
+    const auto dryRun = arguments.removeString ("--dry-run") > 0;
+
+    if (arguments.isEmpty() || arguments.size() > 2)
+    {
+        printLine ("Usage: QoiConverter <asset directory> [output directory] [--dry-run]");
+        return 1;
+    }
+
+    const auto inputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile (arguments[0]);
+    const auto outputDirectory = arguments.size() > 1 ? juce::File::getCurrentWorkingDirectory().getChildFile (arguments[1]) : inputDirectory;
+
+    if (! inputDirectory.isDirectory())
+    {
+        printLine ("Not a directory: " + inputDirectory.getFullPathName());
+        return 1;
+    }
+
+    juce::int64 totalPngBytes = 0, totalQoiBytes = 0;
+    double totalPngMilliseconds = 0.0, totalQoiMilliseconds = 0.0;
+    int numConverted = 0, numFailed = 0;
+
+    for (const auto& entry : juce::RangedDirectoryIterator (inputDirectory, true, "*", juce::File::findFiles))
+    {
+        const auto file = entry.getFile();
+        const auto relativePath = file.getRelativePathFrom (inputDirectory);
+        const auto outputFile = outputDirectory.getChildFile (relativePath);
+
+        juce::MemoryBlock encoded;
+
+        if (! file.loadFileAsData (encoded))
+        {
+            printLine ("Can't read " + relativePath);
+            ++numFailed;
+            continue;
+        }
+
+        const auto isPng = file.hasFileExtension ("png") && ! QoiImageFormat::isQoi (encoded.getData(), encoded.getSize());
+
+        if (! isPng)
+        {
+            if (! dryRun && outputFile != file && ! (outputFile.getParentDirectory().createDirectory() && file.copyFileTo (outputFile)))
+            {
+                printLine ("Can't copy " + relativePath);
+                ++numFailed;
+            }
+
+            continue;
+        }
+
+        const auto image = juce::ImageFileFormat::loadFrom (encoded.getData(), encoded.getSize());
+
+        if (! image.isValid())
+        {
+            printLine ("Can't decode " + relativePath);
+            ++numFailed;
+            continue;
+        }
+
+        const auto qoi = QoiImageFormat::encode (image);
+
+        const auto pngMilliseconds = measureDecodeMilliseconds ([&encoded] { return juce::ImageFileFormat::loadFrom (encoded.getData(), encoded.getSize()); });
+        const auto qoiMilliseconds = measureDecodeMilliseconds ([&qoi] { return QoiImageFormat::decode (qoi.getData(), qoi.getSize()); });
+
+        totalPngBytes += (juce::int64) encoded.getSize();
+        totalQoiBytes += (juce::int64) qoi.getSize();
+        totalPngMilliseconds += pngMilliseconds;
+        totalQoiMilliseconds += qoiMilliseconds;
+
+        printLine (relativePath + ": " + juce::String ((juce::int64) encoded.getSize()) + " -> " + juce::String ((juce::int64) qoi.getSize()) + " bytes, "
+                   + juce::String (pngMilliseconds, 2) + " -> " + juce::String (qoiMilliseconds, 2) + " ms");
+
+        if (dryRun)
+            continue;
+
+        if (! outputFile.getParentDirectory().createDirectory() || ! outputFile.replaceWithData (qoi.getData(), qoi.getSize()))
+        {
+            printLine ("Can't write " + outputFile.getFullPathName());
+            ++numFailed;
+            continue;
+        }
+
+        ++numConverted;
+    }
+
+    printLine ("Converted " + juce::String (numConverted) + " images: " + juce::File::descriptionOfSizeInBytes (totalPngBytes) + " -> "
+               + juce::File::descriptionOfSizeInBytes (totalQoiBytes) + ", decode " + juce::String (totalPngMilliseconds, 1) + " -> "
+               + juce::String (totalQoiMilliseconds, 1) + " ms");
+
+    return numFailed == 0 ? 0 : 1;
+}